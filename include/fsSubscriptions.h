@@ -16,6 +16,8 @@
 
 #include <tbb/concurrent_hash_map.h>
 
+#include <functional>
+
 namespace one {
 namespace client {
 namespace cache {
@@ -72,6 +74,16 @@ public:
      */
     bool unsubscribeFileAttrChanged(const folly::fbstring &fileUuid);
 
+    /**
+     * Sets a callback called on the fiber for each file, whose attributes
+     * were changed remotely.
+     * @param cb The callback which takes uuid of the file as an argument.
+     */
+    void onFileAttrChanged(std::function<void(const folly::fbstring &)> cb)
+    {
+        m_onFileAttrChanged = std::move(cb);
+    }
+
     /**
      * Adds subscription for file location updates.
      * @param fileUuid UUID of file for which subscription is added.
@@ -150,6 +162,8 @@ private:
     cache::LRUMetadataCache &m_metadataCache;
     cache::ForceProxyIOCache &m_forceProxyIOCache;
     std::function<void(folly::Function<void()>)> m_runInFiber;
+    std::function<void(const folly::fbstring &)> m_onFileAttrChanged =
+        [](auto &) {};
     tbb::concurrent_hash_map<Key, std::int64_t, StdHashCompare<Key>>
         m_subscriptions;
 
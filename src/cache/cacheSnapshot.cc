@@ -0,0 +1,109 @@
+/**
+ * @file cacheSnapshot.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cacheSnapshot.h"
+
+#include "logging.h"
+
+#include <folly/String.h>
+
+#include <fstream>
+#include <string>
+
+namespace one {
+namespace client {
+namespace cache {
+
+namespace {
+constexpr auto CACHE_SNAPSHOT_HEADER = "oneclient-cache-snapshot 1";
+} // namespace
+
+CacheSnapshot::CacheSnapshot(boost::filesystem::path path)
+    : m_path{std::move(path)}
+{
+}
+
+std::vector<folly::fbstring> CacheSnapshot::load() const
+{
+    std::vector<folly::fbstring> result;
+    if (!enabled())
+        return result;
+
+    std::ifstream file{m_path.string()};
+    std::string line;
+    if (!std::getline(file, line))
+        return result;
+
+    if (line != CACHE_SNAPSHOT_HEADER) {
+        LOG(WARNING) << "Ignoring cache snapshot " << m_path
+                     << " with unsupported header '" << line << "'";
+        return result;
+    }
+
+    while (std::getline(file, line)) {
+        std::string uuid;
+        if (line.empty() || !folly::unhexlify(line, uuid)) {
+            LOG(WARNING) << "Skipping invalid line in cache snapshot "
+                         << m_path << ": '" << line << "'";
+            continue;
+        }
+
+        result.emplace_back(uuid);
+    }
+
+    LOG(INFO) << "Loaded " << result.size() << " uuids from cache snapshot "
+              << m_path;
+
+    return result;
+}
+
+bool CacheSnapshot::save(const std::vector<folly::fbstring> &uuids) const
+{
+    if (!enabled())
+        return false;
+
+    auto tmpPath = m_path;
+    tmpPath += ".tmp";
+
+    try {
+        if (m_path.has_parent_path())
+            boost::filesystem::create_directories(m_path.parent_path());
+
+        {
+            std::ofstream file{tmpPath.string(), std::ios::trunc};
+            file << CACHE_SNAPSHOT_HEADER << '\n';
+            for (const auto &uuid : uuids) {
+                std::string hexUuid;
+                folly::hexlify(uuid, hexUuid);
+                file << hexUuid << '\n';
+            }
+
+            file.flush();
+            if (!file) {
+                LOG(WARNING) << "Failed to write cache snapshot " << tmpPath;
+                boost::filesystem::remove(tmpPath);
+                return false;
+            }
+        }
+
+        boost::filesystem::rename(tmpPath, m_path);
+    }
+    catch (const boost::filesystem::filesystem_error &e) {
+        LOG(WARNING) << "Failed to save cache snapshot " << m_path << ": "
+                     << e.what();
+        return false;
+    }
+
+    LOG_DBG(1) << "Saved " << uuids.size() << " uuids to cache snapshot "
+               << m_path;
+
+    return true;
+}
+
+} // namespace cache
+} // namespace client
+} // namespace one
@@ -0,0 +1,61 @@
+/**
+ * @file cacheSnapshot.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <boost/filesystem.hpp>
+#include <folly/FBString.h>
+
+#include <vector>
+
+namespace one {
+namespace client {
+namespace cache {
+
+/**
+ * @c CacheSnapshot stores uuids of files, which were cached by the metadata
+ * cache, so that after a restart the cache can be warmed up with the
+ * working set of the previous mount instead of starting cold.
+ * Only uuids are stored - attributes are always fetched again from the
+ * provider, so that a snapshot cannot yield stale metadata.
+ * The snapshot is a text file starting with a version header followed by
+ * one hex encoded uuid per line. Snapshots with unknown version are ignored.
+ */
+class CacheSnapshot {
+public:
+    /**
+     * Constructor.
+     * @param path Path of the snapshot file, empty path disables the
+     * snapshot.
+     */
+    CacheSnapshot(boost::filesystem::path path);
+
+    /**
+     * @return Whether the snapshot is enabled.
+     */
+    bool enabled() const { return !m_path.empty(); }
+
+    /**
+     * Reads uuids stored in the snapshot file.
+     * @return Stored uuids, in the order in which they were saved.
+     */
+    std::vector<folly::fbstring> load() const;
+
+    /**
+     * Atomically replaces the snapshot file with a new list of uuids.
+     * @param uuids Uuids to store.
+     * @return Whether the snapshot was saved.
+     */
+    bool save(const std::vector<folly::fbstring> &uuids) const;
+
+private:
+    const boost::filesystem::path m_path;
+};
+
+} // namespace cache
+} // namespace client
+} // namespace one
@@ -0,0 +1,502 @@
+/**
+ * @file diskBlockCache.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "diskBlockCache.h"
+
+#include "logging.h"
+#include "monitoring/monitoring.h"
+
+#include <asio/post.hpp>
+#include <boost/icl/discrete_interval.hpp>
+#include <folly/Conv.h>
+#include <folly/String.h>
+#include <folly/ThreadName.h>
+#include <folly/io/Cursor.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace one {
+namespace client {
+namespace cache {
+
+namespace {
+constexpr auto PARTIAL_CHUNK_EXTENSION = ".part";
+
+std::system_error lastError()
+{
+    return std::system_error{errno, std::system_category()};
+}
+}
+
+DiskBlockCache::DiskBlockCache(boost::filesystem::path directory,
+    const std::size_t capacity, const std::size_t chunkSize)
+    : m_directory{std::move(directory)}
+    , m_enabled{!m_directory.empty() && capacity > 0}
+    , m_capacity{capacity}
+    , m_chunkSize{chunkSize}
+{
+    if (!m_enabled)
+        return;
+
+    boost::filesystem::create_directories(m_directory);
+    loadIndex();
+
+    std::generate_n(std::back_inserter(m_diskWorkers),
+        DISK_BLOCK_CACHE_WORKER_COUNT, [this] {
+            return std::thread{[this] {
+                folly::setThreadName("DiskCacheWorker");
+                m_diskIoService.run();
+            }};
+        });
+}
+
+DiskBlockCache::~DiskBlockCache()
+{
+    m_diskIoService.stop();
+    for (auto &worker : m_diskWorkers)
+        worker.join();
+}
+
+void DiskBlockCache::loadIndex()
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    for (const auto &entry :
+        boost::filesystem::directory_iterator{m_directory}) {
+        const auto &path = entry.path();
+        if (!boost::filesystem::is_regular_file(path))
+            continue;
+
+        boost::system::error_code ec;
+        if (path.extension() == PARTIAL_CHUNK_EXTENSION) {
+            boost::filesystem::remove(path, ec);
+            continue;
+        }
+
+        // Complete chunk files are named <hex uuid>.<version>.<chunk>
+        const auto fileName = path.filename().string();
+        std::vector<folly::StringPiece> parts;
+        folly::split('.', fileName, parts);
+
+        std::string uuid;
+        std::uint64_t version = 0;
+        std::uint64_t chunk = 0;
+        bool validName = false;
+        if (parts.size() == 3 && folly::unhexlify(parts[0], uuid)) {
+            try {
+                version = folly::to<std::uint64_t>(parts[1]);
+                chunk = folly::to<std::uint64_t>(parts[2]);
+                validName = true;
+            }
+            catch (const std::range_error &) {
+            }
+        }
+
+        const auto fileSize = boost::filesystem::file_size(path, ec);
+        const Key key{uuid, chunk};
+        if (!validName || ec || fileSize == 0 || fileSize > m_chunkSize ||
+            m_chunks.count(key) > 0) {
+            LOG_DBG(1) << "Removing invalid disk cache file " << path;
+            boost::filesystem::remove(path, ec);
+            continue;
+        }
+
+        const off_t chunkStart = chunk * m_chunkSize;
+        auto lruIt = m_lruList.emplace(m_lruList.end(), key);
+        auto &cached = m_chunks[key];
+        cached.locationVersion = version;
+        cached.ranges += boost::icl::discrete_interval<off_t>::right_open(
+            chunkStart, chunkStart + fileSize);
+        cached.complete = true;
+        cached.lruIt = lruIt;
+        m_size += fileSize;
+    }
+
+    evictLocked();
+
+    LOG(INFO) << "Loaded " << m_chunks.size() << " chunks (" << m_size
+              << " bytes) from disk cache directory " << m_directory;
+
+    ONE_METRIC_COUNTER_SET("comp.oneclient.mod.diskcache.size", m_size);
+}
+
+folly::Optional<folly::Future<folly::IOBufQueue>> DiskBlockCache::read(
+    const folly::fbstring &uuid, const std::uint64_t locationVersion,
+    const off_t offset, const std::size_t size)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(locationVersion)
+                << LOG_FARG(offset) << LOG_FARG(size);
+
+    if (!m_enabled || offset < 0 || size == 0)
+        return {};
+
+    const Key key{uuid, offset / m_chunkSize};
+    const off_t chunkStart = key.second * m_chunkSize;
+    const off_t chunkEnd = chunkStart + m_chunkSize;
+    const auto range =
+        boost::icl::discrete_interval<off_t>::right_open(offset, offset + size);
+
+    if (range.upper() > chunkEnd) {
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.diskcache.miss");
+        return {};
+    }
+
+    boost::filesystem::path path;
+    {
+        std::lock_guard<std::mutex> guard{m_mutex};
+
+        auto it = m_chunks.find(key);
+        if (it != m_chunks.end() &&
+            it->second.locationVersion != locationVersion) {
+            LOG_DBG(2) << "Cached chunk " << key.second << " of file " << uuid
+                       << " is outdated - removing from disk cache";
+            eraseLocked(it);
+            it = m_chunks.end();
+        }
+
+        if (it == m_chunks.end() ||
+            !boost::icl::contains(it->second.ranges, range)) {
+            ONE_METRIC_COUNTER_INC("comp.oneclient.mod.diskcache.miss");
+            return {};
+        }
+
+        m_lruList.splice(m_lruList.end(), m_lruList, it->second.lruIt);
+        path = chunkPath(key, locationVersion, it->second.complete);
+    }
+
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.diskcache.hit");
+
+    folly::Promise<folly::IOBufQueue> promise;
+    auto future = promise.getFuture();
+
+    // Reads are not serialized with writes, so a partial chunk can be
+    // completed (renamed) or removed before it is opened
+    asio::post(m_diskIoService, [
+        this, key, locationVersion, path = std::move(path),
+        rangeOffset = range.lower() - chunkStart,
+        rangeSize = boost::icl::size(range), promise = std::move(promise)
+    ]() mutable {
+        try {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd == -1 && errno == ENOENT &&
+                path.extension() == PARTIAL_CHUNK_EXTENSION)
+                fd = ::open(chunkPath(key, locationVersion, true).c_str(),
+                    O_RDONLY);
+
+            if (fd == -1)
+                throw lastError();
+
+            auto buf = folly::IOBuf::create(rangeSize);
+            const auto bytesRead =
+                ::pread(fd, buf->writableData(), rangeSize, rangeOffset);
+            const auto readError = lastError();
+            ::close(fd);
+
+            if (bytesRead == -1)
+                throw readError;
+
+            if (static_cast<std::size_t>(bytesRead) != rangeSize)
+                throw std::system_error{
+                    std::make_error_code(std::errc::io_error)};
+
+            buf->append(bytesRead);
+            folly::IOBufQueue result{folly::IOBufQueue::cacheChainLength()};
+            result.append(std::move(buf));
+            promise.setValue(std::move(result));
+        }
+        catch (const std::system_error &e) {
+            if (e.code().value() == ENOENT) {
+                // The chunk has been removed in the meantime, its index
+                // entry is already erased or belongs to newer data
+                LOG_DBG(2) << "Chunk " << key.second << " of file "
+                           << key.first << " removed from disk cache";
+                ONE_METRIC_COUNTER_INC("comp.oneclient.mod.diskcache.miss");
+                promise.setException(e);
+                return;
+            }
+
+            LOG(WARNING) << "Failed to read chunk " << key.second
+                         << " of file " << key.first
+                         << " from disk cache: " << e.what();
+
+            {
+                std::lock_guard<std::mutex> guard{m_mutex};
+                auto it = m_chunks.find(key);
+                if (it != m_chunks.end() &&
+                    it->second.locationVersion == locationVersion)
+                    eraseLocked(it);
+            }
+
+            promise.setException(e);
+        }
+    });
+
+    return std::move(future);
+}
+
+void DiskBlockCache::write(const folly::fbstring &uuid,
+    const std::uint64_t locationVersion, const std::size_t fileSize,
+    const off_t offset, const folly::IOBufQueue &data)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(locationVersion)
+                << LOG_FARG(fileSize) << LOG_FARG(offset)
+                << LOG_FARG(data.chainLength());
+
+    if (!m_enabled || offset < 0 || data.empty())
+        return;
+
+    const auto dataSize = data.chainLength();
+    if (m_pendingWritesSize + dataSize >
+        DISK_BLOCK_CACHE_MAX_PENDING_WRITES_SIZE) {
+        LOG_DBG(2) << "Skipping " << dataSize << " bytes of file " << uuid
+                   << " - too much data pending to be written to disk cache";
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.diskcache.skipped");
+        return;
+    }
+
+    // Writes queued before the file is invalidated must not recreate its
+    // chunks, so they are tagged with the current invalidation generation
+    std::lock_guard<std::mutex> guard{m_mutex};
+    auto &pendingWrites = m_pendingWrites[uuid];
+    const auto generation = pendingWrites.generation;
+
+    folly::io::Cursor cursor{data.front()};
+    off_t chunkOffset = offset;
+    std::size_t remaining = dataSize;
+    while (remaining > 0) {
+        const Key key{uuid, chunkOffset / m_chunkSize};
+        const off_t chunkEnd = (key.second + 1) * m_chunkSize;
+        const std::size_t partSize =
+            std::min<std::size_t>(remaining, chunkEnd - chunkOffset);
+
+        std::unique_ptr<folly::IOBuf> part;
+        cursor.clone(part, partSize);
+
+        m_pendingWritesSize += partSize;
+        ++pendingWrites.count;
+        asio::post(m_writeStrand, [
+            this, key, generation, locationVersion, fileSize, chunkOffset,
+            partSize, part = std::move(part)
+        ]() mutable {
+            storeChunk(key, generation, locationVersion, fileSize,
+                chunkOffset, std::move(part));
+            m_pendingWritesSize -= partSize;
+            releasePendingWrite(key.first);
+        });
+
+        chunkOffset += partSize;
+        remaining -= partSize;
+    }
+}
+
+void DiskBlockCache::storeChunk(const Key &key,
+    const std::uint64_t generation, const std::uint64_t locationVersion,
+    const std::size_t fileSize, const off_t offset,
+    std::unique_ptr<folly::IOBuf> data)
+{
+    const off_t chunkStart = key.second * m_chunkSize;
+    const off_t chunkEnd =
+        std::min<off_t>(chunkStart + m_chunkSize, fileSize);
+    const auto range = boost::icl::discrete_interval<off_t>::right_open(
+        offset, std::min<off_t>(offset + data->computeChainDataLength(),
+                    chunkEnd));
+
+    if (boost::icl::size(range) == 0)
+        return;
+
+    boost::filesystem::path path;
+    {
+        std::lock_guard<std::mutex> guard{m_mutex};
+
+        if (invalidatedLocked(key.first, generation)) {
+            LOG_DBG(2) << "Dropping chunk " << key.second << " of file "
+                       << key.first << " invalidated before it was written";
+            return;
+        }
+
+        auto it = m_chunks.find(key);
+        if (it != m_chunks.end() &&
+            it->second.locationVersion != locationVersion) {
+            eraseLocked(it);
+            it = m_chunks.end();
+        }
+
+        if (it == m_chunks.end()) {
+            auto lruIt = m_lruList.emplace(m_lruList.end(), key);
+            it = m_chunks.emplace(key, Chunk{locationVersion, {}, false, lruIt})
+                     .first;
+        }
+
+        if (it->second.complete ||
+            boost::icl::contains(it->second.ranges, range))
+            return;
+
+        path = chunkPath(key, locationVersion, false);
+    }
+
+    data->coalesce();
+
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0600);
+    if (fd == -1) {
+        LOG(WARNING) << "Failed to open disk cache file " << path << ": "
+                     << lastError().what();
+        return;
+    }
+
+    const auto bytesWritten = ::pwrite(fd, data->data(),
+        boost::icl::size(range), range.lower() - chunkStart);
+    const auto writeError = lastError();
+    ::close(fd);
+
+    if (bytesWritten != static_cast<ssize_t>(boost::icl::size(range))) {
+        LOG(WARNING) << "Failed to write disk cache file " << path << ": "
+                     << writeError.what();
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    // The chunk could have been invalidated while the data was written, in
+    // which case the file removal is already scheduled on the write strand
+    auto it = m_chunks.find(key);
+    if (it == m_chunks.end() ||
+        it->second.locationVersion != locationVersion ||
+        invalidatedLocked(key.first, generation))
+        return;
+
+    m_size -= boost::icl::size(it->second.ranges);
+    it->second.ranges += range;
+    m_size += boost::icl::size(it->second.ranges);
+    m_lruList.splice(m_lruList.end(), m_lruList, it->second.lruIt);
+
+    const auto wholeChunk =
+        boost::icl::discrete_interval<off_t>::right_open(chunkStart, chunkEnd);
+
+    if (boost::icl::contains(it->second.ranges, wholeChunk)) {
+        boost::system::error_code ec;
+        boost::filesystem::rename(
+            path, chunkPath(key, locationVersion, true), ec);
+        if (ec) {
+            LOG(WARNING) << "Failed to complete disk cache file " << path
+                         << ": " << ec.message();
+            eraseLocked(it);
+        }
+        else {
+            it->second.complete = true;
+            LOG_DBG(2) << "Completed chunk " << key.second << " of file "
+                       << key.first << " in disk cache";
+        }
+    }
+
+    evictLocked();
+
+    ONE_METRIC_COUNTER_SET("comp.oneclient.mod.diskcache.size", m_size);
+}
+
+void DiskBlockCache::invalidate(const folly::fbstring &uuid)
+{
+    if (!m_enabled)
+        return;
+
+    std::lock_guard<std::mutex> guard{m_mutex};
+    eraseChunksLocked(uuid);
+
+    auto it = m_pendingWrites.find(uuid);
+    if (it != m_pendingWrites.end())
+        ++it->second.generation;
+
+    ONE_METRIC_COUNTER_SET("comp.oneclient.mod.diskcache.size", m_size);
+}
+
+std::size_t DiskBlockCache::size() const
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+    return m_size;
+}
+
+void DiskBlockCache::drain()
+{
+    if (!m_enabled)
+        return;
+
+    folly::Promise<folly::Unit> promise;
+    auto future = promise.getFuture();
+    asio::post(m_writeStrand, [&] { promise.setValue(); });
+    future.wait();
+}
+
+bool DiskBlockCache::invalidatedLocked(
+    const folly::fbstring &uuid, const std::uint64_t generation) const
+{
+    auto it = m_pendingWrites.find(uuid);
+    return it == m_pendingWrites.end() || it->second.generation != generation;
+}
+
+void DiskBlockCache::releasePendingWrite(const folly::fbstring &uuid)
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+    auto it = m_pendingWrites.find(uuid);
+    if (it != m_pendingWrites.end() && --it->second.count == 0)
+        m_pendingWrites.erase(it);
+}
+
+void DiskBlockCache::eraseChunksLocked(const folly::fbstring &uuid)
+{
+    auto it = m_chunks.lower_bound(Key{uuid, 0});
+    while (it != m_chunks.end() && it->first.first == uuid)
+        it = eraseLocked(it);
+}
+
+void DiskBlockCache::evictLocked()
+{
+    while (m_size > m_capacity && !m_lruList.empty()) {
+        LOG_DBG(2) << "Evicting chunk " << m_lruList.front().second
+                   << " of file " << m_lruList.front().first
+                   << " from disk cache";
+        eraseLocked(m_chunks.find(m_lruList.front()));
+    }
+}
+
+std::map<DiskBlockCache::Key, DiskBlockCache::Chunk>::iterator
+DiskBlockCache::eraseLocked(std::map<Key, Chunk>::iterator it)
+{
+    auto path = chunkPath(
+        it->first, it->second.locationVersion, it->second.complete);
+
+    asio::post(m_writeStrand, [path = std::move(path)] {
+        boost::system::error_code ec;
+        boost::filesystem::remove(path, ec);
+    });
+
+    m_size -= boost::icl::size(it->second.ranges);
+    m_lruList.erase(it->second.lruIt);
+    return m_chunks.erase(it);
+}
+
+boost::filesystem::path DiskBlockCache::chunkPath(const Key &key,
+    const std::uint64_t locationVersion, const bool complete) const
+{
+    std::string name;
+    folly::hexlify(key.first, name);
+    name += "." + std::to_string(locationVersion) + "." +
+        std::to_string(key.second);
+
+    if (!complete)
+        name += PARTIAL_CHUNK_EXTENSION;
+
+    return m_directory / name;
+}
+
+} // namespace cache
+} // namespace client
+} // namespace one
@@ -0,0 +1,183 @@
+/**
+ * @file diskBlockCache.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <asio/executor_work_guard.hpp>
+#include <asio/io_service.hpp>
+#include <asio/io_service_strand.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/icl/interval_set.hpp>
+#include <folly/FBString.h>
+#include <folly/FBVector.h>
+#include <folly/Optional.h>
+#include <folly/futures/Future.h>
+#include <folly/io/IOBufQueue.h>
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace one {
+namespace client {
+namespace cache {
+
+constexpr std::size_t DISK_BLOCK_CACHE_CHUNK_SIZE = 4 * 1024 * 1024;
+constexpr std::size_t DISK_BLOCK_CACHE_MAX_PENDING_WRITES_SIZE =
+    64 * 1024 * 1024;
+constexpr std::size_t DISK_BLOCK_CACHE_WORKER_COUNT = 2;
+
+/**
+ * @c DiskBlockCache stores data read from remote storages in a local
+ * directory, so that repeated reads of the same file ranges - also after the
+ * client is restarted - do not have to be transferred over the network again.
+ * Data is kept in fixed size chunk files, tagged with the file location
+ * version at which the data has been read. Chunks filled only partially are
+ * kept in '.part' files, which are discarded on startup, while complete
+ * chunks are renamed to their final name and are indexed again when the
+ * cache directory is reopened. The total size of cached data is bounded and
+ * least recently used chunks are evicted first.
+ * All disk operations are performed asynchronously on dedicated worker
+ * threads, with writes and removals of chunk files serialized on a strand.
+ * The in-memory index is protected by a mutex.
+ */
+class DiskBlockCache {
+public:
+    /**
+     * Constructor.
+     * Indexes chunks already present in the cache directory and starts the
+     * disk worker threads.
+     * @param directory Path of the cache directory, empty path disables the
+     * cache.
+     * @param capacity Maximum total size in bytes of cached data.
+     * @param chunkSize Size in bytes of a single chunk.
+     */
+    DiskBlockCache(boost::filesystem::path directory,
+        const std::size_t capacity,
+        const std::size_t chunkSize = DISK_BLOCK_CACHE_CHUNK_SIZE);
+
+    /**
+     * Destructor.
+     * Stops the disk worker threads, discarding pending operations.
+     */
+    ~DiskBlockCache();
+
+    /**
+     * @return Whether the cache is enabled.
+     */
+    bool enabled() const { return m_enabled; }
+
+    /**
+     * Reads a range of file data from the cache. Only ranges contained in
+     * a single chunk can be served from the cache.
+     * @param uuid Uuid of the file.
+     * @param locationVersion Current version of the file location.
+     * @param offset Offset of the range to read.
+     * @param size Size of the range to read.
+     * @return Future with the requested data or none if the range is not
+     * cached or the cached data is outdated.
+     */
+    folly::Optional<folly::Future<folly::IOBufQueue>> read(
+        const folly::fbstring &uuid, const std::uint64_t locationVersion,
+        const off_t offset, const std::size_t size);
+
+    /**
+     * Asynchronously stores file data in the cache, evicting least recently
+     * used chunks if necessary. The data is dropped if too much data is
+     * already waiting to be written.
+     * @param uuid Uuid of the file.
+     * @param locationVersion Version of the file location at which the data
+     * has been read.
+     * @param fileSize Current size of the file.
+     * @param offset Offset of the data in the file.
+     * @param data The data.
+     */
+    void write(const folly::fbstring &uuid, const std::uint64_t locationVersion,
+        const std::size_t fileSize, const off_t offset,
+        const folly::IOBufQueue &data);
+
+    /**
+     * Removes all data of a file from the cache.
+     * @param uuid Uuid of the file.
+     */
+    void invalidate(const folly::fbstring &uuid);
+
+    /**
+     * @return Total size in bytes of cached data.
+     */
+    std::size_t size() const;
+
+    /**
+     * Waits until all pending disk operations are completed.
+     */
+    void drain();
+
+private:
+    using Key = std::pair<folly::fbstring, std::uint64_t>;
+
+    struct Chunk {
+        std::uint64_t locationVersion;
+        boost::icl::interval_set<off_t> ranges;
+        bool complete;
+        std::list<Key>::iterator lruIt;
+    };
+
+    struct PendingWrites {
+        std::uint64_t generation;
+        std::size_t count;
+    };
+
+    void loadIndex();
+
+    void storeChunk(const Key &key, const std::uint64_t generation,
+        const std::uint64_t locationVersion, const std::size_t fileSize,
+        const off_t offset, std::unique_ptr<folly::IOBuf> data);
+
+    bool invalidatedLocked(
+        const folly::fbstring &uuid, const std::uint64_t generation) const;
+
+    void releasePendingWrite(const folly::fbstring &uuid);
+
+    void eraseChunksLocked(const folly::fbstring &uuid);
+
+    void evictLocked();
+
+    std::map<Key, Chunk>::iterator eraseLocked(
+        std::map<Key, Chunk>::iterator it);
+
+    boost::filesystem::path chunkPath(const Key &key,
+        const std::uint64_t locationVersion, const bool complete) const;
+
+    const boost::filesystem::path m_directory;
+    const bool m_enabled;
+    const std::size_t m_capacity;
+    const std::size_t m_chunkSize;
+
+    mutable std::mutex m_mutex;
+    std::size_t m_size = 0;
+    std::list<Key> m_lruList;
+    std::map<Key, Chunk> m_chunks;
+    // Invalidation generations of files with writes queued on the strand
+    std::map<folly::fbstring, PendingWrites> m_pendingWrites;
+
+    asio::io_service m_diskIoService;
+    asio::executor_work_guard<asio::io_service::executor_type> m_idleWork{
+        asio::make_work_guard(m_diskIoService)};
+    asio::io_service::strand m_writeStrand{m_diskIoService};
+    folly::fbvector<std::thread> m_diskWorkers;
+    std::atomic<std::size_t> m_pendingWritesSize{0};
+};
+
+} // namespace cache
+} // namespace client
+} // namespace one
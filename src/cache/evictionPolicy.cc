@@ -0,0 +1,29 @@
+/**
+ * @file evictionPolicy.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "evictionPolicy.h"
+
+#include <stdexcept>
+
+namespace one {
+namespace client {
+namespace cache {
+
+EvictionPolicyType parseEvictionPolicyType(const std::string &name)
+{
+    if (name == "lru")
+        return EvictionPolicyType::lru;
+
+    if (name == "2q")
+        return EvictionPolicyType::twoQueue;
+
+    throw std::invalid_argument{"unknown eviction policy: " + name};
+}
+
+} // namespace cache
+} // namespace client
+} // namespace one
@@ -0,0 +1,299 @@
+/**
+ * @file evictionPolicy.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace one {
+namespace client {
+namespace cache {
+
+/**
+ * Type of eviction policy used by the metadata and inode caches.
+ */
+enum class EvictionPolicyType {
+    /**
+     * Evicts least recently used entries.
+     */
+    lru,
+    /**
+     * Scan resistant 2Q policy - entries seen once are evicted in FIFO order
+     * before entries, which were referenced again after being evicted.
+     */
+    twoQueue
+};
+
+/**
+ * Parses a name of eviction policy ('lru' or '2q').
+ * Throws an instance of @c std::invalid_argument for unknown names.
+ * @param name Name of the policy.
+ */
+EvictionPolicyType parseEvictionPolicyType(const std::string &name);
+
+/**
+ * @c EvictionPolicy decides in which order evictable entries of a cache are
+ * removed. Entries are inserted when they become evictable (e.g. when they
+ * are no longer open) and erased when they are pinned again or removed from
+ * the cache for other reasons.
+ *
+ * With @c EvictionPolicyType::twoQueue newly inserted entries land in a FIFO
+ * probation queue, which holds about a quarter of the capacity. Keys evicted
+ * from probation are remembered in a bounded ghost list, and only entries
+ * inserted again while their key is still remembered are admitted to the
+ * protected LRU queue. A single pass over a large tree (e.g. `find` or a
+ * backup) thus only cycles the probation queue and leaves the working set in
+ * the protected queue intact.
+ * Ghost keys are of type @c HistoryKey, which should identify an entry
+ * across its removals from the cache, e.g. a file uuid for caches keyed by
+ * inodes that are not reused after pruning.
+ * The policy is not thread safe.
+ */
+template <typename Key, typename HistoryKey = Key> class EvictionPolicy {
+public:
+    /**
+     * Constructor.
+     * @param type Type of the policy.
+     * @param capacity Target number of entries in the cache.
+     */
+    EvictionPolicy(const EvictionPolicyType type, const std::size_t capacity)
+        : m_type{type}
+        , m_probationCapacity{std::max<std::size_t>(capacity / 4, 1)}
+        , m_ghostCapacity{capacity / 2}
+    {
+    }
+
+    /**
+     * Makes an entry evictable.
+     * @param key Key of the entry.
+     * @param protect Whether the entry should be admitted to the protected
+     * queue directly, e.g. because it was protected before it was erased.
+     */
+    void insert(const Key &key, const bool protect = false)
+    {
+        insert(key, key, protect);
+    }
+
+    /**
+     * Makes an entry evictable.
+     * @param key Key of the entry.
+     * @param historyKey Key under which the entry may be remembered in the
+     * ghost list.
+     * @param protect Whether the entry should be admitted to the protected
+     * queue directly.
+     */
+    void insert(
+        const Key &key, const HistoryKey &historyKey, const bool protect)
+    {
+        assert(!contains(key));
+
+        auto ghostIt = m_ghostPositions.find(historyKey);
+        const bool remembered = ghostIt != m_ghostPositions.end();
+        if (remembered) {
+            m_ghosts.erase(ghostIt->second);
+            m_ghostPositions.erase(ghostIt);
+        }
+
+        if (protect || remembered) {
+            m_positions.emplace(key,
+                Position{Queue::protectedQueue,
+                    m_protected.emplace(m_protected.end(), key)});
+            return;
+        }
+
+        m_positions.emplace(key,
+            Position{Queue::probationQueue,
+                m_probation.emplace(m_probation.end(), key)});
+    }
+
+    /**
+     * Notes an access to an evictable entry.
+     * @param key Key of the entry.
+     */
+    void touch(const Key &key)
+    {
+        auto it = m_positions.find(key);
+        if (it == m_positions.end())
+            return;
+
+        auto &queue = queueOf(it->second.queue);
+
+        // Repeated accesses to an entry in probation are usually correlated
+        // (e.g. lookup followed by getattr) and do not promote the entry
+        if (m_type == EvictionPolicyType::lru ||
+            it->second.queue == Queue::protectedQueue)
+            queue.splice(queue.end(), queue, it->second.it);
+    }
+
+    /**
+     * Makes an entry not evictable.
+     * @param key Key of the entry.
+     */
+    void erase(const Key &key)
+    {
+        auto it = m_positions.find(key);
+        if (it == m_positions.end())
+            return;
+
+        queueOf(it->second.queue).erase(it->second.it);
+        m_positions.erase(it);
+    }
+
+    /**
+     * Changes the key of an evictable entry, keeping its position.
+     * @param oldKey Current key of the entry.
+     * @param newKey New key of the entry.
+     */
+    void rename(const Key &oldKey, const Key &newKey)
+    {
+        auto it = m_positions.find(oldKey);
+        if (it == m_positions.end())
+            return;
+
+        auto position = it->second;
+        m_positions.erase(it);
+        *position.it = newKey;
+        m_positions.emplace(newKey, position);
+    }
+
+    /**
+     * Selects an entry to evict and removes it from the policy.
+     * The policy must not be empty.
+     * @return Key of the evicted entry.
+     */
+    Key evict()
+    {
+        return evict([](const Key &key) -> const HistoryKey & { return key; });
+    }
+
+    /**
+     * Selects an entry to evict and removes it from the policy.
+     * The policy must not be empty.
+     * @param historyOf Function returning the history key of an entry,
+     * called with the key of the evicted entry if it should be remembered.
+     * @return Key of the evicted entry.
+     */
+    template <typename HistoryOf> Key evict(HistoryOf &&historyOf)
+    {
+        assert(!empty());
+
+        const bool fromProbation = !m_probation.empty() &&
+            (m_type == EvictionPolicyType::lru || m_protected.empty() ||
+                m_probation.size() >= m_probationCapacity);
+
+        auto &queue = fromProbation ? m_probation : m_protected;
+        auto key = std::move(queue.front());
+        queue.pop_front();
+        m_positions.erase(key);
+
+        if (m_type == EvictionPolicyType::twoQueue && fromProbation)
+            remember(historyOf(key));
+
+        return key;
+    }
+
+    /**
+     * @return Whether an entry is evictable and kept in the protected queue.
+     */
+    bool isProtected(const Key &key) const
+    {
+        auto it = m_positions.find(key);
+        return it != m_positions.end() &&
+            it->second.queue == Queue::protectedQueue;
+    }
+
+    /**
+     * @return Whether an entry is evictable.
+     */
+    bool contains(const Key &key) const
+    {
+        return m_positions.find(key) != m_positions.end();
+    }
+
+    /**
+     * @return Whether there are no evictable entries.
+     */
+    bool empty() const { return m_positions.empty(); }
+
+    /**
+     * @return Number of evictable entries.
+     */
+    std::size_t size() const { return m_positions.size(); }
+
+    /**
+     * @return Memory in bytes used by the policy for each evictable entry,
+     * excluding heap memory owned by its two copies of the key.
+     */
+    static constexpr std::size_t entryFootprint()
+    {
+        // A list node and a hash map node with a cached bucket pointer
+        return 2 * sizeof(Key) + sizeof(Position) + 5 * sizeof(void *);
+    }
+
+    /**
+     * Lists evictable entries starting from the ones, which would be evicted
+     * last.
+     * @param limit Maximum number of listed entries.
+     */
+    std::vector<Key> keys(const std::size_t limit) const
+    {
+        std::vector<Key> result;
+        result.reserve(std::min(limit, size()));
+
+        for (auto queue : {&m_protected, &m_probation})
+            for (auto it = queue->rbegin();
+                 it != queue->rend() && result.size() < limit; ++it)
+                result.emplace_back(*it);
+
+        return result;
+    }
+
+private:
+    enum class Queue { probationQueue, protectedQueue };
+
+    struct Position {
+        Queue queue;
+        typename std::list<Key>::iterator it;
+    };
+
+    std::list<Key> &queueOf(const Queue queue)
+    {
+        return queue == Queue::probationQueue ? m_probation : m_protected;
+    }
+
+    void remember(const HistoryKey &key)
+    {
+        if (m_ghostCapacity == 0)
+            return;
+
+        if (m_ghosts.size() >= m_ghostCapacity) {
+            m_ghostPositions.erase(m_ghosts.front());
+            m_ghosts.pop_front();
+        }
+
+        m_ghostPositions.emplace(key, m_ghosts.emplace(m_ghosts.end(), key));
+    }
+
+    const EvictionPolicyType m_type;
+    const std::size_t m_probationCapacity;
+    const std::size_t m_ghostCapacity;
+    std::list<Key> m_probation;
+    std::list<Key> m_protected;
+    std::list<HistoryKey> m_ghosts;
+    std::unordered_map<Key, Position> m_positions;
+    std::unordered_map<HistoryKey, typename std::list<HistoryKey>::iterator>
+        m_ghostPositions;
+};
+
+} // namespace cache
+} // namespace client
+} // namespace one
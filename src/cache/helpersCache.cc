@@ -16,39 +16,78 @@
 #include "messages/fuse/storageTestFile.h"
 #include "messages/fuse/verifyStorageTestFile.h"
 
-#include <folly/ThreadName.h>
+#include <boost/algorithm/string.hpp>
 
-#include <algorithm>
 #include <chrono>
 #include <functional>
+#include <vector>
 
 namespace one {
 namespace client {
 namespace cache {
 
-HelpersCache::HelpersCache(communication::Communicator &communicator,
-    Scheduler &scheduler, const options::Options &options)
-    : m_communicator{communicator}
-    , m_scheduler{scheduler}
-    , m_options{options}
-    , m_helpersIoService{static_cast<int>(
-          options.getStorageHelperThreadCount())}
-    , m_helperFactory
+namespace {
+/**
+ * Returns the number of threads of the helpers pool for a storage type,
+ * overridden in the 'type=threads,...' list of the
+ * 'storage-helper-thread-counts' option or the default number of storage
+ * helper threads.
+ */
+unsigned int helpersIoPoolThreadCount(
+    const options::Options &options, const std::string &storageType)
+{
+    const auto threadCounts = options.getStorageHelperThreadCounts();
+    if (!threadCounts)
+        return options.getStorageHelperThreadCount();
+
+    std::vector<std::string> entries;
+    boost::split(entries, threadCounts.get(), boost::is_any_of(","));
+
+    for (const auto &entry : entries) {
+        std::vector<std::string> typeAndCount;
+        boost::split(typeAndCount, entry, boost::is_any_of("="));
+
+        if (typeAndCount.size() != 2 ||
+            boost::trim_copy(typeAndCount[0]) != storageType)
+            continue;
+
+        try {
+            return std::stoul(boost::trim_copy(typeAndCount[1]));
+        }
+        catch (const std::logic_error &) {
+            LOG(WARNING) << "Invalid number of storage helper threads for "
+                            "storage type '"
+                         << storageType << "': '" << typeAndCount[1]
+                         << "', using default";
+        }
+    }
+
+    return options.getStorageHelperThreadCount();
+}
+} // namespace
+
+HelpersCache::StorageHelpers::StorageHelpers(const folly::fbstring &storageId,
+    const unsigned int threadCount, communication::Communicator &communicator,
+    const options::Options &options)
+    : ioPool{storageId.toStdString(), threadCount}
+    , helperFactory
 {
+    // A storage has helpers of a single type, so the pool of the storage is
+    // used for all types
 #if WITH_CEPH
-    m_helpersIoService, m_helpersIoService,
+    ioPool.ioService(), ioPool.ioService(),
 #endif
-        m_helpersIoService,
+        ioPool.ioService(),
 #if WITH_S3
-        m_helpersIoService,
+        ioPool.ioService(),
 #endif
 #if WITH_SWIFT
-        m_helpersIoService,
+        ioPool.ioService(),
 #endif
 #if WITH_GLUSTERFS
-        m_helpersIoService,
+        ioPool.ioService(),
 #endif
-        m_helpersIoService, m_communicator,
+        ioPool.ioService(), communicator,
         options.getBufferSchedulerThreadCount(),
         helpers::buffering::BufferLimits
     {
@@ -62,23 +101,72 @@ HelpersCache::HelpersCache(communication::Communicator &communicator,
             options.getWriteBuffersTotalSize()
     }
 }
-, m_storageAccessManager{m_helperFactory, m_options},
-    m_providerTimeout{options.getProviderTimeout()}
 {
-    std::generate_n(std::back_inserter(m_helpersWorkers),
-        options.getStorageHelperThreadCount(), [this] {
-            return std::thread{[this] {
-                folly::setThreadName("HelpersWorker");
-                m_helpersIoService.run();
-            }};
-        });
+    ioPool.start();
+}
+
+HelpersCache::HelpersCache(communication::Communicator &communicator,
+    Scheduler &scheduler, const options::Options &options)
+    : m_communicator{communicator}
+    , m_scheduler{scheduler}
+    , m_options{options}
+    , m_storageAccessManager{std::bind(&HelpersCache::helperFactory, this,
+                                 std::placeholders::_1, std::placeholders::_2),
+          m_options}
+    , m_providerTimeout{options.getProviderTimeout()}
+{
+    scheduleHelpersIoPoolsProbe();
 }
 
 HelpersCache::~HelpersCache()
 {
-    m_helpersIoService.stop();
-    for (auto &worker : m_helpersWorkers)
-        worker.join();
+    {
+        std::lock_guard<std::mutex> guard{m_ioPoolsProbeState->mutex};
+        m_ioPoolsProbeState->stopped = true;
+        m_cancelIoPoolsProbe();
+    }
+
+    std::lock_guard<std::mutex> guard{m_storageHelpersMutex};
+    for (auto &storageHelpers : m_storageHelpers)
+        storageHelpers.second->ioPool.stop();
+}
+
+helpers::StorageHelperCreator &HelpersCache::helperFactory(
+    const folly::fbstring &storageId, const folly::fbstring &helperName)
+{
+    std::lock_guard<std::mutex> guard{m_storageHelpersMutex};
+
+    auto &storageHelpers = m_storageHelpers[storageId];
+    if (!storageHelpers)
+        storageHelpers = std::make_unique<StorageHelpers>(storageId,
+            helpersIoPoolThreadCount(m_options, helperName.toStdString()),
+            m_communicator, m_options);
+
+    return storageHelpers->helperFactory;
+}
+
+void HelpersCache::scheduleHelpersIoPoolsProbe()
+{
+    std::weak_ptr<IoPoolsProbeState> weakState = m_ioPoolsProbeState;
+
+    m_cancelIoPoolsProbe = m_scheduler.schedule(
+        HELPERS_IO_POOL_PROBE_INTERVAL, [this, weakState] {
+            auto state = weakState.lock();
+            if (!state)
+                return;
+
+            std::lock_guard<std::mutex> guard{state->mutex};
+            if (state->stopped)
+                return;
+
+            {
+                std::lock_guard<std::mutex> poolsGuard{m_storageHelpersMutex};
+                for (auto &storageHelpers : m_storageHelpers)
+                    storageHelpers.second->ioPool.probe();
+            }
+
+            scheduleHelpersIoPoolsProbe();
+        });
 }
 
 HelpersCache::AccessType HelpersCache::getAccessType(
@@ -124,11 +212,12 @@ folly::Future<HelpersCache::HelperPtr> HelpersCache::get(
             m_cache.emplace(std::make_tuple(storageId, false), p);
 
             m_scheduler.post(
-                [ this, &fileUuid, &spaceId, &storageId, p = std::move(p) ] {
-                    p->setWith([=] {
-                        return performForcedDirectIOStorageDetection(
-                            fileUuid, spaceId, storageId);
-                    });
+                [ this, fileUuid, spaceId, storageId, p = std::move(p) ] {
+                    performForcedDirectIOStorageDetection(
+                        fileUuid, spaceId, storageId)
+                        .then([p](folly::Try<HelperPtr> &&helper) {
+                            p->setTry(std::move(helper));
+                        });
                 });
         }
 
@@ -151,8 +240,7 @@ folly::Future<HelpersCache::HelperPtr> HelpersCache::get(
         m_cache.emplace(std::make_tuple(storageId, forceProxyIO), p);
 
         m_scheduler.post([
-            this, &fileUuid, &spaceId, &storageId, forceProxyIO,
-            p = std::move(p)
+            this, fileUuid, spaceId, storageId, forceProxyIO, p = std::move(p)
         ] {
             p->setWith([=] {
                 return performAutoIOStorageDetection(
@@ -186,10 +274,11 @@ HelpersCache::HelperPtr HelpersCache::performAutoIOStorageDetection(
 
     if (!forceProxyIO) {
         if (accessUnset) {
-            // First try to quickly detect direct io (in 1 attempt), if not
-            // available, return proxy and schedule full storage detection
+            // First try to quickly detect direct io without retrying, if not
+            // available, return proxy and schedule full storage detection.
+            // Without retries the returned future is already completed.
             auto helper =
-                requestStorageTestFileCreation(fileUuid, storageId, 1);
+                requestStorageTestFileCreation(fileUuid, storageId, 0).get();
             if (helper) {
                 LOG_DBG(2) << "Direct access to storage " << storageId
                            << " determined on first attempt - returning";
@@ -201,29 +290,40 @@ HelpersCache::HelperPtr HelpersCache::performAutoIOStorageDetection(
                           "scheduling retry and returning proxy helper as "
                           "fallback";
             m_scheduler.post([this, fileUuid, storageId] {
-                auto directIOHelper =
-                    requestStorageTestFileCreation(fileUuid, storageId);
-                if (directIOHelper) {
-                    LOG_DBG(2) << "Found direct access to storage " << storageId
-                               << " using automatic storage detection";
-                    {
-                        std::lock_guard<std::mutex> guard(m_cacheMutex);
-                        m_cache[std::make_tuple(storageId, false)]->setValue(
-                            directIOHelper);
-                    }
-
-                    {
-                        std::lock_guard<std::mutex> guard(m_accessTypeMutex);
-                        m_accessType.emplace(
-                            std::make_pair(storageId, AccessType::DIRECT));
-                    }
-                }
-                else {
-                    LOG_DBG(2) << "Direct access to storage " << storageId
-                               << " couldn't be established - leaving "
-                                  "proxy access";
-                }
-
+                requestStorageTestFileCreation(fileUuid, storageId)
+                    .then([this, storageId](HelperPtr directIOHelper) {
+                        if (!directIOHelper) {
+                            LOG_DBG(2) << "Direct access to storage "
+                                       << storageId
+                                       << " couldn't be established - "
+                                          "leaving proxy access";
+                            return;
+                        }
+
+                        LOG_DBG(2) << "Found direct access to storage "
+                                   << storageId
+                                   << " using automatic storage detection";
+                        // Replace the promise, which has already been
+                        // fulfilled with the proxy helper, so that handles
+                        // open in proxy mode can switch to direct access
+                        {
+                            auto p = std::make_shared<
+                                folly::SharedPromise<HelperPtr>>();
+                            p->setValue(directIOHelper);
+
+                            std::lock_guard<std::mutex> guard(m_cacheMutex);
+                            m_cache[std::make_tuple(storageId, false)] =
+                                std::move(p);
+                        }
+                        ++m_accessGeneration;
+
+                        {
+                            std::lock_guard<std::mutex> guard(
+                                m_accessTypeMutex);
+                            m_accessType.emplace(
+                                std::make_pair(storageId, AccessType::DIRECT));
+                        }
+                    });
             });
             return performAutoIOStorageDetection(
                 fileUuid, spaceId, storageId, true);
@@ -242,11 +342,13 @@ HelpersCache::HelperPtr HelpersCache::performAutoIOStorageDetection(
                 messages::fuse::GetHelperParams::HelperMode::autoMode}),
         m_providerTimeout);
 
-    return m_helperFactory.getStorageHelper(
-        params.name(), params.args(), m_options.isIOBuffered());
+    return helperFactory(storageId, params.name())
+        .getStorageHelper(
+            params.name(), params.args(), m_options.isIOBuffered());
 }
 
-HelpersCache::HelperPtr HelpersCache::performForcedDirectIOStorageDetection(
+folly::Future<HelpersCache::HelperPtr>
+HelpersCache::performForcedDirectIOStorageDetection(
     const folly::fbstring &fileUuid, const folly::fbstring &spaceId,
     const folly::fbstring &storageId)
 {
@@ -258,7 +360,7 @@ HelpersCache::HelperPtr HelpersCache::performForcedDirectIOStorageDetection(
         m_accessType.emplace(std::make_pair(storageId, AccessType::DIRECT));
     }
 
-    try {
+    return folly::makeFutureWith([&]() -> folly::Future<HelperPtr> {
         auto params = communication::wait(
             m_communicator.communicate<messages::fuse::HelperParams>(
                 messages::fuse::GetHelperParams{storageId.toStdString(),
@@ -284,18 +386,21 @@ HelpersCache::HelperPtr HelpersCache::performForcedDirectIOStorageDetection(
         LOG_DBG(1) << "Got storage helper params for file " << fileUuid
                    << " on " << params.name() << " storage " << storageId;
 
-        return m_helperFactory.getStorageHelper(
-            params.name(), params.args(), m_options.isIOBuffered());
-    }
-    catch (std::exception &e) {
-        LOG_DBG(1) << "Unexpected error when waiting for "
-                      "storage helper: "
-                   << e.what();
-        throw std::errc::resource_unavailable_try_again; // NOLINT
-    }
+        return folly::makeFuture<HelperPtr>(
+            helperFactory(storageId, params.name())
+                .getStorageHelper(
+                    params.name(), params.args(), m_options.isIOBuffered()));
+    })
+        .onError([](const std::exception &e) -> HelperPtr {
+            LOG_DBG(1) << "Unexpected error when waiting for "
+                          "storage helper: "
+                       << e.what();
+            throw std::errc::resource_unavailable_try_again; // NOLINT
+        });
 }
 
-HelpersCache::HelperPtr HelpersCache::requestStorageTestFileCreation(
+folly::Future<HelpersCache::HelperPtr>
+HelpersCache::requestStorageTestFileCreation(
     const folly::fbstring &fileUuid, const folly::fbstring &storageId,
     const int maxAttempts)
 {
@@ -327,11 +432,11 @@ HelpersCache::HelperPtr HelpersCache::requestStorageTestFileCreation(
             LOG(INFO) << "Storage '" << storageId
                       << "' is not directly accessible to the client.";
 
-        return {};
+        return folly::makeFuture(HelperPtr{});
     }
 }
 
-HelpersCache::HelperPtr HelpersCache::handleStorageTestFile(
+folly::Future<HelpersCache::HelperPtr> HelpersCache::handleStorageTestFile(
     std::shared_ptr<messages::fuse::StorageTestFile> testFile,
     const folly::fbstring &storageId, const int maxAttempts)
 {
@@ -339,23 +444,38 @@ HelpersCache::HelperPtr HelpersCache::handleStorageTestFile(
                << "'";
 
     try {
-        auto helper = m_storageAccessManager.verifyStorageTestFile(*testFile);
-        auto attempts = maxAttempts;
+        auto helper =
+            m_storageAccessManager.verifyStorageTestFile(storageId, *testFile);
+
+        if (!helper && maxAttempts > 0) {
+            LOG_DBG(1) << "Scheduling retry of storage test file "
+                          "verification for storage: '"
+                       << storageId << "', remaining attempts: "
+                       << maxAttempts;
+
+            auto promise = std::make_shared<folly::Promise<HelperPtr>>();
+            auto future = promise->getFuture();
+            m_scheduler.schedule(VERIFY_TEST_FILE_DELAY,
+                [this, testFile, storageId, maxAttempts, promise] {
+                    folly::makeFutureWith([&] {
+                        return handleStorageTestFile(
+                            testFile, storageId, maxAttempts - 1);
+                    }).then([promise](folly::Try<HelperPtr> &&retried) {
+                        promise->setTry(std::move(retried));
+                    });
+                });
 
-        while (!helper && (attempts-- > 0)) {
-            std::this_thread::sleep_for(VERIFY_TEST_FILE_DELAY);
-            helper = m_storageAccessManager.verifyStorageTestFile(*testFile);
+            return future;
         }
 
         if (!helper) {
             LOG(INFO) << "Storage '" << storageId
                       << "' is not directly accessible to the client. Test "
-                         "file verification attempts limit ("
-                      << maxAttempts << ") exceeded.";
+                         "file verification attempts limit exceeded.";
 
             std::lock_guard<std::mutex> guard(m_accessTypeMutex);
             m_accessType[storageId] = AccessType::PROXY;
-            return {};
+            return folly::makeFuture(HelperPtr{});
         }
 
         auto fileContent =
@@ -363,7 +483,7 @@ HelpersCache::HelperPtr HelpersCache::handleStorageTestFile(
 
         requestStorageTestFileVerification(*testFile, storageId, fileContent);
 
-        return helper;
+        return folly::makeFuture(std::move(helper));
     }
     catch (const std::system_error &e) {
         LOG(ERROR) << "Storage test file handling error, code: '" << e.code()
@@ -381,7 +501,7 @@ HelpersCache::HelperPtr HelpersCache::handleStorageTestFile(
             m_accessType[storageId] = AccessType::PROXY;
         }
 
-        return {};
+        return folly::makeFuture(HelperPtr{});
     }
 }
 
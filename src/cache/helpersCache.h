@@ -10,21 +10,23 @@
 #define ONECLIENT_HELPERS_CACHE_H
 
 #include "communication/communicator.h"
+#include "helpersIoPool.h"
 #include "helpers/storageHelper.h"
 #include "helpers/storageHelperCreator.h"
 #include "options/options.h"
 #include "scheduler.h"
 #include "storageAccessManager.h"
 
-#include <asio/io_service.hpp>
-#include <asio/ts/executor.hpp>
 #include <folly/FBString.h>
 #include <folly/FBVector.h>
 #include <folly/Hash.h>
 #include <folly/futures/Future.h>
 #include <folly/futures/SharedPromise.h>
 
-#include <thread>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <tuple>
 #include <utility>
 
@@ -42,6 +44,7 @@ namespace cache {
 
 constexpr unsigned int VERIFY_TEST_FILE_ATTEMPTS = 5;
 constexpr std::chrono::seconds VERIFY_TEST_FILE_DELAY{5};
+constexpr std::chrono::seconds HELPERS_IO_POOL_PROBE_INTERVAL{1};
 
 /**
  * @c HelpersCache is responsible for creating and caching
@@ -55,8 +58,9 @@ public:
 
     /**
      * Constructor.
-     * Starts an @c asio::io_service instance with one worker thread for
-     * @c helpers::StorageHelperCreator.
+     * Schedules periodic probing of queue latency of the helpers pools. A
+     * separate @c HelpersIoPool is created for helpers of each storage when
+     * they are first created.
      * @param communicator Communicator instance used to fetch helper
      * parameters.
      * @param scheduler Scheduler instance used to execute storage detection
@@ -68,7 +72,7 @@ public:
 
     /**
      * Destructor.
-     * Stops the @c asio::io_service instance and a worker thread.
+     * Stops the helpers pools and their worker threads.
      */
     virtual ~HelpersCache();
 
@@ -92,12 +96,28 @@ public:
     virtual HelpersCache::AccessType getAccessType(
         const folly::fbstring &storageId);
 
+    /**
+     * Returns a counter incremented whenever a helper cached for a storage is
+     * replaced with a new one, e.g. after direct access to the storage has
+     * been detected. Holders of helper handles can compare it with the value
+     * from the time of opening the handles to cheaply check whether a newer
+     * helper may be available.
+     */
+    virtual std::size_t accessGeneration() const
+    {
+        return m_accessGeneration;
+    }
+
 private:
-    HelpersCache::HelperPtr requestStorageTestFileCreation(
+    // Failed test file verifications are retried after
+    // @c VERIFY_TEST_FILE_DELAY using the scheduler, so that retries do not
+    // block any thread; the returned futures are fulfilled after the last
+    // attempt
+    folly::Future<HelpersCache::HelperPtr> requestStorageTestFileCreation(
         const folly::fbstring &fileUuid, const folly::fbstring &storageId,
         const int maxAttempts = VERIFY_TEST_FILE_ATTEMPTS);
 
-    HelpersCache::HelperPtr handleStorageTestFile(
+    folly::Future<HelpersCache::HelperPtr> handleStorageTestFile(
         std::shared_ptr<messages::fuse::StorageTestFile> testFile,
         const folly::fbstring &storageId,
         const int maxAttempts = VERIFY_TEST_FILE_ATTEMPTS);
@@ -113,20 +133,52 @@ private:
         const folly::fbstring &fileUuid, const folly::fbstring &spaceId,
         const folly::fbstring &storageId, bool forceProxyIO);
 
-    HelpersCache::HelperPtr performForcedDirectIOStorageDetection(
+    folly::Future<HelpersCache::HelperPtr>
+    performForcedDirectIOStorageDetection(
         const folly::fbstring &fileUuid, const folly::fbstring &spaceId,
         const folly::fbstring &storageId);
 
+    /**
+     * Returns the factory of helpers of a storage, creating the storage's
+     * helpers pool on first use.
+     * @param storageId Id of the storage.
+     * @param helperName Name of the storage's helper, which determines the
+     * number of threads of the pool.
+     */
+    helpers::StorageHelperCreator &helperFactory(
+        const folly::fbstring &storageId, const folly::fbstring &helperName);
+
+    void scheduleHelpersIoPoolsProbe();
+
     communication::Communicator &m_communicator;
     Scheduler &m_scheduler;
     const options::Options &m_options;
 
-    asio::io_service m_helpersIoService;
-    asio::executor_work_guard<asio::io_service::executor_type> m_idleWork{
-        asio::make_work_guard(m_helpersIoService)};
-    folly::fbvector<std::thread> m_helpersWorkers;
-
-    helpers::StorageHelperCreator m_helperFactory;
+    // Storage helpers of each storage perform their operations in a separate
+    // pool, so that an unresponsive storage cannot block the others, even
+    // ones of the same type
+    struct StorageHelpers {
+        StorageHelpers(const folly::fbstring &storageId,
+            unsigned int threadCount,
+            communication::Communicator &communicator,
+            const options::Options &options);
+
+        HelpersIoPool ioPool;
+        helpers::StorageHelperCreator helperFactory;
+    };
+    std::unordered_map<folly::fbstring, std::unique_ptr<StorageHelpers>>
+        m_storageHelpers;
+    std::mutex m_storageHelpersMutex;
+
+    // Scheduled probes hold the state weakly, so that a probe which fires
+    // while the cache is destroyed doesn't reach it
+    struct IoPoolsProbeState {
+        std::mutex mutex;
+        bool stopped = false;
+    };
+    std::shared_ptr<IoPoolsProbeState> m_ioPoolsProbeState =
+        std::make_shared<IoPoolsProbeState>();
+    std::function<void()> m_cancelIoPoolsProbe = [] {};
 
     // Instance of storage access manager used for performing automatic
     // storage detection
@@ -150,6 +202,7 @@ private:
         std::shared_ptr<folly::SharedPromise<HelperPtr>>>
         m_cache;
     std::mutex m_cacheMutex;
+    std::atomic<std::size_t> m_accessGeneration{0};
 
     // Timeout for Oneprovider responses
     std::chrono::milliseconds m_providerTimeout;
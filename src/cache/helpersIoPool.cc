@@ -0,0 +1,130 @@
+/**
+ * @file helpersIoPool.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "helpersIoPool.h"
+
+#include "logging.h"
+#include "monitoring/monitoring.h"
+
+#include <asio/post.hpp>
+#include <folly/ThreadName.h>
+
+#include <algorithm>
+
+namespace one {
+namespace client {
+namespace cache {
+
+namespace {
+// Queue latency above which a warning about the pool is logged
+constexpr std::chrono::seconds HELPERS_IO_POOL_STALL_THRESHOLD{5};
+} // namespace
+
+HelpersIoPool::HelpersIoPool(std::string name, unsigned int threadCount)
+    : m_name{std::move(name)}
+    , m_threadCount{std::max(threadCount, 1u)}
+    , m_ioService{static_cast<int>(m_threadCount)}
+    , m_queueLatencyMetric{
+          "comp.oneclient.mod.helpers." + m_name + ".queuelatency"}
+    , m_stalledMetric{"comp.oneclient.mod.helpers." + m_name + ".stalled"}
+{
+    LOG_FCALL() << LOG_FARG(m_name) << LOG_FARG(m_threadCount);
+}
+
+HelpersIoPool::~HelpersIoPool() { stop(); }
+
+void HelpersIoPool::start()
+{
+    if (m_started)
+        return;
+
+    std::lock_guard<std::mutex> guard{m_workersMutex};
+    if (m_started || m_stopped)
+        return;
+
+    // Thread names are limited to 15 characters
+    const auto threadName = ("Helpers" + m_name).substr(0, 15);
+
+    std::generate_n(
+        std::back_inserter(m_workers), m_threadCount, [this, threadName] {
+            return std::thread{[this, threadName] {
+                folly::setThreadName(threadName);
+                m_ioService.run();
+            }};
+        });
+
+    m_started = true;
+
+    LOG(INFO) << "Started storage helpers pool '" << m_name << "' with "
+              << m_threadCount << " threads";
+}
+
+void HelpersIoPool::stop()
+{
+    std::lock_guard<std::mutex> guard{m_workersMutex};
+    m_stopped = true;
+
+    if (m_workers.empty())
+        return;
+
+    m_ioService.stop();
+    for (auto &worker : m_workers)
+        worker.join();
+
+    m_workers.clear();
+}
+
+void HelpersIoPool::probe()
+{
+    using std::chrono::steady_clock;
+
+    if (!m_started)
+        return;
+
+    const auto now = steady_clock::now();
+
+    if (m_probePending.exchange(true)) {
+        const auto postedAt = steady_clock::time_point{
+            steady_clock::duration{m_probePostedAt.load()}};
+        const auto waiting =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                now - postedAt);
+
+        if (waiting >= HELPERS_IO_POOL_STALL_THRESHOLD) {
+            LOG(WARNING) << "Storage helpers pool '" << m_name
+                         << "' has not executed queued operations for "
+                         << std::chrono::duration_cast<std::chrono::seconds>(
+                                waiting)
+                                .count()
+                         << " seconds, all " << m_threadCount
+                         << " threads are busy";
+            ONE_METRIC_COUNTER_INC(m_stalledMetric);
+        }
+
+        recordQueueLatency(waiting);
+        return;
+    }
+
+    m_probePostedAt = now.time_since_epoch().count();
+
+    asio::post(m_ioService, [this, now] {
+        recordQueueLatency(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - now));
+        m_probePending = false;
+    });
+}
+
+void HelpersIoPool::recordQueueLatency(std::chrono::microseconds latency)
+{
+    m_queueLatency = latency.count();
+    ONE_METRIC_COUNTER_SET(m_queueLatencyMetric, latency.count());
+}
+
+} // namespace cache
+} // namespace client
+} // namespace one
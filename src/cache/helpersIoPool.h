@@ -0,0 +1,129 @@
+/**
+ * @file helpersIoPool.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <asio/io_service.hpp>
+#include <asio/ts/executor.hpp>
+#include <folly/FBVector.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace one {
+namespace client {
+namespace cache {
+
+/**
+ * @c HelpersIoPool is an @c asio::io_service with a dedicated set of worker
+ * threads, on which storage helpers of a single storage perform their
+ * operations. Separate pools ensure that a slow or unresponsive storage
+ * exhausts only its own threads, leaving other storages, including ones of
+ * the same type, accessible. Pools are created when helpers of the storage
+ * are first created, so that storages which are not used do not hold any
+ * threads.
+ *
+ * Helpers post their operations to the io_service directly, so the length of
+ * its queue cannot be observed. Instead, the pool is periodically probed with
+ * a no-op operation and the time it waits for a worker thread is exported as
+ * the queue latency metric of the pool.
+ */
+class HelpersIoPool {
+public:
+    /**
+     * Constructor.
+     * The worker threads are not started until @c start() is called.
+     * @param name Name of the pool, used in metric and thread names.
+     * @param threadCount Number of worker threads.
+     */
+    HelpersIoPool(std::string name, unsigned int threadCount);
+
+    HelpersIoPool(const HelpersIoPool &) = delete;
+    HelpersIoPool &operator=(const HelpersIoPool &) = delete;
+
+    /**
+     * Destructor.
+     * Stops the pool.
+     */
+    ~HelpersIoPool();
+
+    /**
+     * @return The io_service of the pool.
+     */
+    asio::io_service &ioService() { return m_ioService; }
+
+    /**
+     * @return Name of the pool.
+     */
+    const std::string &name() const { return m_name; }
+
+    /**
+     * @return Number of worker threads of the pool.
+     */
+    unsigned int threadCount() const { return m_threadCount; }
+
+    /**
+     * Starts the worker threads of the pool.
+     * Subsequent calls, as well as calls after @c stop(), have no effect.
+     */
+    void start();
+
+    /**
+     * @return Whether the worker threads of the pool have been started.
+     */
+    bool started() const { return m_started; }
+
+    /**
+     * Posts a probe operation to the pool, which records the time it waited
+     * in the queue. If the previous probe has not been executed yet, no new
+     * probe is posted and the time the previous one has been waiting so far
+     * is recorded instead. Pools which have not been started are not probed.
+     */
+    void probe();
+
+    /**
+     * @return Queue latency recorded by the most recent probe.
+     */
+    std::chrono::microseconds queueLatency() const
+    {
+        return std::chrono::microseconds{m_queueLatency.load()};
+    }
+
+    /**
+     * Stops the io_service and joins the worker threads.
+     * Subsequent calls have no effect.
+     */
+    void stop();
+
+private:
+    void recordQueueLatency(std::chrono::microseconds latency);
+
+    const std::string m_name;
+    const unsigned int m_threadCount;
+
+    asio::io_service m_ioService;
+    asio::executor_work_guard<asio::io_service::executor_type> m_idleWork{
+        asio::make_work_guard(m_ioService)};
+    folly::fbvector<std::thread> m_workers;
+    std::mutex m_workersMutex;
+    std::atomic<bool> m_started{false};
+    bool m_stopped = false;
+
+    const std::string m_queueLatencyMetric;
+    const std::string m_stalledMetric;
+    std::atomic<bool> m_probePending{false};
+    std::atomic<std::chrono::steady_clock::rep> m_probePostedAt{0};
+    std::atomic<std::int64_t> m_queueLatency{0};
+};
+
+} // namespace cache
+} // namespace client
+} // namespace one
@@ -10,7 +10,9 @@
 #include "logging.h"
 #include "monitoring/monitoring.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 
@@ -18,16 +20,38 @@ namespace one {
 namespace client {
 namespace cache {
 
+namespace {
+/**
+ * Computes 64-bit FNV-1a hash of an uuid, which unlike @c std::hash is
+ * guaranteed to be the same across client versions and platforms.
+ */
+fuse_ino_t hashUuid(const folly::fbstring &uuid)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const auto c : uuid) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<fuse_ino_t>(hash);
+}
+} // namespace
+
 InodeCache::Entry::Entry(const fuse_ino_t inode_, folly::fbstring uuid_)
     : inode{inode_}
-    , uuid{std::move(uuid_)}
+    , uuid{uuid_}
 {
 }
 
-InodeCache::InodeCache(
-    folly::fbstring rootUuid, const std::size_t targetCacheSize)
+InodeCache::InodeCache(folly::fbstring rootUuid,
+    const std::size_t targetCacheSize, const EvictionPolicyType evictionPolicy,
+    const bool stableInodes, boost::filesystem::path inodeTablePath)
     : m_targetCacheSize{targetCacheSize}
+    , m_stableInodes{stableInodes}
+    , m_inodeTable{std::move(inodeTablePath)}
+    , m_lru{evictionPolicy, targetCacheSize}
 {
+    m_nextInode =
+        std::max<std::size_t>(m_nextInode, m_inodeTable.maxInode() + 1);
     m_cache.emplace(FUSE_ROOT_ID, rootUuid);
     ONE_METRIC_COUNTER_SET(
         "comp.oneclient.mod.inodecache.maxsize", targetCacheSize);
@@ -37,29 +61,33 @@ fuse_ino_t InodeCache::lookup(const folly::fbstring &uuid)
 {
     LOG_FCALL() << LOG_FARG(uuid);
 
+    // Look up by the string itself, so that hits do not intern the uuid
     auto &index = boost::multi_index::get<ByUuid>(m_cache);
-    auto entryIt = index.find(uuid);
+    auto entryIt = index.find(uuid, util::Uuid::Hash{}, util::Uuid::Equal{});
 
     if (entryIt != index.end()) {
-        if (entryIt->lruIt) {
-            m_lru.erase(*entryIt->lruIt);
-            index.modify(entryIt, [](Entry &entry) {
-                entry.lruIt.clear();
-                ++entry.lookupCount;
-            });
+        bool protectedEntry = entryIt->protectedEntry;
+        if (entryIt->lookupCount == 0) {
+            protectedEntry = m_lru.isProtected(entryIt->inode);
+            m_lru.erase(entryIt->inode);
         }
-        else
-            index.modify(entryIt, [](Entry &e) { ++e.lookupCount; });
+
+        index.modify(entryIt, [&](Entry &e) {
+            ++e.lookupCount;
+            e.protectedEntry = protectedEntry;
+        });
 
         LOG_DBG(2) << "Found inode " << entryIt->inode << " for file " << uuid;
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.inodecache.hit");
 
         return entryIt->inode;
     }
 
-    const auto inode = m_nextInode++;
+    const auto inode = allocateInode(uuid);
     m_cache.emplace(inode, uuid);
 
     LOG_DBG(2) << "Created new inode " << inode << " for file " << uuid;
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.inodecache.miss");
 
     prune();
 
@@ -68,13 +96,29 @@ fuse_ino_t InodeCache::lookup(const folly::fbstring &uuid)
     return inode;
 }
 
-folly::fbstring InodeCache::at(const fuse_ino_t inode) const
+util::Uuid InodeCache::at(const fuse_ino_t inode) const
 {
     LOG_FCALL() << LOG_FARG(inode);
 
     auto &index = boost::multi_index::get<ByInode>(m_cache);
     auto entryIt = index.find(inode);
-    if (entryIt == index.end() || entryIt->lruIt) {
+    const bool persistent = m_stableInodes || m_inodeTable.enabled();
+    if (entryIt != index.end() && persistent) {
+        LOG_DBG(2) << "Returning file " << entryIt->uuid << " for inode "
+                   << inode;
+        return entryIt->uuid;
+    }
+
+    if (entryIt == index.end()) {
+        auto uuid = m_inodeTable.uuid(inode);
+        if (uuid) {
+            LOG_DBG(2) << "Returning file " << *uuid << " for inode " << inode
+                       << " from inode table";
+            return util::Uuid{*uuid};
+        }
+    }
+
+    if (entryIt == index.end() || entryIt->lookupCount == 0) {
         LOG(ERROR) << "No file found for inode " << inode;
         throw std::out_of_range{
             "no active mapping for inode " + std::to_string(inode)};
@@ -105,15 +149,13 @@ void InodeCache::forget(const fuse_ino_t inode, const std::size_t count)
     else if (entryIt->deleted) {
         LOG_DBG(2) << "Removing deleted inode " << inode << " from inode cache";
         index.erase(entryIt);
+        m_inodeTable.erase(inode);
     }
     else {
         LOG_DBG(2) << "Modifying entry lookup count to " << newCount
                    << " and lru index";
-        const auto newLruIt = m_lru.insert(m_lru.end(), inode);
-        index.modify(entryIt, [&](Entry &entry) {
-            entry.lookupCount = newCount;
-            entry.lruIt = newLruIt;
-        });
+        index.modify(entryIt, [&](Entry &e) { e.lookupCount = newCount; });
+        m_lru.insert(inode, entryIt->uuid, entryIt->protectedEntry);
 
         prune();
     }
@@ -125,9 +167,19 @@ void InodeCache::rename(folly::fbstring oldUuid, folly::fbstring newUuid)
     LOG_FCALL() << LOG_FARG(oldUuid) << LOG_FARG(newUuid);
 
     auto &index = boost::multi_index::get<ByUuid>(m_cache);
-    const auto entryRange = index.equal_range(oldUuid);
-    for (auto it = entryRange.first; it != entryRange.second; ++it)
-        index.modify_key(it, [&](folly::fbstring &key) { key.swap(newUuid); });
+    auto it = index.find(oldUuid, util::Uuid::Hash{}, util::Uuid::Equal{});
+    if (it == index.end()) {
+        // Inode of a file pruned from the cache moves to the new uuid
+        auto inode = m_inodeTable.inode(oldUuid);
+        if (inode)
+            m_inodeTable.put(*inode, newUuid);
+        return;
+    }
+
+    const auto inode = it->inode;
+    if (index.modify_key(
+            it, [&](util::Uuid &key) { key = util::Uuid{newUuid}; }))
+        m_inodeTable.put(inode, it->uuid);
 }
 
 void InodeCache::markDeleted(folly::fbstring uuid)
@@ -135,9 +187,42 @@ void InodeCache::markDeleted(folly::fbstring uuid)
     LOG_FCALL() << LOG_FARG(uuid);
 
     auto &index = boost::multi_index::get<ByUuid>(m_cache);
-    const auto entryRange = index.equal_range(uuid);
-    for (auto it = entryRange.first; it != entryRange.second; ++it)
+    auto it = index.find(uuid, util::Uuid::Hash{}, util::Uuid::Equal{});
+    if (it != index.end()) {
         index.modify(it, [](Entry &e) { e.deleted = true; });
+        return;
+    }
+
+    // Files pruned from the cache are dropped from the inode table at once
+    auto inode = m_inodeTable.inode(uuid);
+    if (inode)
+        m_inodeTable.erase(*inode);
+}
+
+fuse_ino_t InodeCache::allocateInode(const folly::fbstring &uuid)
+{
+    auto &index = boost::multi_index::get<ByInode>(m_cache);
+
+    auto known = m_inodeTable.inode(uuid);
+    if (known && index.count(*known) == 0)
+        return *known;
+
+    // An inode is free if it's not used by a cached entry nor reserved in the
+    // inode table for another file
+    auto isFree = [&](const fuse_ino_t inode) {
+        if (inode <= FUSE_ROOT_ID || index.count(inode) > 0)
+            return false;
+
+        auto tableUuid = m_inodeTable.uuid(inode);
+        return !tableUuid || *tableUuid == uuid;
+    };
+
+    fuse_ino_t inode = m_stableInodes ? hashUuid(uuid) : m_nextInode++;
+    while (!isFree(inode))
+        inode = m_stableInodes ? inode + 1 : m_nextInode++;
+
+    m_inodeTable.put(inode, uuid);
+    return inode;
 }
 
 void InodeCache::prune()
@@ -146,8 +231,9 @@ void InodeCache::prune()
 
     auto &index = boost::multi_index::get<ByInode>(m_cache);
     if (m_cache.size() > m_targetCacheSize && !m_lru.empty()) {
-        index.erase(m_lru.front());
-        m_lru.pop_front();
+        index.erase(m_lru.evict([&](const fuse_ino_t inode) {
+            return index.find(inode)->uuid;
+        }));
     }
 }
 
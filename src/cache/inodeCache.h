@@ -8,9 +8,12 @@
 
 #pragma once
 
+#include "evictionPolicy.h"
+#include "inodeTable.h"
+#include "util/uuid.h"
+
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 #include <folly/FBString.h>
 #include <folly/Optional.h>
@@ -20,8 +23,19 @@ namespace one {
 namespace client {
 namespace cache {
 
+constexpr std::size_t DEFAULT_INODE_CACHE_SIZE = 100000;
+
 /**
  * @c InodeCache is responsible for translating between uuids and inodes.
+ * By default inodes are assigned sequentially. With stable inodes enabled,
+ * an inode is derived from a 64-bit hash of the uuid, with colliding inodes
+ * resolved by probing consecutive numbers, so that files keep their inodes
+ * after being pruned from the cache and after the client is remounted.
+ * Optionally, assigned inodes are persisted in an @c InodeTable.
+ * The cache is kept separate from @c LRUMetadataCache on purpose: it lives in
+ * the layer translating inodes to uuids above @c FsLogic and its entries
+ * live as long as the kernel holds lookup references to them, while
+ * metadata entries live as long as files are open or subscribed to.
  */
 class InodeCache {
 public:
@@ -31,9 +45,16 @@ public:
      * @c FUSE_ROOT_ID .
      * @param targetCacheSize The target size of the cache; the cache will
      * attempt to keep population no bigger than this number.
+     * @param evictionPolicy Policy selecting forgotten inodes to prune.
+     * @param stableInodes Whether inodes should be derived from uuids.
+     * @param inodeTablePath Path of the persistent inode table, empty path
+     * disables the table.
      */
-    InodeCache(
-        folly::fbstring rootUuid, const std::size_t targetCacheSize = 100000);
+    InodeCache(folly::fbstring rootUuid,
+        const std::size_t targetCacheSize = DEFAULT_INODE_CACHE_SIZE,
+        const EvictionPolicyType evictionPolicy = EvictionPolicyType::lru,
+        const bool stableInodes = false,
+        boost::filesystem::path inodeTablePath = {});
 
     /**
      * Looks up an number by its uuid and increments lookup count for the
@@ -47,10 +68,13 @@ public:
     /**
      * Returns an uuid associated with the inode.
      * Throws an instance of @c std::out_of_range if inode is unknown.
+     * Unless inodes are stable or persisted, inodes with lookup count
+     * dropped to 0 are unknown.
      * @param ino Inode to look up by.
-     * @returns Uuid associated with the inode.
+     * @returns Interned uuid associated with the inode; copying it does not
+     * allocate.
      */
-    folly::fbstring at(const fuse_ino_t ino) const;
+    util::Uuid at(const fuse_ino_t ino) const;
 
     /**
      * Decrements lookup cound of a cached inode.
@@ -77,6 +101,8 @@ public:
 private:
     void prune();
 
+    fuse_ino_t allocateInode(const folly::fbstring &uuid);
+
     struct ByInode {
     };
     struct ByUuid {
@@ -86,23 +112,32 @@ private:
         Entry(fuse_ino_t, folly::fbstring);
 
         fuse_ino_t inode;
-        folly::fbstring uuid;
+        util::Uuid uuid;
+        // Forgotten entries, with lookup count 0, are the ones evictable by
+        // the eviction policy
         std::size_t lookupCount{1};
-        folly::Optional<std::list<fuse_ino_t>::iterator> lruIt;
         bool deleted{false};
+        // Whether the entry was in the protected queue before it was looked
+        // up again
+        bool protectedEntry{false};
     };
 
     using Map = boost::multi_index::multi_index_container<Entry,
         boost::multi_index::indexed_by<
-            boost::multi_index::ordered_unique<boost::multi_index::tag<ByInode>,
-                boost::multi_index::member<Entry, fuse_ino_t, &Entry::inode>>,
-            boost::multi_index::ordered_unique<boost::multi_index::tag<ByUuid>,
-                boost::multi_index::member<Entry, folly::fbstring,
-                    &Entry::uuid>>>>;
+            boost::multi_index::hashed_unique<boost::multi_index::tag<ByInode>,
+                boost::multi_index::member<Entry, fuse_ino_t, &Entry::inode>,
+                std::hash<fuse_ino_t>>,
+            boost::multi_index::hashed_unique<boost::multi_index::tag<ByUuid>,
+                boost::multi_index::member<Entry, util::Uuid, &Entry::uuid>,
+                util::Uuid::Hash, util::Uuid::Equal>>>;
 
     const std::size_t m_targetCacheSize;
+    const bool m_stableInodes;
+    InodeTable m_inodeTable;
     Map m_cache;
-    std::list<fuse_ino_t> m_lru;
+    // Ghost entries are remembered by uuid, as a file pruned from the cache
+    // is usually assigned a new inode when it is looked up again
+    EvictionPolicy<fuse_ino_t, util::Uuid> m_lru;
     std::size_t m_nextInode = FUSE_ROOT_ID + 1;
 };
 
@@ -0,0 +1,278 @@
+/**
+ * @file inodeTable.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "inodeTable.h"
+
+#include "logging.h"
+
+#include <folly/Conv.h>
+#include <folly/String.h>
+#include <folly/ThreadName.h>
+
+#include <algorithm>
+#include <iterator>
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace one {
+namespace client {
+namespace cache {
+
+InodeTable::InodeTable(
+    boost::filesystem::path path, const std::size_t maxSize)
+    : m_path{std::move(path)}
+    , m_maxSize{maxSize}
+{
+    if (!enabled())
+        return;
+
+    if (m_path.has_parent_path())
+        boost::filesystem::create_directories(m_path.parent_path());
+
+    load();
+
+    if (m_fileLines > m_uuids.size())
+        compact();
+    else
+        open();
+
+    m_flusher = std::thread{[this] {
+        folly::setThreadName("InodeTableFlush");
+        flushPeriodically();
+    }};
+}
+
+InodeTable::~InodeTable()
+{
+    if (!enabled())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard{m_mutex};
+        m_stopped = true;
+    }
+    m_flushCondition.notify_all();
+    m_flusher.join();
+
+    flushUnlocked();
+}
+
+void InodeTable::flushPeriodically()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (!m_stopped) {
+        m_flushCondition.wait_for(lock, INODE_TABLE_FLUSH_INTERVAL);
+        if (m_unflushed > 0)
+            flushUnlocked();
+    }
+}
+
+void InodeTable::open()
+{
+    m_file.open(m_path.string(), std::ios::out | std::ios::app);
+    if (!m_file)
+        throw std::system_error{errno, std::system_category(),
+            "cannot open inode table " + m_path.string()};
+}
+
+void InodeTable::load()
+{
+    std::ifstream file{m_path.string()};
+    std::string line;
+    while (std::getline(file, line)) {
+        ++m_fileLines;
+
+        std::vector<folly::StringPiece> parts;
+        folly::split(' ', line, parts);
+
+        std::string uuid;
+        fuse_ino_t inode = 0;
+        bool validLine = false;
+        if (parts.size() == 1 ||
+            (parts.size() == 2 && folly::unhexlify(parts[1], uuid))) {
+            try {
+                inode = folly::to<fuse_ino_t>(parts[0]);
+                validLine = true;
+            }
+            catch (const std::range_error &) {
+            }
+        }
+
+        if (!validLine) {
+            LOG(WARNING) << "Skipping invalid line in inode table " << m_path
+                         << ": '" << line << "'";
+            continue;
+        }
+
+        if (parts.size() == 1) {
+            forget(inode);
+            continue;
+        }
+
+        associate(inode, uuid);
+    }
+
+    LOG(INFO) << "Loaded " << m_uuids.size() << " inodes from inode table "
+              << m_path;
+}
+
+folly::Optional<fuse_ino_t> InodeTable::inode(
+    const folly::fbstring &uuid) const
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+    auto it = m_inodes.find(uuid);
+    if (it == m_inodes.end())
+        return {};
+
+    return it->second;
+}
+
+folly::Optional<folly::fbstring> InodeTable::uuid(const fuse_ino_t inode) const
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+    auto it = m_uuids.find(inode);
+    if (it == m_uuids.end())
+        return {};
+
+    return it->second.uuid;
+}
+
+void InodeTable::put(const fuse_ino_t inode, const folly::fbstring &uuid)
+{
+    if (!enabled())
+        return;
+
+    std::lock_guard<std::mutex> guard{m_mutex};
+    auto it = m_uuids.find(inode);
+    if (it != m_uuids.end() && it->second.uuid == uuid)
+        return;
+
+    associate(inode, uuid);
+
+    std::string hexUuid;
+    folly::hexlify(uuid, hexUuid);
+    append(std::to_string(inode) + ' ' + hexUuid);
+}
+
+void InodeTable::erase(const fuse_ino_t inode)
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+    if (m_uuids.find(inode) == m_uuids.end())
+        return;
+
+    forget(inode);
+    append(std::to_string(inode));
+}
+
+void InodeTable::flush()
+{
+    if (!enabled())
+        return;
+
+    std::lock_guard<std::mutex> guard{m_mutex};
+    flushUnlocked();
+}
+
+void InodeTable::flushUnlocked()
+{
+    m_file.flush();
+    m_unflushed = 0;
+
+    if (!m_file) {
+        LOG(WARNING) << "Failed to write to inode table " << m_path;
+        m_file.clear();
+    }
+}
+
+void InodeTable::append(const std::string &line)
+{
+    m_file << line << '\n';
+    ++m_fileLines;
+
+    if (++m_unflushed >= INODE_TABLE_FLUSH_BATCH)
+        flushUnlocked();
+
+    const auto garbage = m_fileLines - m_uuids.size();
+    if (garbage >= INODE_TABLE_MIN_GARBAGE && garbage > m_uuids.size())
+        compact();
+}
+
+void InodeTable::compact()
+{
+    LOG_DBG(1) << "Compacting inode table " << m_path << " from "
+               << m_fileLines << " to " << m_uuids.size() << " lines";
+
+    if (m_file.is_open())
+        m_file.close();
+
+    auto tmpPath = m_path;
+    tmpPath += ".tmp";
+
+    {
+        std::ofstream file{tmpPath.string(), std::ios::out | std::ios::trunc};
+        // Associations are written from the oldest, so that their age is
+        // preserved when the table is loaded
+        for (const auto inode : m_ages) {
+            std::string hexUuid;
+            folly::hexlify(m_uuids.at(inode).uuid, hexUuid);
+            file << inode << ' ' << hexUuid << '\n';
+        }
+        file.close();
+
+        boost::system::error_code ec;
+        if (file)
+            boost::filesystem::rename(tmpPath, m_path, ec);
+
+        if (!file || ec) {
+            LOG(WARNING) << "Failed to compact inode table " << m_path;
+            boost::filesystem::remove(tmpPath, ec);
+            open();
+            return;
+        }
+    }
+
+    m_fileLines = m_uuids.size();
+    m_unflushed = 0;
+    open();
+}
+
+void InodeTable::associate(const fuse_ino_t inode, const folly::fbstring &uuid)
+{
+    forget(inode);
+
+    auto inodeIt = m_inodes.find(uuid);
+    if (inodeIt != m_inodes.end())
+        forget(inodeIt->second);
+
+    m_ages.emplace_back(inode);
+    m_uuids[inode] = Association{uuid, std::prev(m_ages.end())};
+    m_inodes[uuid] = inode;
+    m_maxInode = std::max(m_maxInode, inode);
+
+    // The oldest associations are only dropped from the file when it's
+    // compacted, but they already count as its outdated lines
+    while (m_uuids.size() > m_maxSize)
+        forget(m_ages.front());
+}
+
+void InodeTable::forget(const fuse_ino_t inode)
+{
+    auto it = m_uuids.find(inode);
+    if (it == m_uuids.end())
+        return;
+
+    m_inodes.erase(it->second.uuid);
+    m_ages.erase(it->second.age);
+    m_uuids.erase(it);
+}
+
+} // namespace cache
+} // namespace client
+} // namespace one
@@ -0,0 +1,155 @@
+/**
+ * @file inodeTable.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <boost/filesystem.hpp>
+#include <folly/FBString.h>
+#include <folly/Optional.h>
+#include <fuse/fuse_lowlevel.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace one {
+namespace client {
+namespace cache {
+
+// Number of appended associations, after which the table file is flushed
+constexpr std::size_t INODE_TABLE_FLUSH_BATCH = 256;
+
+// Interval in which appended associations are flushed in the background
+constexpr std::chrono::seconds INODE_TABLE_FLUSH_INTERVAL{1};
+
+// Default maximum number of associations kept by the table
+constexpr std::size_t INODE_TABLE_MAX_SIZE = 1000000;
+
+// Minimum number of outdated lines in the table file, which trigger its
+// compaction once they outnumber the current associations
+constexpr std::size_t INODE_TABLE_MIN_GARBAGE = 1024;
+
+/**
+ * @c InodeTable persists associations between inodes and uuids handed out by
+ * @c InodeCache, so that the same inodes are assigned to files after the
+ * client is remounted and inodes remembered by the kernel or NFS clients can
+ * be translated back to uuids.
+ * Associations are appended to a text file, one '<inode> <hex uuid>' line per
+ * association, with later lines overriding earlier ones when the file is
+ * loaded and a line with only the inode removing the association. Appended
+ * lines are flushed in batches and periodically in the background, so the
+ * associations made within the last flush interval can be lost if the client
+ * crashes. The file is rewritten with only the current associations when it
+ * is loaded or when outdated lines outnumber them.
+ * To bound the memory used by the table, once it holds @c maxSize
+ * associations the oldest ones are forgotten, so that the files will be
+ * assigned new inodes after the client is remounted.
+ */
+class InodeTable {
+public:
+    /**
+     * Constructor.
+     * Loads associations stored in the table file.
+     * @param path Path of the table file, empty path disables the table.
+     * @param maxSize Maximum number of associations kept by the table.
+     */
+    InodeTable(boost::filesystem::path path,
+        const std::size_t maxSize = INODE_TABLE_MAX_SIZE);
+
+    /**
+     * Destructor.
+     * Flushes appended associations to the table file.
+     */
+    ~InodeTable();
+
+    /**
+     * @return Whether the table is enabled.
+     */
+    bool enabled() const { return !m_path.empty(); }
+
+    /**
+     * Finds an inode associated with a uuid.
+     * @param uuid Uuid of the file.
+     */
+    folly::Optional<fuse_ino_t> inode(const folly::fbstring &uuid) const;
+
+    /**
+     * Finds an uuid associated with an inode.
+     * @param inode Inode of the file.
+     */
+    folly::Optional<folly::fbstring> uuid(const fuse_ino_t inode) const;
+
+    /**
+     * @return The highest inode stored in the table.
+     */
+    fuse_ino_t maxInode() const { return m_maxInode; }
+
+    /**
+     * Associates an inode with a uuid and persists the association.
+     * @param inode Inode of the file.
+     * @param uuid Uuid of the file.
+     */
+    void put(const fuse_ino_t inode, const folly::fbstring &uuid);
+
+    /**
+     * Removes an association of an inode, e.g. when the file is deleted.
+     * @param inode Inode of the file.
+     */
+    void erase(const fuse_ino_t inode);
+
+    /**
+     * Flushes appended associations to the table file.
+     */
+    void flush();
+
+private:
+    struct Association {
+        folly::fbstring uuid;
+        std::list<fuse_ino_t>::iterator age;
+    };
+
+    void flushUnlocked();
+
+    void flushPeriodically();
+
+    void load();
+
+    void open();
+
+    void compact();
+
+    void append(const std::string &line);
+
+    void associate(const fuse_ino_t inode, const folly::fbstring &uuid);
+
+    void forget(const fuse_ino_t inode);
+
+    const boost::filesystem::path m_path;
+    const std::size_t m_maxSize;
+    std::ofstream m_file;
+    std::unordered_map<fuse_ino_t, Association> m_uuids;
+    std::unordered_map<folly::fbstring, fuse_ino_t> m_inodes;
+    // Inodes from the oldest to the most recently associated
+    std::list<fuse_ino_t> m_ages;
+    fuse_ino_t m_maxInode = 0;
+    std::size_t m_fileLines = 0;
+    std::size_t m_unflushed = 0;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_flushCondition;
+    bool m_stopped = false;
+    std::thread m_flusher;
+};
+
+} // namespace cache
+} // namespace client
+} // namespace one
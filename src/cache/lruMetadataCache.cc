@@ -4,8 +4,10 @@
 #include "logging.h"
 #include "messages/fuse/fileAttr.h"
 #include "messages/fuse/fileLocation.h"
+#include "monitoring/monitoring.h"
 
 #include <functional>
+#include <iterator>
 
 namespace one {
 namespace client {
@@ -24,9 +26,12 @@ LRUMetadataCache::OpenFileToken::~OpenFileToken()
 }
 
 LRUMetadataCache::LRUMetadataCache(communication::Communicator &communicator,
-    const std::size_t targetSize, const std::chrono::seconds providerTimeout)
+    const std::size_t targetSize, const std::chrono::seconds providerTimeout,
+    const EvictionPolicyType evictionPolicy, const std::size_t memoryLimit)
     : MetadataCache{communicator, providerTimeout}
     , m_targetSize{targetSize}
+    , m_memoryLimit{memoryLimit}
+    , m_evictionPolicy{evictionPolicy, targetSize}
 {
     MetadataCache::onRename(std::bind(&LRUMetadataCache::handleRename, this,
         std::placeholders::_1, std::placeholders::_2));
@@ -45,25 +50,25 @@ void LRUMetadataCache::pinEntry(const folly::fbstring &uuid)
 {
     LOG_FCALL() << LOG_FARG(uuid);
 
-    auto res = m_lruData.emplace(uuid, LRUData{});
+    auto it = findLRUData(uuid);
+    if (it == m_lruData.end()) {
+        it = m_lruData.emplace(util::Uuid{uuid}, LRUData{}).first;
 
-    if (res.second) {
         // If this uuid was not already in the cache, make sure to create
         // proper subscriptions
         m_onAdd(uuid);
     }
 
-    auto &lruData = res.first->second;
+    auto &lruData = it->second;
 
     ++lruData.openCount;
 
     LOG_DBG(2) << "Increased LRU open count of " << uuid << " to "
                << lruData.openCount;
 
-    if (lruData.lruIt) {
-        m_lruList.erase(*lruData.lruIt);
-        lruData.lruIt.clear();
-
+    if (m_evictionPolicy.contains(it->first)) {
+        lruData.protectedEntry = m_evictionPolicy.isProtected(it->first);
+        m_evictionPolicy.erase(it->first);
         m_onOpen(uuid);
     }
 }
@@ -78,6 +83,7 @@ std::shared_ptr<LRUMetadataCache::OpenFileToken> LRUMetadataCache::open(
     try {
         auto attr = MetadataCache::getAttr(uuid);
         MetadataCache::ensureAttrAndLocationCached(uuid);
+        refreshFootprint(uuid);
         prune();
         return std::make_shared<OpenFileToken>(std::move(attr), *this);
     }
@@ -99,6 +105,7 @@ std::shared_ptr<LRUMetadataCache::OpenFileToken> LRUMetadataCache::open(
 
     MetadataCache::putAttr(attr);
     MetadataCache::putLocation(std::move(location));
+    refreshFootprint(uuid);
     prune();
     return std::make_shared<OpenFileToken>(std::move(attr), *this);
 }
@@ -107,7 +114,7 @@ void LRUMetadataCache::release(const folly::fbstring &uuid)
 {
     LOG_FCALL() << LOG_FARG(uuid);
 
-    auto it = m_lruData.find(uuid);
+    auto it = findLRUData(uuid);
     if (it == m_lruData.end())
         return;
 
@@ -117,11 +124,14 @@ void LRUMetadataCache::release(const folly::fbstring &uuid)
     m_onRelease(uuid);
 
     if (it->second.deleted) {
+        m_footprint -= it->second.footprint;
         m_lruData.erase(it);
         MetadataCache::erase(uuid);
     }
     else {
-        it->second.lruIt = m_lruList.emplace(m_lruList.end(), uuid);
+        // Opening a file must not demote it from the protected queue
+        m_evictionPolicy.insert(it->first, it->second.protectedEntry);
+        refreshFootprint(uuid);
         prune();
     }
 }
@@ -153,22 +163,54 @@ void LRUMetadataCache::putAttr(std::shared_ptr<FileAttr> attr)
     noteActivity(attr->uuid());
 }
 
+std::vector<FileAttrPtr> LRUMetadataCache::fetchAttrs(
+    const std::vector<folly::fbstring> &uuids, const std::size_t batchSize)
+{
+    LOG_FCALL() << LOG_FARG(uuids.size()) << LOG_FARG(batchSize);
+
+    auto attrs = MetadataCache::fetchAttrs(uuids, batchSize);
+    for (const auto &attr : attrs)
+        noteActivity(attr->uuid());
+
+    return attrs;
+}
+
+std::vector<folly::fbstring> LRUMetadataCache::recentlyUsed(
+    const std::size_t limit) const
+{
+    std::vector<folly::fbstring> result;
+    for (const auto &entry : m_lruData) {
+        if (result.size() >= limit)
+            return result;
+
+        if (entry.second.openCount > 0 && !entry.second.deleted)
+            result.emplace_back(entry.first.str());
+    }
+
+    for (const auto &uuid : m_evictionPolicy.keys(limit - result.size()))
+        result.emplace_back(uuid.str());
+
+    return result;
+}
+
 void LRUMetadataCache::noteActivity(const folly::fbstring &uuid)
 {
     LOG_FCALL() << LOG_FARG(uuid);
 
-    auto res = m_lruData.emplace(uuid, LRUData{});
+    auto it = findLRUData(uuid);
+    if (it == m_lruData.end()) {
+        it = m_lruData.emplace(util::Uuid{uuid}, LRUData{}).first;
 
-    if (res.second) {
         // If this uuid was not already in the cache, make sure to create
         // proper subscriptions
-        res.first->second.lruIt = m_lruList.emplace(m_lruList.end(), uuid);
+        m_evictionPolicy.insert(it->first);
         m_onAdd(uuid);
     }
-    else if (res.first->second.lruIt) {
-        m_lruList.splice(m_lruList.end(), m_lruList, *res.first->second.lruIt);
+    else {
+        m_evictionPolicy.touch(it->first);
     }
 
+    refreshFootprint(uuid);
     prune();
 }
 
@@ -176,16 +218,44 @@ void LRUMetadataCache::prune()
 {
     LOG_FCALL();
 
-    if (m_lruData.size() > m_targetSize && !m_lruList.empty()) {
+    while (!m_evictionPolicy.empty() &&
+        (m_lruData.size() > m_targetSize ||
+            (m_memoryLimit > 0 && m_footprint > m_memoryLimit))) {
         LOG_DBG(1) << "Pruning LRU metadata cache front because it exceeds "
                       "target size ("
-                   << m_lruData.size() << ">" << m_targetSize << ")";
-        auto uuid = std::move(m_lruList.front());
-        m_lruList.pop_front();
-        m_lruData.erase(uuid);
+                   << m_lruData.size() << ">" << m_targetSize
+                   << ") or memory limit (" << m_footprint << ">"
+                   << m_memoryLimit << ")";
+        const auto uuid = m_evictionPolicy.evict();
+        auto it = m_lruData.find(uuid);
+        m_footprint -= it->second.footprint;
+        m_lruData.erase(it);
         MetadataCache::erase(uuid);
         m_onPrune(uuid);
     }
+
+    ONE_METRIC_COUNTER_SET(
+        "comp.oneclient.mod.metadatacache.footprint", m_footprint);
+}
+
+void LRUMetadataCache::refreshFootprint(const folly::fbstring &uuid)
+{
+    auto it = findLRUData(uuid);
+    if (it == m_lruData.end())
+        return;
+
+    // The LRU record is a hash map node referring to the interned uuid,
+    // which is counted once although it may be shared with other caches,
+    // and evictable entries keep two more references in the eviction policy
+    auto footprint = MetadataCache::entryFootprint(uuid) + sizeof(*it) +
+        3 * sizeof(void *) + sizeof(folly::fbstring) +
+        heapFootprint(it->first.str());
+
+    if (m_evictionPolicy.contains(it->first))
+        footprint += EvictionPolicy<util::Uuid>::entryFootprint();
+
+    m_footprint = m_footprint - it->second.footprint + footprint;
+    it->second.footprint = footprint;
 }
 
 bool LRUMetadataCache::rename(folly::fbstring uuid,
@@ -229,8 +299,10 @@ void LRUMetadataCache::putLocation(std::unique_ptr<FileLocation> location)
 {
     LOG_FCALL();
 
-    noteActivity(location->uuid());
+    const folly::fbstring uuid{location->uuid()};
+    noteActivity(uuid);
     MetadataCache::putLocation(std::move(location));
+    refreshFootprint(uuid);
 }
 
 std::shared_ptr<FileLocation> LRUMetadataCache::getLocation(
@@ -243,27 +315,33 @@ std::shared_ptr<FileLocation> LRUMetadataCache::getLocation(
 
 bool LRUMetadataCache::updateLocation(const FileLocation &newLocation)
 {
-    return MetadataCache::updateLocation(newLocation);
+    const auto result = MetadataCache::updateLocation(newLocation);
+    refreshFootprint(newLocation.uuid());
+    return result;
 }
 
 bool LRUMetadataCache::updateLocation(
     const off_t start, const off_t end, const FileLocation &locationUpdate)
 {
-    return MetadataCache::updateLocation(start, end, locationUpdate);
+    const auto result =
+        MetadataCache::updateLocation(start, end, locationUpdate);
+    refreshFootprint(locationUpdate.uuid());
+    return result;
 }
 
 void LRUMetadataCache::handleMarkDeleted(const folly::fbstring &uuid)
 {
     LOG_FCALL() << LOG_FARG(uuid);
 
-    auto it = m_lruData.find(uuid);
+    auto it = findLRUData(uuid);
     if (it == m_lruData.end())
         return;
 
     it->second.deleted = true;
 
-    if (it->second.lruIt) {
-        m_lruList.erase(*it->second.lruIt);
+    if (m_evictionPolicy.contains(it->first)) {
+        m_evictionPolicy.erase(it->first);
+        m_footprint -= it->second.footprint;
         m_lruData.erase(it);
         MetadataCache::erase(uuid);
     }
@@ -276,21 +354,19 @@ void LRUMetadataCache::handleRename(
 {
     LOG_FCALL() << LOG_FARG(oldUuid) << LOG_FARG(newUuid);
 
-    auto it = m_lruData.find(oldUuid);
+    auto it = findLRUData(oldUuid);
     if (it == m_lruData.end())
         return;
 
+    const auto oldKey = it->first;
     auto lruData = std::move(it->second);
     m_lruData.erase(it);
 
-    auto res = m_lruData.emplace(newUuid, LRUData{});
+    const util::Uuid newKey{newUuid};
+    auto res = m_lruData.emplace(newKey, LRUData{});
     if (res.second) {
         res.first->second = std::move(lruData);
-        if (res.first->second.lruIt) {
-            auto oldIt = *(res.first->second.lruIt);
-            res.first->second.lruIt = m_lruList.emplace(oldIt, newUuid);
-            m_lruList.erase(oldIt);
-        }
+        m_evictionPolicy.rename(oldKey, newKey);
     }
     else {
         LOG(WARNING) << "Target UUID '" << newUuid
@@ -300,14 +376,21 @@ void LRUMetadataCache::handleRename(
         auto &oldRecord = res.first->second;
         oldRecord.openCount += lruData.openCount;
         oldRecord.deleted = oldRecord.deleted || lruData.deleted;
+        m_footprint -= lruData.footprint;
 
-        if (lruData.lruIt)
-            m_lruList.erase(*lruData.lruIt);
+        m_evictionPolicy.erase(oldKey);
     }
 
+    refreshFootprint(newUuid);
     m_onRename(oldUuid, newUuid);
 }
 
+LRUMetadataCache::LRUDataMap::iterator LRUMetadataCache::findLRUData(
+    const folly::fbstring &uuid)
+{
+    return m_lruData.find(uuid, util::Uuid::Hash{}, util::Uuid::Equal{});
+}
+
 } // namespace cache
 } // namespace client
 } // namespace one
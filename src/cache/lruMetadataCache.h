@@ -8,17 +8,20 @@
 
 #pragma once
 
+#include "evictionPolicy.h"
 #include "metadataCache.h"
+#include "util/uuid.h"
 
 #include "communication/communicator.h"
 
+#include <boost/unordered_map.hpp>
 #include <folly/FBString.h>
 #include <folly/Optional.h>
 
 #include <cstdint>
-#include <list>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace one {
 namespace client {
@@ -65,10 +68,28 @@ public:
      * MetadataCache constructor.
      * @param targetSize The target size of the cache; the cache will attempt
      * to keep population no bigger than this number.
+     * @param providerTimeout Timeout for provider requests.
+     * @param evictionPolicy Policy selecting entries to prune.
+     * @param memoryLimit Estimated memory in bytes, above which the cache
+     * prunes entries regardless of their number; 0 means no limit.
      */
     LRUMetadataCache(communication::Communicator &communicator,
         const std::size_t targetSize,
-        const std::chrono::seconds providerTimeout);
+        const std::chrono::seconds providerTimeout,
+        const EvictionPolicyType evictionPolicy = EvictionPolicyType::lru,
+        const std::size_t memoryLimit = 0);
+
+    /**
+     * @return Estimated memory in bytes used by the cached entries.
+     */
+    std::size_t footprint() const { return m_footprint; }
+
+    /**
+     * Lists uuids of cached files, starting with open files and followed by
+     * the rest of files in the order opposite to eviction.
+     * @param limit Maximum number of listed uuids.
+     */
+    std::vector<folly::fbstring> recentlyUsed(const std::size_t limit) const;
 
     /**
      * Sets a pointer to an instance of @c ReaddirCache.
@@ -110,6 +131,14 @@ public:
      */
     void putAttr(std::shared_ptr<FileAttr> attr);
 
+    /**
+     * @copydoc MetadataCache::fetchAttrs(const std::vector<folly::fbstring> &,
+     * const std::size_t)
+     */
+    std::vector<FileAttrPtr> fetchAttrs(
+        const std::vector<folly::fbstring> &uuids,
+        const std::size_t batchSize = DEFAULT_BULK_FETCH_SIZE);
+
     /**
      * Sets a callback that will be called after a file is added to the cache.
      * @param cb The callback which takes uuid as parameter.
@@ -222,15 +251,19 @@ public:
     using MetadataCache::getDefaultBlock;
     using MetadataCache::getSpaceId;
 
+    using MetadataCache::isCached;
     using MetadataCache::markDeleted;
     using MetadataCache::putAttr;
+    using MetadataCache::setLocationMemoryLimit;
     using MetadataCache::updateAttr;
 
 private:
     struct LRUData {
         std::size_t openCount = 0;
         bool deleted = false;
-        folly::Optional<std::list<folly::fbstring>::iterator> lruIt;
+        // Whether the entry was in the protected queue before it was opened
+        bool protectedEntry = false;
+        std::size_t footprint = 0;
     };
 
     void pinEntry(const folly::fbstring &uuid);
@@ -241,15 +274,26 @@ private:
 
     void prune();
 
+    void refreshFootprint(const folly::fbstring &uuid);
+
     void handleMarkDeleted(const folly::fbstring &uuid);
 
     void handleRename(
         const folly::fbstring &oldUuid, const folly::fbstring &newUuid);
 
     const std::size_t m_targetSize;
+    const std::size_t m_memoryLimit;
+    std::size_t m_footprint = 0;
+
+    using LRUDataMap = boost::unordered_map<util::Uuid, LRUData,
+        util::Uuid::Hash, util::Uuid::Equal>;
+
+    LRUDataMap::iterator findLRUData(const folly::fbstring &uuid);
 
-    std::list<folly::fbstring> m_lruList;
-    std::unordered_map<folly::fbstring, LRUData> m_lruData;
+    // Records are keyed by interned uuids, shared with the inode cache and
+    // with the eviction policy, and are looked up by plain strings
+    EvictionPolicy<util::Uuid> m_evictionPolicy;
+    LRUDataMap m_lruData;
 
     std::function<void(const folly::fbstring &)> m_onAdd = [](auto &) {};
     std::function<void(const folly::fbstring &)> m_onOpen = [](auto &) {};
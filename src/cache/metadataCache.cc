@@ -24,7 +24,10 @@
 #include <folly/FBVector.h>
 #include <folly/Range.h>
 
+#include <algorithm>
+#include <cassert>
 #include <chrono>
+#include <system_error>
 
 using namespace std::literals;
 
@@ -32,6 +35,13 @@ namespace one {
 namespace client {
 namespace cache {
 
+// Memory used by a shared pointer control block allocated with the object
+constexpr std::size_t METADATA_CACHE_CONTROL_BLOCK_SIZE = 2 * sizeof(long);
+
+// Memory used per element by each hashed index of the cache - node links and
+// a bucket pointer
+constexpr std::size_t METADATA_CACHE_INDEX_OVERHEAD = 3 * sizeof(void *);
+
 MetadataCache::MetadataCache(communication::Communicator &communicator,
     const std::chrono::seconds providerTimeout)
     : m_communicator{communicator}
@@ -61,6 +71,7 @@ FileAttrPtr MetadataCache::getAttr(
     if (it != index.end() && !it->deleted) {
         LOG_DBG(2) << "Found metadata attr for file " << name
                    << " in directory " << parentUuid;
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.metadatacache.hit");
         return it->attr;
     }
 
@@ -71,10 +82,26 @@ FileAttrPtr MetadataCache::getAttr(
         index.modify(it, [&](Metadata &m) { m.attr->setParentUuid(""); });
     }
 
+    if (m_readdirCache && m_readdirCache->isKnownMissing(parentUuid, name)) {
+        LOG_DBG(2) << "File " << name << " is known not to exist in directory "
+                   << parentUuid;
+        throw std::system_error{
+            std::make_error_code(std::errc::no_such_file_or_directory)};
+    }
+
     LOG_DBG(2) << "Metadata attr for file " << name << " in directory "
                << parentUuid << " not found in cache - retrieving from server";
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.metadatacache.miss");
 
-    auto fetchedIt = fetchAttr(messages::fuse::GetChildAttr{parentUuid, name});
+    Map::iterator fetchedIt;
+    try {
+        fetchedIt = fetchAttr(messages::fuse::GetChildAttr{parentUuid, name});
+    }
+    catch (const std::system_error &e) {
+        if (e.code().value() == ENOENT && m_readdirCache)
+            m_readdirCache->markMissing(parentUuid, name);
+        throw;
+    }
 
     LOG_DBG(2) << "Got metadata attr for file " << name << " in directory "
                << parentUuid << " from server";
@@ -82,6 +109,17 @@ FileAttrPtr MetadataCache::getAttr(
     return fetchedIt->attr;
 }
 
+bool MetadataCache::isCached(
+    const folly::fbstring &parentUuid, const folly::fbstring &name) const
+{
+    auto &index = boost::multi_index::get<ByParent>(m_cache);
+    auto it = index.find(std::make_tuple(parentUuid, name));
+    if (it != index.end() && !it->deleted)
+        return true;
+
+    return m_readdirCache && m_readdirCache->isKnownMissing(parentUuid, name);
+}
+
 void MetadataCache::putAttr(std::shared_ptr<FileAttr> attr)
 {
     LOG_FCALL() << LOG_FARG(attr->toString());
@@ -91,6 +129,8 @@ void MetadataCache::putAttr(std::shared_ptr<FileAttr> attr)
         m_cache.modify(result.first, [&](Metadata &m) { m.attr = attr; });
     else
         ONE_METRIC_COUNTER_INC("comp.oneclient.mod.metadatacache.size");
+
+    markPresent(*attr);
 }
 
 MetadataCache::Map::iterator MetadataCache::getAttrIt(
@@ -100,11 +140,13 @@ MetadataCache::Map::iterator MetadataCache::getAttrIt(
     auto it = index.find(uuid);
     if (it != index.end()) {
         LOG_DBG(2) << "Metadata attr for file " << uuid << " found in cache";
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.metadatacache.hit");
         return it;
     }
 
     LOG_DBG(2) << "Metadata attributes for " << uuid
                << " not found in cache - fetching from server";
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.metadatacache.miss");
 
     auto res = fetchAttr(messages::fuse::GetFileAttr{uuid});
 
@@ -127,6 +169,7 @@ void MetadataCache::addBlock(const folly::fbstring &uuid,
     assert(it->location);
 
     it->location->putBlock(newBlock);
+    boundLocation(it, range.lower());
 
     LOG_DBG(2) << "Updated file " << uuid
                << " location range with new block: " << range;
@@ -154,16 +197,86 @@ MetadataCache::Map::iterator MetadataCache::fetchAttr(ReqMsg &&msg)
         throw std::errc::protocol_error; // NOLINT
     }
 
-    auto sharedAttr = std::make_shared<FileAttr>(std::move(attr));
-    auto result = m_cache.emplace(sharedAttr);
+    return cacheFetchedAttr(std::make_shared<FileAttr>(std::move(attr)));
+}
+
+std::vector<FileAttrPtr> MetadataCache::fetchAttrs(
+    const std::vector<folly::fbstring> &uuids, const std::size_t batchSize)
+{
+    LOG_FCALL() << LOG_FARG(uuids.size()) << LOG_FARG(batchSize);
+
+    assert(batchSize > 0);
+
+    std::vector<FileAttrPtr> result;
+    result.reserve(uuids.size());
+
+    for (std::size_t batchStart = 0; batchStart < uuids.size();
+         batchStart += batchSize) {
+        const auto batchEnd = std::min(uuids.size(), batchStart + batchSize);
+
+        LOG_DBG(2) << "Fetching attributes of " << batchEnd - batchStart
+                   << " files for metadata cache";
+
+        // Each request times out on its own, so that a single slow or lost
+        // response does not fail the entire batch
+        std::vector<folly::Future<FileAttr>> futures;
+        futures.reserve(batchEnd - batchStart);
+        for (auto i = batchStart; i < batchEnd; ++i)
+            futures.emplace_back(
+                m_communicator
+                    .communicate<FileAttr>(
+                        messages::fuse::GetFileAttr{uuids[i]})
+                    .onTimeout(m_providerTimeout, [] {
+                        return folly::makeFuture<FileAttr>(std::system_error{
+                            std::make_error_code(std::errc::timed_out)});
+                    }));
+
+        auto responses = folly::collectAll(futures).get();
+
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.metadatacache.bulkfetch");
+
+        for (auto &response : responses) {
+            if (!response.hasValue()) {
+                LOG_DBG(2) << "Failed to fetch attributes in bulk: "
+                           << response.exception().what();
+                continue;
+            }
+
+            if (!response.value().size()) {
+                LOG(ERROR) << "Received invalid message from server when "
+                              "fetching attributes in bulk.";
+                continue;
+            }
+
+            auto it = cacheFetchedAttr(
+                std::make_shared<FileAttr>(std::move(response.value())));
+            result.emplace_back(it->attr);
+        }
+    }
+
+    return result;
+}
+
+MetadataCache::Map::iterator MetadataCache::cacheFetchedAttr(
+    std::shared_ptr<FileAttr> attr)
+{
+    auto result = m_cache.emplace(attr);
     if (!result.second)
-        m_cache.modify(result.first, [&](Metadata &m) { m.attr = sharedAttr; });
+        m_cache.modify(result.first, [&](Metadata &m) { m.attr = attr; });
     else
         ONE_METRIC_COUNTER_INC("comp.oneclient.mod.metadatacache.size");
 
+    markPresent(*attr);
+
     return result.first;
 }
 
+void MetadataCache::markPresent(const FileAttr &attr)
+{
+    if (m_readdirCache && attr.parentUuid())
+        m_readdirCache->markPresent(*attr.parentUuid(), attr.name());
+}
+
 std::shared_ptr<FileLocation> MetadataCache::getLocation(
     const folly::fbstring &uuid, bool forceUpdate)
 {
@@ -215,6 +328,62 @@ std::shared_ptr<FileLocation> MetadataCache::fetchFileLocation(
     return sharedLocation;
 }
 
+void MetadataCache::boundLocation(
+    const Map::iterator &it, const folly::Optional<off_t> offset)
+{
+    if (m_locationMemoryLimit == 0 || !it->location)
+        return;
+
+    auto &location = *it->location;
+    const bool overLimit =
+        location.blocks().footprint() > m_locationMemoryLimit;
+
+    // Accessed windows are tracked only for locations which have to be
+    // bounded, and only when the access moves to another window
+    if (offset && (overLimit || location.isWindowed())) {
+        const auto window = *offset - *offset % FILE_LOCATION_WINDOW_SIZE;
+        const auto &accessedWindows = it->locationWindows;
+        if (accessedWindows.empty() || accessedWindows.back() != window) {
+            m_cache.modify(it, [&](Metadata &m) {
+                auto &windows = m.locationWindows;
+                windows.erase(
+                    std::remove(windows.begin(), windows.end(), window),
+                    windows.end());
+                windows.push_back(window);
+                if (windows.size() > FILE_LOCATION_MAX_WINDOWS)
+                    windows.erase(windows.begin());
+            });
+        }
+    }
+
+    if (!overLimit)
+        return;
+
+    // Retain blocks around the recently accessed offsets, dropping the least
+    // recently accessed ranges until the location fits in the limit
+    auto windows = it->locationWindows;
+    while (true) {
+        boost::icl::interval_set<off_t> ranges;
+        for (const auto window : windows)
+            ranges += boost::icl::discrete_interval<off_t>::right_open(
+                window, window + FILE_LOCATION_WINDOW_SIZE);
+
+        location.retainRanges(ranges);
+
+        if (location.blocks().footprint() <= m_locationMemoryLimit ||
+            windows.size() <= 1)
+            break;
+
+        windows.erase(windows.begin());
+    }
+
+    LOG_DBG(2) << "Bounded file location of " << it->attr->uuid() << " to "
+               << location.blocksCount() << " blocks";
+
+    m_cache.modify(
+        it, [&](Metadata &m) { m.locationWindows = std::move(windows); });
+}
+
 folly::Optional<
     std::pair<boost::icl::discrete_interval<off_t>, messages::fuse::FileBlock>>
 MetadataCache::getBlock(const folly::fbstring &uuid, const off_t offset)
@@ -223,12 +392,21 @@ MetadataCache::getBlock(const folly::fbstring &uuid, const off_t offset)
 
     auto it = getAttrIt(uuid);
     auto location = getLocationPtr(it);
-    auto availableBlockIt =
-        location->blocks().find(boost::icl::discrete_interval<off_t>(offset));
+    boundLocation(it, offset);
+
+    // Blocks outside of the ranges held by a windowed location are reported
+    // as missing, so that the range is synchronized and updated on demand
+    if (!location->isKnown(offset)) {
+        LOG_DBG(2) << "Blocks around offset " << offset << " of file " << uuid
+                   << " not held by windowed file location";
+        return {};
+    }
+
+    auto availableBlockIt = location->blocks().find(offset);
 
     if (availableBlockIt != location->blocks().end())
-        return std::make_pair(
-            availableBlockIt->first, availableBlockIt->second);
+        return std::make_pair(availableBlockIt->first,
+            messages::fuse::FileBlock{availableBlockIt->second});
 
     return {};
 }
@@ -268,6 +446,33 @@ void MetadataCache::erase(folly::fbstring uuid)
         "comp.oneclient.mod.metadatacache.size", index.size());
 }
 
+std::size_t MetadataCache::entryFootprint(const folly::fbstring &uuid) const
+{
+    const auto &index = boost::multi_index::get<ByUuid>(m_cache);
+    auto it = index.find(uuid);
+    if (it == index.end())
+        return 0;
+
+    const auto &attr = *it->attr;
+    std::size_t result = sizeof(Metadata) + 2 * METADATA_CACHE_INDEX_OVERHEAD +
+        sizeof(FileAttr) + METADATA_CACHE_CONTROL_BLOCK_SIZE +
+        heapFootprint(attr.uuid()) + heapFootprint(attr.name()) +
+        it->locationWindows.capacity() * sizeof(off_t);
+
+    if (attr.parentUuid())
+        result += heapFootprint(*attr.parentUuid());
+
+    if (it->location) {
+        const auto &location = *it->location;
+        result += sizeof(FileLocation) + METADATA_CACHE_CONTROL_BLOCK_SIZE +
+            heapFootprint(location.uuid()) + heapFootprint(location.spaceId()) +
+            heapFootprint(location.storageId()) +
+            heapFootprint(location.fileId()) + location.blocks().footprint();
+    }
+
+    return result;
+}
+
 void MetadataCache::truncate(folly::fbstring uuid, const std::size_t newSize)
 {
     LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(newSize);
@@ -478,10 +683,18 @@ bool MetadataCache::updateLocation(
         return false;
     }
 
+    if (locationUpdate.version() < it->location->version()) {
+        LOG(INFO) << "File location update older than current ("
+                  << locationUpdate.version() << " < "
+                  << it->location->version() << "). Aborting update.";
+        return false;
+    }
+
     it->location->version(locationUpdate.version());
     it->location->storageId(locationUpdate.storageId());
     it->location->fileId(locationUpdate.fileId());
     it->location->updateInRange(start, end, locationUpdate);
+    boundLocation(it);
 
     LOG_DBG(2) << "Updated file location for file " << locationUpdate.uuid()
                << " in range [" << start << ", " << end << ")";
@@ -512,6 +725,7 @@ bool MetadataCache::updateLocation(const FileLocation &newLocation)
     it->location->storageId(newLocation.storageId());
     it->location->fileId(newLocation.fileId());
     it->location->update(newLocation.blocks());
+    boundLocation(it);
 
     LOG_DBG(2) << "Updated file location for file " << newLocation.uuid();
 
@@ -38,8 +38,29 @@ class UpdateTimes;
 namespace client {
 namespace cache {
 
+// Number of files, whose attributes are requested at once by bulk fetches
+constexpr std::size_t DEFAULT_BULK_FETCH_SIZE = 100;
+
+// Size of file ranges, around recently accessed offsets, whose blocks are
+// retained by file locations exceeding the location memory limit
+constexpr off_t FILE_LOCATION_WINDOW_SIZE = 64 * 1024 * 1024;
+
+// Maximum number of recently accessed ranges retained per file location
+constexpr std::size_t FILE_LOCATION_MAX_WINDOWS = 16;
+
 class ReaddirCache;
 
+/**
+ * @return Heap memory in bytes owned by a string, 0 for short strings stored
+ * inline.
+ * @param str The string.
+ */
+template <typename String> std::size_t heapFootprint(const String &str)
+{
+    static const auto inlineCapacity = String{}.capacity();
+    return str.capacity() > inlineCapacity ? str.capacity() + 1 : 0;
+}
+
 /**
  * @c MetadataCache is responsible for retrieving and caching file attributes
  * and locations.
@@ -55,6 +76,18 @@ public:
      */
     void setReaddirCache(std::shared_ptr<ReaddirCache> readdirCache);
 
+    /**
+     * Sets the memory limit of a single cached file location.
+     * Locations exceeding the limit retain only blocks around recently
+     * accessed offsets, while blocks in other ranges are fetched again by
+     * synchronizing the range on access.
+     * @param limit Memory limit in bytes, 0 disables the limit.
+     */
+    void setLocationMemoryLimit(const std::size_t limit)
+    {
+        m_locationMemoryLimit = limit;
+    }
+
     /**
      * Retrieves file attributes by uuid.
      * @param uuid Uuid of the file.
@@ -71,6 +104,30 @@ public:
     FileAttrPtr getAttr(
         const folly::fbstring &parentUuid, const folly::fbstring &name);
 
+    /**
+     * Fetches attributes of multiple files from the provider and puts them
+     * in the cache, replacing cached attributes.
+     * Requests for a batch of files are sent at once and their responses
+     * are put in the cache together, once the whole batch is answered.
+     * Files, whose attributes cannot be fetched (e.g. because they were
+     * removed or their request timed out), are skipped.
+     * @param uuids Uuids of the files.
+     * @param batchSize Maximum number of requests in flight.
+     * @returns Fetched attributes.
+     */
+    std::vector<FileAttrPtr> fetchAttrs(
+        const std::vector<folly::fbstring> &uuids,
+        const std::size_t batchSize = DEFAULT_BULK_FETCH_SIZE);
+
+    /**
+     * Checks whether a lookup of a file by parent's uuid and name can be
+     * answered without contacting the provider.
+     * @param parentUuid Uuid of the parent directory.
+     * @param name Name of the file.
+     */
+    bool isCached(
+        const folly::fbstring &parentUuid, const folly::fbstring &name) const;
+
     /**
      * Inserts an externally fetched file attributes into the cache.
      * @param attr The file attributes to put in the cache.
@@ -146,6 +203,13 @@ public:
      */
     void erase(folly::fbstring uuid);
 
+    /**
+     * Estimates memory used by file's metadata in the cache.
+     * @param uuid Uuid of the file.
+     * @returns Estimated size of the entry in bytes, 0 if file is not cached.
+     */
+    std::size_t entryFootprint(const folly::fbstring &uuid) const;
+
     /**
      * Truncates blocks in cached file locations and modifies attributes to set
      * the new size.
@@ -238,6 +302,7 @@ private:
         Metadata(std::shared_ptr<FileAttr>);
         std::shared_ptr<FileAttr> attr;
         std::shared_ptr<FileLocation> location;
+        std::vector<off_t> locationWindows;
         bool deleted = false;
     };
 
@@ -275,14 +340,21 @@ private:
 
     template <typename ReqMsg> Map::iterator fetchAttr(ReqMsg &&msg);
 
+    Map::iterator cacheFetchedAttr(std::shared_ptr<FileAttr> attr);
+
     std::shared_ptr<FileLocation> getLocationPtr(
         const Map::iterator &it, bool forceUpdate = false);
 
     std::shared_ptr<FileLocation> fetchFileLocation(
         const folly::fbstring &uuid);
 
+    void boundLocation(
+        const Map::iterator &it, const folly::Optional<off_t> offset = {});
+
     void markDeletedIt(const Map::iterator &it);
 
+    void markPresent(const FileAttr &attr);
+
     communication::Communicator &m_communicator;
 
     Map m_cache;
@@ -294,6 +366,8 @@ private:
     std::shared_ptr<ReaddirCache> m_readdirCache;
 
     const std::chrono::seconds m_providerTimeout;
+
+    std::size_t m_locationMemoryLimit = 0;
 };
 
 } // namespace cache
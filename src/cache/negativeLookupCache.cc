@@ -0,0 +1,81 @@
+/**
+ * @file negativeLookupCache.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "negativeLookupCache.h"
+
+#include "logging.h"
+
+namespace one {
+namespace client {
+namespace cache {
+
+NegativeLookupCache::NegativeLookupCache(const std::size_t capacity,
+    const std::chrono::milliseconds validityPeriod)
+    : m_capacity{capacity}
+    , m_validityPeriod{validityPeriod}
+{
+}
+
+bool NegativeLookupCache::contains(
+    const folly::fbstring &parentUuid, const folly::fbstring &name)
+{
+    auto it = m_entries.find(Key{parentUuid, name});
+    if (it == m_entries.end())
+        return false;
+
+    if (it->second.expiresAt <= std::chrono::steady_clock::now()) {
+        erase(it);
+        return false;
+    }
+
+    return true;
+}
+
+void NegativeLookupCache::add(
+    const folly::fbstring &parentUuid, const folly::fbstring &name)
+{
+    LOG_FCALL() << LOG_FARG(parentUuid) << LOG_FARG(name);
+
+    if (m_capacity == 0)
+        return;
+
+    remove(parentUuid, name);
+
+    while (m_entries.size() >= m_capacity)
+        erase(m_entries.find(m_lruList.front()));
+
+    Key key{parentUuid, name};
+    auto lruIt = m_lruList.emplace(m_lruList.end(), key);
+    m_entries.emplace(std::move(key),
+        Entry{std::chrono::steady_clock::now() + m_validityPeriod, lruIt});
+}
+
+void NegativeLookupCache::remove(
+    const folly::fbstring &parentUuid, const folly::fbstring &name)
+{
+    auto it = m_entries.find(Key{parentUuid, name});
+    if (it != m_entries.end())
+        erase(it);
+}
+
+void NegativeLookupCache::invalidate(const folly::fbstring &parentUuid)
+{
+    auto it = m_entries.lower_bound(Key{parentUuid, ""});
+    while (it != m_entries.end() && it->first.first == parentUuid)
+        it = erase(it);
+}
+
+std::map<NegativeLookupCache::Key, NegativeLookupCache::Entry>::iterator
+NegativeLookupCache::erase(std::map<Key, Entry>::iterator it)
+{
+    m_lruList.erase(it->second.lruIt);
+    return m_entries.erase(it);
+}
+
+} // namespace cache
+} // namespace client
+} // namespace one
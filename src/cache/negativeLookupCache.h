@@ -0,0 +1,91 @@
+/**
+ * @file negativeLookupCache.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <folly/FBString.h>
+
+#include <chrono>
+#include <list>
+#include <map>
+#include <utility>
+
+namespace one {
+namespace client {
+namespace cache {
+
+/**
+ * @c NegativeLookupCache remembers names, which were recently looked up in a
+ * directory and did not exist, so that repeated lookups of such names can be
+ * answered without contacting the provider.
+ * Entries expire after a validity period, as files created by other clients
+ * are not announced to Oneclient, and the number of entries is bounded with
+ * least recently added entries evicted first.
+ * The cache is not thread safe.
+ */
+class NegativeLookupCache {
+public:
+    /**
+     * Constructor.
+     * @param capacity Maximum number of entries, 0 disables the cache.
+     * @param validityPeriod Period after which an entry expires.
+     */
+    NegativeLookupCache(const std::size_t capacity,
+        const std::chrono::milliseconds validityPeriod);
+
+    /**
+     * Checks whether a name is known not to exist in a directory.
+     * @param parentUuid Uuid of the directory.
+     * @param name Name of the file.
+     */
+    bool contains(
+        const folly::fbstring &parentUuid, const folly::fbstring &name);
+
+    /**
+     * Records that a name does not exist in a directory.
+     * @param parentUuid Uuid of the directory.
+     * @param name Name of the file.
+     */
+    void add(const folly::fbstring &parentUuid, const folly::fbstring &name);
+
+    /**
+     * Removes an entry for a name, which now exists in a directory.
+     * @param parentUuid Uuid of the directory.
+     * @param name Name of the file.
+     */
+    void remove(const folly::fbstring &parentUuid, const folly::fbstring &name);
+
+    /**
+     * Removes all entries of a directory.
+     * @param parentUuid Uuid of the directory.
+     */
+    void invalidate(const folly::fbstring &parentUuid);
+
+    /**
+     * @return Number of entries in the cache.
+     */
+    std::size_t size() const { return m_entries.size(); }
+
+private:
+    using Key = std::pair<folly::fbstring, folly::fbstring>;
+
+    struct Entry {
+        std::chrono::steady_clock::time_point expiresAt;
+        std::list<Key>::iterator lruIt;
+    };
+
+    std::map<Key, Entry>::iterator erase(std::map<Key, Entry>::iterator it);
+
+    const std::size_t m_capacity;
+    const std::chrono::milliseconds m_validityPeriod;
+    std::list<Key> m_lruList;
+    std::map<Key, Entry> m_entries;
+};
+
+} // namespace cache
+} // namespace client
+} // namespace one
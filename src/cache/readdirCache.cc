@@ -10,6 +10,7 @@
 
 #include "communication/communicator.h"
 #include "logging.h"
+#include "monitoring/monitoring.h"
 #include "options/options.h"
 
 #include "messages/fuse/fileChildrenAttrs.h"
@@ -68,6 +69,11 @@ const std::list<folly::fbstring> &DirCacheEntry::dirEntries() const
     return m_dirEntries;
 }
 
+bool DirCacheEntry::contains(const folly::fbstring &name) const
+{
+    return m_dirEntryNames.count(name) > 0;
+}
+
 void DirCacheEntry::invalidate() { m_invalid = true; }
 
 bool DirCacheEntry::isValid(bool sinceLastAccess)
@@ -107,6 +113,8 @@ void DirCacheEntry::unique()
 {
     m_dirEntries.sort();
     m_dirEntries.unique();
+    m_dirEntryNames.clear();
+    m_dirEntryNames.insert(m_dirEntries.cbegin(), m_dirEntries.cend());
 }
 
 ReaddirCache::ReaddirCache(LRUMetadataCache &metadataCache,
@@ -116,6 +124,11 @@ ReaddirCache::ReaddirCache(LRUMetadataCache &metadataCache,
     , m_context{std::move(context)}
     , m_providerTimeout(m_context.lock()->options()->getProviderTimeout())
     , m_prefetchSize(m_context.lock()->options()->getReaddirPrefetchSize())
+    , m_negativeLookupCache{
+          m_context.lock()->options()->getNegativeLookupCacheSize(),
+          m_context.lock()->options()->getNegativeLookupCacheTTL()}
+    , m_treeWalkPrefetch{
+          m_context.lock()->options()->isReaddirTreeWalkPrefetchEnabled()}
     , m_runInFiber{std::move(runInFiber)}
 {
 }
@@ -237,6 +250,9 @@ folly::fbvector<folly::fbstring> ReaddirCache::readdir(
         if (uuidIt == m_cache.end()) {
             fetch(uuid);
         }
+
+        if (off == 0)
+            noteDirectoryListing(uuid);
     }
 
     auto dirEntriesFuture = (*m_cache.find(uuid)).second;
@@ -271,18 +287,157 @@ folly::fbvector<folly::fbstring> ReaddirCache::readdir(
     return acc;
 }
 
+void ReaddirCache::noteDirectoryLookup(
+    const folly::fbstring &parentUuid, const folly::fbstring &uuid)
+{
+    if (!m_treeWalkPrefetch)
+        return;
+
+    LOG_FCALL() << LOG_FARG(parentUuid) << LOG_FARG(uuid);
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    const auto now = std::chrono::steady_clock::now();
+
+    if (m_recentDirLookups.find(uuid) == m_recentDirLookups.end()) {
+        m_recentDirLookupsOrder.emplace_back(uuid);
+        if (m_recentDirLookupsOrder.size() >
+            READDIR_CACHE_TREE_WALK_HISTORY_SIZE) {
+            m_recentDirLookups.erase(m_recentDirLookupsOrder.front());
+            m_recentDirLookupsOrder.pop_front();
+        }
+    }
+    m_recentDirLookups[uuid] = {parentUuid, now};
+
+    // A prefetched listing, which is not read within the validity period,
+    // expires unused, so only recent walks are followed
+    auto walkIt = m_treeWalks.find(parentUuid);
+    if (walkIt == m_treeWalks.end() ||
+        now - walkIt->second >= m_cacheValidityPeriod)
+        return;
+
+    LOG_DBG(2) << "Prefetching entries of directory " << uuid
+               << " on tree walk of " << parentUuid;
+
+    prefetch(uuid);
+}
+
+void ReaddirCache::prefetch(const folly::fbstring &uuid)
+{
+    auto uuidIt = m_cache.find(uuid);
+    if (uuidIt != m_cache.end()) {
+        if (!(*uuidIt).second->isFulfilled() ||
+            (!(*uuidIt).second->getFuture().hasException() &&
+                (*uuidIt).second->getFuture().get()->isValid(false)))
+            return;
+
+        m_cache.erase(uuidIt);
+    }
+
+    if (m_treeWalkPrefetches >= READDIR_CACHE_MAX_TREE_WALK_PREFETCHES) {
+        LOG_DBG(2) << "Skipping prefetch of directory " << uuid
+                   << " - too many prefetches in progress";
+        ONE_METRIC_COUNTER_INC(
+            "comp.oneclient.mod.readdircache.treewalk.skipped");
+        return;
+    }
+
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.readdircache.treewalk");
+
+    ++m_treeWalkPrefetches;
+    fetch(uuid);
+
+    m_cache.at(uuid)->getFuture().ensure(
+        [ self = shared_from_this() ] { --self->m_treeWalkPrefetches; });
+}
+
+void ReaddirCache::noteDirectoryListing(const folly::fbstring &uuid)
+{
+    if (!m_treeWalkPrefetch)
+        return;
+
+    auto lookupIt = m_recentDirLookups.find(uuid);
+    if (lookupIt == m_recentDirLookups.end())
+        return;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - lookupIt->second.second >= m_cacheValidityPeriod)
+        return;
+
+    if (m_treeWalks.size() >= READDIR_CACHE_TREE_WALK_HISTORY_SIZE) {
+        for (auto it = m_treeWalks.begin(); it != m_treeWalks.end();) {
+            if (now - it->second >= m_cacheValidityPeriod)
+                it = m_treeWalks.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    if (m_treeWalks.size() < READDIR_CACHE_TREE_WALK_HISTORY_SIZE)
+        m_treeWalks[lookupIt->second.first] = now;
+}
+
 void ReaddirCache::invalidate(const folly::fbstring &uuid)
 {
     LOG_FCALL() << LOG_FARG(uuid);
 
     std::lock_guard<std::mutex> lock(m_cacheMutex);
 
+    m_negativeLookupCache.invalidate(uuid);
+
     auto it = m_cache.find(uuid);
     if (it != m_cache.cend() && (*it).second->isFulfilled()) {
         (*it).second->getFuture().get()->invalidate();
     }
 }
 
+bool ReaddirCache::isKnownMissing(
+    const folly::fbstring &parentUuid, const folly::fbstring &name)
+{
+    LOG_FCALL() << LOG_FARG(parentUuid) << LOG_FARG(name);
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    if (m_negativeLookupCache.contains(parentUuid, name)) {
+        ONE_METRIC_COUNTER_INC(
+            "comp.oneclient.mod.readdircache.negative.cached");
+        return true;
+    }
+
+    // A listing which is still being fetched, failed or is no longer valid
+    // cannot be used to answer the lookup
+    auto it = m_cache.find(parentUuid);
+    if (it == m_cache.cend() || !(*it).second->isFulfilled())
+        return false;
+
+    auto entryFuture = (*it).second->getFuture();
+    if (entryFuture.hasException())
+        return false;
+
+    auto dirCacheEntry = entryFuture.value();
+    if (!dirCacheEntry->isValid(false) || dirCacheEntry->contains(name))
+        return false;
+
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.readdircache.negative.listing");
+    return true;
+}
+
+void ReaddirCache::markMissing(
+    const folly::fbstring &parentUuid, const folly::fbstring &name)
+{
+    LOG_FCALL() << LOG_FARG(parentUuid) << LOG_FARG(name);
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_negativeLookupCache.add(parentUuid, name);
+}
+
+void ReaddirCache::markPresent(
+    const folly::fbstring &parentUuid, const folly::fbstring &name)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_negativeLookupCache.remove(parentUuid, name);
+}
+
 void ReaddirCache::purge(const folly::fbstring &uuid)
 {
     LOG_FCALL() << LOG_FARG(uuid);
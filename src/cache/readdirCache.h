@@ -11,6 +11,7 @@
 #include "scheduler.h"
 
 #include "cache/lruMetadataCache.h"
+#include "cache/negativeLookupCache.h"
 #include "context.h"
 
 #include <folly/FBString.h>
@@ -20,8 +21,11 @@
 #include <folly/futures/SharedPromise.h>
 #include <fuse/fuse_lowlevel.h>
 
+#include <atomic>
 #include <chrono>
+#include <deque>
 #include <list>
+#include <unordered_set>
 
 namespace one {
 namespace client {
@@ -31,6 +35,10 @@ using namespace std::literals;
 
 constexpr auto READDIR_CACHE_VALIDITY_DURATION = 2000ms;
 
+constexpr std::size_t READDIR_CACHE_TREE_WALK_HISTORY_SIZE = 1024;
+
+constexpr std::size_t READDIR_CACHE_MAX_TREE_WALK_PREFETCHES = 4;
+
 /**
  * DirCacheEntry stores the list of entries fetched from the
  * provider for a specific directory entry.
@@ -55,6 +63,14 @@ public:
      */
     const std::list<folly::fbstring> &dirEntries() const;
 
+    /**
+     * Checks if the directory entries contain a specific name. Valid only
+     * after @c unique() has been called.
+     *
+     * @param name Directory entry name.
+     */
+    bool contains(const folly::fbstring &name) const;
+
     /**
      * Checks if the dir cache entry is still valid. In case off
      * is 0 (i.e. this is a new readdir request compare against
@@ -113,6 +129,11 @@ private:
      */
     std::list<folly::fbstring> m_dirEntries;
 
+    /**
+     * Set of directory entry names, enabling fast membership checks.
+     */
+    std::unordered_set<folly::fbstring> m_dirEntryNames;
+
     /**
      * Validity period of dir cache entries.
      *
@@ -156,10 +177,53 @@ public:
         const off_t off, const std::size_t chunkSize);
 
     /**
-     * Invalidate cache for a specific directory.
+     * Records a lookup of a directory. When directories looked up in the
+     * same parent directory were recently listed right after their lookup,
+     * the parent is assumed to be walked (e.g. by find or du) and fetching
+     * entries of the looked up directory is started in the background.
+     *
+     * @param parentUuid Id of the parent directory.
+     * @param uuid Id of the looked up directory.
+     */
+    void noteDirectoryLookup(
+        const folly::fbstring &parentUuid, const folly::fbstring &uuid);
+
+    /**
+     * Invalidate cache for a specific directory, including negative lookup
+     * results of the directory.
      */
     void invalidate(const folly::fbstring &uuid);
 
+    /**
+     * Checks whether a file is known not to exist in a directory, either
+     * from a recent negative lookup result or from a complete and valid
+     * listing of the directory.
+     *
+     * @param parentUuid Directory id.
+     * @param name Name of the file.
+     */
+    bool isKnownMissing(
+        const folly::fbstring &parentUuid, const folly::fbstring &name);
+
+    /**
+     * Records a negative lookup result for a file in a directory.
+     *
+     * @param parentUuid Directory id.
+     * @param name Name of the file.
+     */
+    void markMissing(
+        const folly::fbstring &parentUuid, const folly::fbstring &name);
+
+    /**
+     * Removes a negative lookup result for a file, which now exists in a
+     * directory.
+     *
+     * @param parentUuid Directory id.
+     * @param name Name of the file.
+     */
+    void markPresent(
+        const folly::fbstring &parentUuid, const folly::fbstring &name);
+
     /**
      * Returns true if cache doesn't contain any elements.
      */
@@ -179,6 +243,24 @@ private:
      */
     void fetch(const folly::fbstring &uuid);
 
+    /**
+     * Starts fetching directory entries for directory 'uuid' unless they are
+     * already cached or being fetched, or too many directories are already
+     * prefetched. Must be called with @c m_cacheMutex locked.
+     *
+     * @param uuid Directory id.
+     */
+    void prefetch(const folly::fbstring &uuid);
+
+    /**
+     * Records that directory 'uuid' is listed and marks its parent as walked
+     * when the directory was looked up recently. Must be called with
+     * @c m_cacheMutex locked.
+     *
+     * @param uuid Directory id.
+     */
+    void noteDirectoryListing(const folly::fbstring &uuid);
+
     /**
      * Removes element cache for specific directory.
      */
@@ -240,6 +322,40 @@ private:
     const std::chrono::milliseconds m_cacheValidityPeriod =
         READDIR_CACHE_VALIDITY_DURATION;
 
+    /**
+     * Cache of recent negative lookup results, guarded by @c m_cacheMutex.
+     */
+    NegativeLookupCache m_negativeLookupCache;
+
+    /**
+     * Whether directories should be prefetched on tree walks.
+     */
+    const bool m_treeWalkPrefetch;
+
+    /**
+     * Recently looked up directories with their parents and lookup times,
+     * in order of lookup, guarded by @c m_cacheMutex.
+     */
+    std::unordered_map<folly::fbstring,
+        std::pair<folly::fbstring, std::chrono::steady_clock::time_point>>
+        m_recentDirLookups;
+    std::deque<folly::fbstring> m_recentDirLookupsOrder;
+
+    /**
+     * Directories, whose subdirectories were recently listed right after
+     * their lookup, with time of the last such listing, guarded by
+     * @c m_cacheMutex.
+     */
+    std::unordered_map<folly::fbstring, std::chrono::steady_clock::time_point>
+        m_treeWalks;
+
+    /**
+     * Number of directory prefetches in progress, limited to
+     * @c READDIR_CACHE_MAX_TREE_WALK_PREFETCHES so that walks of large trees
+     * don't flood the scheduler and the provider.
+     */
+    std::atomic<std::size_t> m_treeWalkPrefetches{0};
+
     /**
      * Executor enabling to schedule tasks on fslogic fiber
      */
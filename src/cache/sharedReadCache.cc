@@ -0,0 +1,346 @@
+/**
+ * @file sharedReadCache.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "sharedReadCache.h"
+
+#include "logging.h"
+#include "monitoring/monitoring.h"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace one {
+namespace client {
+namespace cache {
+
+SharedReadCache::SharedReadCache(const std::size_t capacity)
+    : m_capacity{capacity}
+{
+}
+
+folly::Optional<folly::IOBufQueue> SharedReadCache::read(
+    const folly::fbstring &uuid, const std::uint64_t locationVersion,
+    const off_t offset, const std::size_t size)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(locationVersion)
+                << LOG_FARG(offset) << LOG_FARG(size);
+
+    auto fileIt = m_files.find(uuid);
+    if (fileIt == m_files.end()) {
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.sharedreadcache.miss");
+        return {};
+    }
+
+    if (fileIt->second.locationVersion != locationVersion) {
+        LOG_DBG(2) << "Cached data of file " << uuid
+                   << " is outdated - removing from shared read cache";
+        eraseFile(fileIt);
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.sharedreadcache.miss");
+        return {};
+    }
+
+    auto &segments = fileIt->second.segments;
+    auto it = segments.upper_bound(offset);
+    if (it == segments.begin()) {
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.sharedreadcache.miss");
+        return {};
+    }
+    --it;
+
+    // The range may span several adjacent segments, e.g. when it was read
+    // by separate requests or partially overwritten; the returned buffers
+    // share the memory with the cached segments
+    folly::IOBufQueue result{folly::IOBufQueue::cacheChainLength()};
+    std::vector<std::list<Key>::iterator> used;
+    const off_t end = offset + size;
+    off_t position = offset;
+    while (position < end) {
+        if (it == segments.end() || it->first > position ||
+            it->first + static_cast<off_t>(it->second.data->length()) <=
+                position) {
+            ONE_METRIC_COUNTER_INC("comp.oneclient.mod.sharedreadcache.miss");
+            return {};
+        }
+
+        const off_t segmentEnd =
+            it->first + static_cast<off_t>(it->second.data->length());
+        const off_t pieceEnd = std::min(segmentEnd, end);
+
+        auto buf = it->second.data->cloneOne();
+        buf->trimStart(position - it->first);
+        buf->trimEnd(segmentEnd - pieceEnd);
+        result.append(std::move(buf));
+        used.emplace_back(it->second.lruIt);
+
+        position = pieceEnd;
+        ++it;
+    }
+
+    for (auto lruIt : used)
+        m_lruList.splice(m_lruList.end(), m_lruList, lruIt);
+
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.sharedreadcache.hit");
+
+    return result;
+}
+
+void SharedReadCache::put(const folly::fbstring &uuid,
+    const std::uint64_t locationVersion, const off_t offset,
+    const folly::IOBufQueue &data)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(locationVersion)
+                << LOG_FARG(offset) << LOG_FARG(data.chainLength());
+
+    const auto dataSize = data.chainLength();
+    if (!enabled() || data.empty() || dataSize > m_capacity)
+        return;
+
+    auto fileIt = m_files.find(uuid);
+    if (fileIt != m_files.end() &&
+        fileIt->second.locationVersion != locationVersion) {
+        eraseFile(fileIt);
+        fileIt = m_files.end();
+    }
+
+    if (fileIt == m_files.end())
+        fileIt = m_files.emplace(uuid, File{locationVersion, {}}).first;
+
+    auto buf = data.front()->clone();
+    buf->coalesce();
+
+    // Data already cached for any part of the range, e.g. written locally,
+    // takes precedence over data read from storage, which only fills the
+    // gaps between cached segments
+    auto &file = fileIt->second;
+    const off_t end = offset + static_cast<off_t>(dataSize);
+    off_t position = offset;
+    auto it = file.segments.lower_bound(offset);
+    if (it != file.segments.begin()) {
+        auto prev = std::prev(it);
+        position = std::max(position,
+            prev->first + static_cast<off_t>(prev->second.data->length()));
+    }
+
+    while (position < end) {
+        const off_t gapEnd =
+            it == file.segments.end() ? end : std::min(end, it->first);
+
+        if (gapEnd > position) {
+            if (position == offset && gapEnd == end) {
+                addSegment(uuid, file, offset, std::move(buf));
+                break;
+            }
+
+            // Partial segments get their own memory, so that cached size
+            // accounts for all memory held by the cache
+            addSegment(uuid, file, position,
+                folly::IOBuf::copyBuffer(
+                    buf->data() + (position - offset), gapEnd - position));
+        }
+
+        if (it == file.segments.end())
+            break;
+
+        position = std::max(position,
+            it->first + static_cast<off_t>(it->second.data->length()));
+        ++it;
+    }
+
+    evict();
+
+    ONE_METRIC_COUNTER_SET("comp.oneclient.mod.sharedreadcache.size", m_size);
+}
+
+void SharedReadCache::write(const folly::fbstring &uuid, const off_t offset,
+    const folly::IOBufQueue &data)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(offset)
+                << LOG_FARG(data.chainLength());
+
+    // Data read before the write completed could be put in the cache after
+    // this call, even if no data of the file is cached now
+    advanceFills(uuid);
+
+    auto fileIt = m_files.find(uuid);
+    if (fileIt == m_files.end() || data.empty())
+        return;
+
+    const auto dataSize = data.chainLength();
+    punch(uuid, fileIt->second, offset, offset + dataSize);
+
+    if (dataSize <= m_capacity) {
+        auto buf = data.front()->clone();
+        buf->coalesce();
+        addSegment(uuid, fileIt->second, offset, std::move(buf));
+        evict();
+    }
+    else if (fileIt->second.segments.empty()) {
+        m_files.erase(fileIt);
+    }
+
+    ONE_METRIC_COUNTER_SET("comp.oneclient.mod.sharedreadcache.size", m_size);
+}
+
+void SharedReadCache::invalidate(const folly::fbstring &uuid)
+{
+    advanceFills(uuid);
+
+    auto fileIt = m_files.find(uuid);
+    if (fileIt != m_files.end())
+        eraseFile(fileIt);
+}
+
+std::uint64_t SharedReadCache::beginFill(const folly::fbstring &uuid)
+{
+    auto &fill = m_fills[uuid];
+    ++fill.count;
+    return fill.generation;
+}
+
+void SharedReadCache::endFill(const folly::fbstring &uuid)
+{
+    auto it = m_fills.find(uuid);
+    if (it != m_fills.end() && --it->second.count == 0)
+        m_fills.erase(it);
+}
+
+void SharedReadCache::beginRead(
+    const folly::fbstring &uuid, const off_t offset, const std::size_t size)
+{
+    m_pendingReads[uuid].emplace(offset,
+        PendingRead{offset + static_cast<off_t>(size),
+            std::make_shared<folly::SharedPromise<folly::Unit>>()});
+}
+
+void SharedReadCache::endRead(
+    const folly::fbstring &uuid, const off_t offset, const std::size_t size)
+{
+    auto fileIt = m_pendingReads.find(uuid);
+    if (fileIt == m_pendingReads.end())
+        return;
+
+    auto &reads = fileIt->second;
+    const off_t end = offset + static_cast<off_t>(size);
+    auto range = reads.equal_range(offset);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.end == end) {
+            auto done = std::move(it->second.done);
+            reads.erase(it);
+            if (reads.empty())
+                m_pendingReads.erase(fileIt);
+
+            done->setValue();
+            return;
+        }
+    }
+}
+
+folly::Optional<folly::Future<folly::Unit>> SharedReadCache::pendingRead(
+    const folly::fbstring &uuid, const off_t offset, const std::size_t size)
+{
+    auto fileIt = m_pendingReads.find(uuid);
+    if (fileIt == m_pendingReads.end())
+        return {};
+
+    const off_t end = offset + static_cast<off_t>(size);
+    auto &reads = fileIt->second;
+    for (auto it = reads.begin(); it != reads.upper_bound(offset); ++it) {
+        if (it->second.end >= end)
+            return it->second.done->getFuture();
+    }
+
+    return {};
+}
+
+bool SharedReadCache::invalidatedSince(
+    const folly::fbstring &uuid, const std::uint64_t generation) const
+{
+    auto it = m_fills.find(uuid);
+    return it == m_fills.end() || it->second.generation != generation;
+}
+
+void SharedReadCache::eraseFile(
+    std::unordered_map<folly::fbstring, File>::iterator fileIt)
+{
+    auto &segments = fileIt->second.segments;
+    for (auto it = segments.begin(); it != segments.end();)
+        it = eraseSegment(fileIt->second, it);
+
+    m_files.erase(fileIt);
+
+    ONE_METRIC_COUNTER_SET("comp.oneclient.mod.sharedreadcache.size", m_size);
+}
+
+void SharedReadCache::advanceFills(const folly::fbstring &uuid)
+{
+    auto it = m_fills.find(uuid);
+    if (it != m_fills.end())
+        ++it->second.generation;
+}
+
+void SharedReadCache::punch(const folly::fbstring &uuid, File &file,
+    const off_t start, const off_t end)
+{
+    auto it = file.segments.lower_bound(start);
+    if (it != file.segments.begin() &&
+        std::prev(it)->first + std::prev(it)->second.data->length() >
+            static_cast<std::size_t>(start))
+        --it;
+
+    while (it != file.segments.end() && it->first < end) {
+        const auto segmentStart = it->first;
+        auto data = it->second.data->cloneOne();
+        const off_t segmentEnd =
+            segmentStart + static_cast<off_t>(data->length());
+        it = eraseSegment(file, it);
+
+        if (segmentStart < start) {
+            auto head = data->cloneOne();
+            head->trimEnd(segmentEnd - start);
+            addSegment(uuid, file, segmentStart, std::move(head));
+        }
+
+        if (segmentEnd > end) {
+            data->trimStart(end - segmentStart);
+            addSegment(uuid, file, end, std::move(data));
+        }
+    }
+}
+
+void SharedReadCache::addSegment(const folly::fbstring &uuid, File &file,
+    const off_t offset, std::unique_ptr<folly::IOBuf> data)
+{
+    m_size += data->length();
+    auto lruIt = m_lruList.emplace(m_lruList.end(), uuid, offset);
+    file.segments.emplace(offset, Segment{std::move(data), lruIt});
+}
+
+std::map<off_t, SharedReadCache::Segment>::iterator
+SharedReadCache::eraseSegment(File &file, std::map<off_t, Segment>::iterator it)
+{
+    m_size -= it->second.data->length();
+    m_lruList.erase(it->second.lruIt);
+    return file.segments.erase(it);
+}
+
+void SharedReadCache::evict()
+{
+    while (m_size > m_capacity && !m_lruList.empty()) {
+        const auto key = m_lruList.front();
+        auto fileIt = m_files.find(key.first);
+        auto &segments = fileIt->second.segments;
+
+        eraseSegment(fileIt->second, segments.find(key.second));
+        if (segments.empty())
+            m_files.erase(fileIt);
+    }
+}
+
+} // namespace cache
+} // namespace client
+} // namespace one
@@ -0,0 +1,216 @@
+/**
+ * @file sharedReadCache.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <folly/FBString.h>
+#include <folly/Optional.h>
+#include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
+#include <folly/io/IOBuf.h>
+#include <folly/io/IOBufQueue.h>
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace one {
+namespace client {
+namespace cache {
+
+/**
+ * @c SharedReadCache keeps recently read ranges of files in memory, shared by
+ * all file handles opened for the same file, so that concurrent readers of
+ * the same data trigger only a single storage read.
+ * Ranges are stored as non-overlapping reference counted segments, tagged
+ * with the file location version at which they were read; all segments of a
+ * file are dropped as soon as its location version changes. Data written
+ * locally to a file replaces overlapping cached ranges, so that subsequent
+ * reads see the written data. The total size of cached data is bounded and
+ * least recently used segments are evicted first.
+ * Data read from storage while the file is written or invalidated is not put
+ * in the cache - this is detected using generations of cache fills, which are
+ * advanced by @c write and @c invalidate. Ranges being read from storage are
+ * registered, so that concurrent readers of the same range can wait for the
+ * read in progress instead of reading the data again.
+ * The cache is not thread safe and should be accessed only from the fslogic
+ * fiber, just like @c MetadataCache.
+ */
+class SharedReadCache {
+public:
+    /**
+     * Constructor.
+     * @param capacity Maximum total size in bytes of cached data, 0 disables
+     * the cache.
+     */
+    SharedReadCache(const std::size_t capacity);
+
+    /**
+     * @return Whether the cache is enabled.
+     */
+    bool enabled() const { return m_capacity > 0; }
+
+    /**
+     * Reads a range of file data from the cache.
+     * @param uuid Uuid of the file.
+     * @param locationVersion Current version of the file location.
+     * @param offset Offset of the range to read.
+     * @param size Size of the range to read.
+     * @return Requested data, possibly gathered from multiple adjacent
+     * segments, or none, if the whole range is not cached or the cached data
+     * is outdated.
+     */
+    folly::Optional<folly::IOBufQueue> read(const folly::fbstring &uuid,
+        const std::uint64_t locationVersion, const off_t offset,
+        const std::size_t size);
+
+    /**
+     * Puts data read from storage in the cache. Parts of its range, which
+     * are already cached, are left intact and only the remaining gaps are
+     * filled.
+     * @param uuid Uuid of the file.
+     * @param locationVersion Version of the file location at which the data
+     * has been read.
+     * @param offset Offset of the data in the file.
+     * @param data The data.
+     */
+    void put(const folly::fbstring &uuid, const std::uint64_t locationVersion,
+        const off_t offset, const folly::IOBufQueue &data);
+
+    /**
+     * Overlays data written locally over cached ranges of a file, if any
+     * data of the file is cached, and marks cache fills of the file, which
+     * are in progress, as outdated.
+     * @param uuid Uuid of the file.
+     * @param offset Offset of the written data.
+     * @param data The written data.
+     */
+    void write(const folly::fbstring &uuid, const off_t offset,
+        const folly::IOBufQueue &data);
+
+    /**
+     * Removes all data of a file from the cache and marks cache fills of the
+     * file, which are in progress, as outdated.
+     * @param uuid Uuid of the file.
+     */
+    void invalidate(const folly::fbstring &uuid);
+
+    /**
+     * Marks the start of reading file data to be put in the cache. Each call
+     * must be followed by a call to @c endFill.
+     * @param uuid Uuid of the file.
+     * @return Fill generation to be checked with @c invalidatedSince.
+     */
+    std::uint64_t beginFill(const folly::fbstring &uuid);
+
+    /**
+     * Marks the end of reading file data started with @c beginFill.
+     * @param uuid Uuid of the file.
+     */
+    void endFill(const folly::fbstring &uuid);
+
+    /**
+     * Registers a read of a range of file data from storage, which will be
+     * put in the cache. Each call must be followed by a call to @c endRead
+     * with the same range.
+     * @param uuid Uuid of the file.
+     * @param offset Offset of the range.
+     * @param size Size of the range.
+     */
+    void beginRead(const folly::fbstring &uuid, const off_t offset,
+        const std::size_t size);
+
+    /**
+     * Marks a read registered with @c beginRead as finished and wakes up
+     * readers waiting for it.
+     * @param uuid Uuid of the file.
+     * @param offset Offset of the range.
+     * @param size Size of the range.
+     */
+    void endRead(const folly::fbstring &uuid, const off_t offset,
+        const std::size_t size);
+
+    /**
+     * @param uuid Uuid of the file.
+     * @param offset Offset of the range.
+     * @param size Size of the range.
+     * @return Future fulfilled when a read in progress, which covers the
+     * whole range, is finished, or none if there is no such read.
+     */
+    folly::Optional<folly::Future<folly::Unit>> pendingRead(
+        const folly::fbstring &uuid, const off_t offset,
+        const std::size_t size);
+
+    /**
+     * @param uuid Uuid of the file.
+     * @param generation Fill generation returned by @c beginFill.
+     * @return Whether the file has been written or invalidated since the fill
+     * started.
+     */
+    bool invalidatedSince(
+        const folly::fbstring &uuid, const std::uint64_t generation) const;
+
+    /**
+     * @return Total size in bytes of cached data.
+     */
+    std::size_t size() const { return m_size; }
+
+private:
+    using Key = std::pair<folly::fbstring, off_t>;
+
+    struct Segment {
+        std::unique_ptr<folly::IOBuf> data;
+        std::list<Key>::iterator lruIt;
+    };
+
+    struct File {
+        std::uint64_t locationVersion;
+        std::map<off_t, Segment> segments;
+    };
+
+    struct Fill {
+        std::uint64_t generation;
+        std::size_t count;
+    };
+
+    struct PendingRead {
+        off_t end;
+        std::shared_ptr<folly::SharedPromise<folly::Unit>> done;
+    };
+
+    void eraseFile(std::unordered_map<folly::fbstring, File>::iterator fileIt);
+
+    void advanceFills(const folly::fbstring &uuid);
+
+    void punch(const folly::fbstring &uuid, File &file, const off_t start,
+        const off_t end);
+
+    void addSegment(const folly::fbstring &uuid, File &file, const off_t offset,
+        std::unique_ptr<folly::IOBuf> data);
+
+    std::map<off_t, Segment>::iterator eraseSegment(
+        File &file, std::map<off_t, Segment>::iterator it);
+
+    void evict();
+
+    const std::size_t m_capacity;
+    std::size_t m_size = 0;
+    std::list<Key> m_lruList;
+    std::unordered_map<folly::fbstring, File> m_files;
+    std::unordered_map<folly::fbstring, Fill> m_fills;
+    std::unordered_map<folly::fbstring, std::multimap<off_t, PendingRead>>
+        m_pendingReads;
+};
+
+} // namespace cache
+} // namespace client
+} // namespace one
@@ -0,0 +1,169 @@
+/**
+ * @file smallFileCache.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "smallFileCache.h"
+
+#include "logging.h"
+#include "monitoring/monitoring.h"
+
+namespace one {
+namespace client {
+namespace cache {
+
+SmallFileCache::SmallFileCache(
+    const std::size_t capacity, const std::size_t maxFileSize)
+    : m_capacity{capacity}
+    , m_maxFileSize{maxFileSize}
+{
+}
+
+bool SmallFileCache::accepts(const off_t fileSize) const
+{
+    if (fileSize <= 0)
+        return false;
+
+    const auto size = static_cast<std::size_t>(fileSize);
+    return size <= m_maxFileSize && size <= m_capacity;
+}
+
+folly::Optional<folly::IOBufQueue> SmallFileCache::read(
+    const folly::fbstring &uuid, const std::uint64_t locationVersion,
+    const std::chrono::system_clock::time_point mtime, const off_t offset,
+    const std::size_t size)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(locationVersion)
+                << LOG_FARG(offset) << LOG_FARG(size);
+
+    auto it = m_entries.find(uuid);
+    if (it == m_entries.end()) {
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.smallfilecache.miss");
+        return {};
+    }
+
+    if (it->second.locationVersion != locationVersion ||
+        it->second.mtime != mtime) {
+        LOG_DBG(2) << "Cached content of file " << uuid
+                   << " is outdated - removing from small file cache";
+        erase(it);
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.smallfilecache.miss");
+        return {};
+    }
+
+    m_lruList.splice(m_lruList.end(), m_lruList, it->second.lruIt);
+
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.smallfilecache.hit");
+
+    folly::IOBufQueue result{folly::IOBufQueue::cacheChainLength()};
+
+    const auto contentSize = it->second.content->length();
+    if (offset < 0 || static_cast<std::size_t>(offset) >= contentSize)
+        return result;
+
+    // The returned buffer shares the memory with the cached content
+    auto buf = it->second.content->cloneOne();
+    buf->trimStart(offset);
+    if (buf->length() > size)
+        buf->trimEnd(buf->length() - size);
+
+    result.append(std::move(buf));
+    return result;
+}
+
+void SmallFileCache::put(const folly::fbstring &uuid,
+    const std::uint64_t locationVersion,
+    const std::chrono::system_clock::time_point mtime,
+    std::unique_ptr<folly::IOBuf> content)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(locationVersion);
+
+    auto it = m_entries.find(uuid);
+    if (it != m_entries.end())
+        erase(it);
+
+    if (!content)
+        return;
+
+    content->coalesce();
+    const auto contentSize = content->length();
+    if (!accepts(static_cast<off_t>(contentSize)))
+        return;
+
+    while (m_size + contentSize > m_capacity && !m_lruList.empty())
+        erase(m_entries.find(m_lruList.front()));
+
+    auto lruIt = m_lruList.emplace(m_lruList.end(), uuid);
+    m_entries.emplace(
+        uuid, Entry{locationVersion, mtime, std::move(content), lruIt});
+    m_size += contentSize;
+
+    LOG_DBG(2) << "Cached " << contentSize << " bytes of file " << uuid
+               << " in small file cache";
+
+    ONE_METRIC_COUNTER_SET("comp.oneclient.mod.smallfilecache.size", m_size);
+}
+
+void SmallFileCache::invalidate(const folly::fbstring &uuid)
+{
+    auto it = m_entries.find(uuid);
+    if (it != m_entries.end())
+        erase(it);
+
+    auto fillIt = m_fills.find(uuid);
+    if (fillIt != m_fills.end())
+        ++fillIt->second.generation;
+}
+
+std::uint64_t SmallFileCache::beginFill(const folly::fbstring &uuid)
+{
+    auto &fill = m_fills[uuid];
+    if (fill.count++ == 0)
+        fill.done = std::make_shared<folly::SharedPromise<folly::Unit>>();
+
+    return fill.generation;
+}
+
+void SmallFileCache::endFill(const folly::fbstring &uuid)
+{
+    auto it = m_fills.find(uuid);
+    if (it == m_fills.end() || --it->second.count > 0)
+        return;
+
+    auto done = std::move(it->second.done);
+    m_fills.erase(it);
+    done->setValue();
+}
+
+folly::Optional<folly::Future<folly::Unit>> SmallFileCache::pendingFill(
+    const folly::fbstring &uuid)
+{
+    auto it = m_fills.find(uuid);
+    if (it == m_fills.end())
+        return {};
+
+    return it->second.done->getFuture();
+}
+
+bool SmallFileCache::invalidatedSince(
+    const folly::fbstring &uuid, const std::uint64_t generation) const
+{
+    auto it = m_fills.find(uuid);
+    return it == m_fills.end() || it->second.generation != generation;
+}
+
+void SmallFileCache::erase(
+    std::unordered_map<folly::fbstring, Entry>::iterator it)
+{
+    m_size -= it->second.content->length();
+    m_lruList.erase(it->second.lruIt);
+    m_entries.erase(it);
+
+    ONE_METRIC_COUNTER_SET("comp.oneclient.mod.smallfilecache.size", m_size);
+}
+
+} // namespace cache
+} // namespace client
+} // namespace one
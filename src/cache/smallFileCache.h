@@ -0,0 +1,159 @@
+/**
+ * @file smallFileCache.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <folly/FBString.h>
+#include <folly/Optional.h>
+#include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
+#include <folly/io/IOBuf.h>
+#include <folly/io/IOBufQueue.h>
+
+#include <sys/types.h>
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace one {
+namespace client {
+namespace cache {
+
+/**
+ * @c SmallFileCache keeps entire contents of small, fully replicated files in
+ * memory, so that subsequent reads of such files, from any file handle, do not
+ * require storage helper requests.
+ * Each cached content is tagged with the file location version and the file
+ * modification time at which it was read, and is only served as long as
+ * these match the current file metadata. The total size of cached contents
+ * is bounded and least recently used entries are evicted first.
+ * Since local writes do not change the file metadata until the provider
+ * reports them, contents read while the file is being written are not put in
+ * the cache - this is detected using generations of cache fills, which are
+ * advanced by @c invalidate. Concurrent reads of a file, which is being put in
+ * the cache, wait for the fill in progress instead of reading the file again.
+ * The cache is not thread safe and should be accessed only from the fslogic
+ * fiber, just like @c MetadataCache.
+ */
+class SmallFileCache {
+public:
+    /**
+     * Constructor.
+     * @param capacity Maximum total size in bytes of cached file contents,
+     * 0 disables the cache.
+     * @param maxFileSize Maximum size in bytes of a single file, which can be
+     * cached.
+     */
+    SmallFileCache(const std::size_t capacity, const std::size_t maxFileSize);
+
+    /**
+     * Checks whether the file of specified size qualifies for caching.
+     * @param fileSize Size of the file.
+     */
+    bool accepts(const off_t fileSize) const;
+
+    /**
+     * Reads a range of a cached file content.
+     * @param uuid Uuid of the file.
+     * @param locationVersion Current version of the file location.
+     * @param mtime Current modification time of the file.
+     * @param offset Offset of the range to read.
+     * @param size Size of the range to read.
+     * @return Requested range of the file content or none if the file is not
+     * cached or the cached content is outdated.
+     */
+    folly::Optional<folly::IOBufQueue> read(const folly::fbstring &uuid,
+        const std::uint64_t locationVersion,
+        const std::chrono::system_clock::time_point mtime, const off_t offset,
+        const std::size_t size);
+
+    /**
+     * Puts entire file content in the cache, evicting least recently used
+     * entries if necessary.
+     * @param uuid Uuid of the file.
+     * @param locationVersion Version of the file location at which the content
+     * has been read.
+     * @param mtime Modification time of the file at which the content has been
+     * read.
+     * @param content The file content.
+     */
+    void put(const folly::fbstring &uuid, const std::uint64_t locationVersion,
+        const std::chrono::system_clock::time_point mtime,
+        std::unique_ptr<folly::IOBuf> content);
+
+    /**
+     * Removes file content from the cache and marks cache fills of the file,
+     * which are in progress, as outdated.
+     * @param uuid Uuid of the file.
+     */
+    void invalidate(const folly::fbstring &uuid);
+
+    /**
+     * Marks the start of reading a file content to be put in the cache. Each
+     * call must be followed by a call to @c endFill.
+     * @param uuid Uuid of the file.
+     * @return Fill generation to be checked with @c invalidatedSince.
+     */
+    std::uint64_t beginFill(const folly::fbstring &uuid);
+
+    /**
+     * Marks the end of reading a file content started with @c beginFill.
+     * @param uuid Uuid of the file.
+     */
+    void endFill(const folly::fbstring &uuid);
+
+    /**
+     * @param uuid Uuid of the file.
+     * @return Future fulfilled when the fill of the file in progress is
+     * finished, or none if the file is not being put in the cache.
+     */
+    folly::Optional<folly::Future<folly::Unit>> pendingFill(
+        const folly::fbstring &uuid);
+
+    /**
+     * @param uuid Uuid of the file.
+     * @param generation Fill generation returned by @c beginFill.
+     * @return Whether the file has been invalidated since the fill started.
+     */
+    bool invalidatedSince(
+        const folly::fbstring &uuid, const std::uint64_t generation) const;
+
+    /**
+     * @return Total size in bytes of cached file contents.
+     */
+    std::size_t size() const { return m_size; }
+
+private:
+    struct Entry {
+        std::uint64_t locationVersion;
+        std::chrono::system_clock::time_point mtime;
+        std::unique_ptr<folly::IOBuf> content;
+        std::list<folly::fbstring>::iterator lruIt;
+    };
+
+    struct Fill {
+        std::uint64_t generation;
+        std::size_t count;
+        std::shared_ptr<folly::SharedPromise<folly::Unit>> done;
+    };
+
+    void erase(std::unordered_map<folly::fbstring, Entry>::iterator it);
+
+    const std::size_t m_capacity;
+    const std::size_t m_maxFileSize;
+    std::size_t m_size = 0;
+    std::list<folly::fbstring> m_lruList;
+    std::unordered_map<folly::fbstring, Entry> m_entries;
+    std::unordered_map<folly::fbstring, Fill> m_fills;
+};
+
+} // namespace cache
+} // namespace client
+} // namespace one
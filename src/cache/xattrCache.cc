@@ -0,0 +1,188 @@
+/**
+ * @file xattrCache.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "xattrCache.h"
+
+#include "logging.h"
+
+#include <algorithm>
+
+namespace one {
+namespace client {
+namespace cache {
+
+XAttrCache::XAttrCache(const std::size_t capacity,
+    const std::chrono::milliseconds validityPeriod)
+    : m_capacity{capacity}
+    , m_validityPeriod{validityPeriod}
+{
+}
+
+folly::Optional<folly::fbstring> XAttrCache::getValue(
+    const folly::fbstring &uuid, const folly::fbstring &name)
+{
+    auto value = findValue(uuid, name);
+    if (value == nullptr)
+        return {};
+
+    return value->value;
+}
+
+bool XAttrCache::isKnownMissing(
+    const folly::fbstring &uuid, const folly::fbstring &name)
+{
+    auto value = findValue(uuid, name);
+    return value != nullptr && !value->value;
+}
+
+folly::Optional<folly::fbvector<folly::fbstring>> XAttrCache::getNames(
+    const folly::fbstring &uuid)
+{
+    auto entry = find(uuid);
+    if (entry == nullptr || !entry->names)
+        return {};
+
+    if (entry->namesExpireAt <= Clock::now()) {
+        entry->names.reset();
+        return {};
+    }
+
+    return entry->names;
+}
+
+void XAttrCache::putValue(const folly::fbstring &uuid,
+    const folly::fbstring &name, folly::fbstring value)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(name);
+
+    if (m_capacity == 0)
+        return;
+
+    emplace(uuid).values[name] =
+        Value{std::move(value), Clock::now() + m_validityPeriod};
+}
+
+void XAttrCache::putMissing(
+    const folly::fbstring &uuid, const folly::fbstring &name)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(name);
+
+    if (m_capacity == 0)
+        return;
+
+    emplace(uuid).values[name] = Value{{}, Clock::now() + m_validityPeriod};
+}
+
+void XAttrCache::putNames(
+    const folly::fbstring &uuid, folly::fbvector<folly::fbstring> names)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(names.size());
+
+    if (m_capacity == 0)
+        return;
+
+    auto &entry = emplace(uuid);
+    entry.names = std::move(names);
+    entry.namesExpireAt = Clock::now() + m_validityPeriod;
+}
+
+void XAttrCache::set(const folly::fbstring &uuid, const folly::fbstring &name,
+    folly::fbstring value)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(name);
+
+    if (m_capacity == 0)
+        return;
+
+    auto &entry = emplace(uuid);
+    entry.values[name] =
+        Value{std::move(value), Clock::now() + m_validityPeriod};
+
+    if (entry.names &&
+        std::find(entry.names->begin(), entry.names->end(), name) ==
+            entry.names->end())
+        entry.names->push_back(name);
+}
+
+void XAttrCache::remove(
+    const folly::fbstring &uuid, const folly::fbstring &name)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(name);
+
+    if (m_capacity == 0)
+        return;
+
+    auto &entry = emplace(uuid);
+    entry.values[name] = Value{{}, Clock::now() + m_validityPeriod};
+
+    if (entry.names)
+        entry.names->erase(
+            std::remove(entry.names->begin(), entry.names->end(), name),
+            entry.names->end());
+}
+
+void XAttrCache::invalidate(const folly::fbstring &uuid)
+{
+    auto it = m_entries.find(uuid);
+    if (it == m_entries.end())
+        return;
+
+    LOG_DBG(2) << "Invalidating cached extended attributes of file " << uuid;
+
+    m_lruList.erase(it->second.lruIt);
+    m_entries.erase(it);
+}
+
+XAttrCache::Entry *XAttrCache::find(const folly::fbstring &uuid)
+{
+    auto it = m_entries.find(uuid);
+    if (it == m_entries.end())
+        return nullptr;
+
+    m_lruList.splice(m_lruList.end(), m_lruList, it->second.lruIt);
+    return &it->second;
+}
+
+XAttrCache::Value *XAttrCache::findValue(
+    const folly::fbstring &uuid, const folly::fbstring &name)
+{
+    auto entry = find(uuid);
+    if (entry == nullptr)
+        return nullptr;
+
+    auto it = entry->values.find(name);
+    if (it == entry->values.end())
+        return nullptr;
+
+    if (it->second.expiresAt <= Clock::now()) {
+        entry->values.erase(it);
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+XAttrCache::Entry &XAttrCache::emplace(const folly::fbstring &uuid)
+{
+    auto entry = find(uuid);
+    if (entry != nullptr)
+        return *entry;
+
+    while (m_entries.size() >= m_capacity) {
+        m_entries.erase(m_lruList.front());
+        m_lruList.pop_front();
+    }
+
+    auto lruIt = m_lruList.emplace(m_lruList.end(), uuid);
+    auto &newEntry = m_entries[uuid];
+    newEntry.lruIt = lruIt;
+    return newEntry;
+}
+
+} // namespace cache
+} // namespace client
+} // namespace one
@@ -0,0 +1,146 @@
+/**
+ * @file xattrCache.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <folly/FBString.h>
+#include <folly/FBVector.h>
+#include <folly/Optional.h>
+
+#include <chrono>
+#include <list>
+#include <unordered_map>
+
+namespace one {
+namespace client {
+namespace cache {
+
+/**
+ * @c XAttrCache remembers extended attribute names and values of files,
+ * which were recently listed or read from the provider, including names of
+ * attributes, which do not exist (ENODATA).
+ * Cached names and values expire after a validity period and are
+ * invalidated when attributes of a file change. The number of files with
+ * cached attributes is bounded with least recently used files evicted first.
+ * The cache is not thread safe.
+ */
+class XAttrCache {
+public:
+    /**
+     * Constructor.
+     * @param capacity Maximum number of files, 0 disables the cache.
+     * @param validityPeriod Period after which cached names and values
+     * expire.
+     */
+    XAttrCache(const std::size_t capacity,
+        const std::chrono::milliseconds validityPeriod);
+
+    /**
+     * Finds a cached value of an extended attribute.
+     * @param uuid Uuid of the file.
+     * @param name Name of the attribute.
+     */
+    folly::Optional<folly::fbstring> getValue(
+        const folly::fbstring &uuid, const folly::fbstring &name);
+
+    /**
+     * Checks whether an extended attribute is known not to exist.
+     * @param uuid Uuid of the file.
+     * @param name Name of the attribute.
+     */
+    bool isKnownMissing(
+        const folly::fbstring &uuid, const folly::fbstring &name);
+
+    /**
+     * Finds cached names of extended attributes of a file.
+     * @param uuid Uuid of the file.
+     */
+    folly::Optional<folly::fbvector<folly::fbstring>> getNames(
+        const folly::fbstring &uuid);
+
+    /**
+     * Records a value of an extended attribute.
+     * @param uuid Uuid of the file.
+     * @param name Name of the attribute.
+     * @param value Value of the attribute.
+     */
+    void putValue(const folly::fbstring &uuid, const folly::fbstring &name,
+        folly::fbstring value);
+
+    /**
+     * Records that an extended attribute does not exist.
+     * @param uuid Uuid of the file.
+     * @param name Name of the attribute.
+     */
+    void putMissing(const folly::fbstring &uuid, const folly::fbstring &name);
+
+    /**
+     * Records names of extended attributes of a file.
+     * @param uuid Uuid of the file.
+     * @param names Names of the attributes.
+     */
+    void putNames(
+        const folly::fbstring &uuid, folly::fbvector<folly::fbstring> names);
+
+    /**
+     * Updates cached attributes after an extended attribute was set.
+     * @param uuid Uuid of the file.
+     * @param name Name of the attribute.
+     * @param value New value of the attribute.
+     */
+    void set(const folly::fbstring &uuid, const folly::fbstring &name,
+        folly::fbstring value);
+
+    /**
+     * Updates cached attributes after an extended attribute was removed.
+     * @param uuid Uuid of the file.
+     * @param name Name of the attribute.
+     */
+    void remove(const folly::fbstring &uuid, const folly::fbstring &name);
+
+    /**
+     * Removes all cached attributes of a file.
+     * @param uuid Uuid of the file.
+     */
+    void invalidate(const folly::fbstring &uuid);
+
+    /**
+     * @return Number of files with cached attributes.
+     */
+    std::size_t size() const { return m_entries.size(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Value {
+        // Empty when the attribute is known not to exist
+        folly::Optional<folly::fbstring> value;
+        Clock::time_point expiresAt;
+    };
+
+    struct Entry {
+        std::unordered_map<folly::fbstring, Value> values;
+        folly::Optional<folly::fbvector<folly::fbstring>> names;
+        Clock::time_point namesExpireAt;
+        std::list<folly::fbstring>::iterator lruIt;
+    };
+
+    Entry *find(const folly::fbstring &uuid);
+
+    Value *findValue(const folly::fbstring &uuid, const folly::fbstring &name);
+
+    Entry &emplace(const folly::fbstring &uuid);
+
+    const std::size_t m_capacity;
+    const std::chrono::milliseconds m_validityPeriod;
+    std::list<folly::fbstring> m_lruList;
+    std::unordered_map<folly::fbstring, Entry> m_entries;
+};
+
+} // namespace cache
+} // namespace client
+} // namespace one
@@ -19,11 +19,13 @@ namespace events {
 
 FileLocationChanged::FileLocationChanged(const ProtocolMessage &msg)
     : m_fileLocation{std::make_unique<FileLocation>(msg.file_location())}
+    , m_entireChange{
+          !msg.has_change_beg_offset() || !msg.has_change_end_offset()}
 {
-    if (msg.has_change_beg_offset())
-        m_changeBegOffset.reset(msg.change_beg_offset());
-    if (msg.has_change_end_offset())
-        m_changeEndOffset.reset(msg.change_end_offset());
+    // A change with an empty range is an empty delta, which changes nothing
+    if (!m_entireChange && msg.change_beg_offset() < msg.change_end_offset())
+        m_changeRanges += boost::icl::discrete_interval<off_t>::right_open(
+            msg.change_beg_offset(), msg.change_end_offset());
 }
 
 StreamKey FileLocationChanged::streamKey() const
@@ -43,12 +45,29 @@ const FileLocation &FileLocationChanged::fileLocation() const
 
 boost::optional<off_t> FileLocationChanged::changeStartOffset() const
 {
-    return m_changeBegOffset;
+    if (m_changeRanges.empty())
+        return {};
+
+    return boost::icl::lower(m_changeRanges);
 }
 
 boost::optional<off_t> FileLocationChanged::changeEndOffset() const
 {
-    return m_changeEndOffset;
+    if (m_changeRanges.empty())
+        return {};
+
+    return boost::icl::upper(m_changeRanges);
+}
+
+bool FileLocationChanged::changesEntireLocation() const
+{
+    return m_entireChange;
+}
+
+const boost::icl::interval_set<off_t> &
+FileLocationChanged::changeRanges() const
+{
+    return m_changeRanges;
 }
 
 std::string FileLocationChanged::toString() const
@@ -56,21 +75,31 @@ std::string FileLocationChanged::toString() const
     std::stringstream stream;
     stream << "type: 'FileLocationChanged', file location: "
            << m_fileLocation->toString();
-    if (m_changeBegOffset)
-        stream << ", change_beg_offset: " << *m_changeBegOffset;
-    if (m_changeEndOffset)
-        stream << ", change_end_offset: " << *m_changeEndOffset;
+    if (!m_entireChange)
+        stream << ", change_ranges: " << m_changeRanges;
     return stream.str();
 }
 
 void FileLocationChanged::aggregate(EventPtr<FileLocationChanged> event)
 {
-    if (m_changeBegOffset && m_changeEndOffset) {
-        m_fileLocation->updateInRange(
-            *m_changeBegOffset, *m_changeEndOffset, *(event->m_fileLocation));
-    }
-    else
+    if (event->m_entireChange) {
         m_fileLocation = std::move(event->m_fileLocation);
+        m_entireChange = true;
+        m_changeRanges.clear();
+        return;
+    }
+
+    for (const auto &range : event->m_changeRanges)
+        m_fileLocation->updateInRange(
+            range.lower(), range.upper(), *(event->m_fileLocation));
+
+    m_fileLocation->version(event->m_fileLocation->version());
+    m_fileLocation->storageId(event->m_fileLocation->storageId());
+    m_fileLocation->fileId(event->m_fileLocation->fileId());
+
+    // A change of entire location stays such after applying a delta to it
+    if (!m_entireChange)
+        m_changeRanges += event->m_changeRanges;
 }
 
 } // namespace events
@@ -11,6 +11,8 @@
 
 #include "event.h"
 
+#include <boost/icl/interval_set.hpp>
+
 namespace one {
 namespace clproto {
 class FileLocationChangedEvent;
@@ -48,30 +50,47 @@ public:
     const FileLocation &fileLocation() const;
 
     /**
-     * Returns the start offset of the location change. If not defined,
-     * the change should be applied to entire file location.
+     * Returns the start offset of the location change. Not defined when the
+     * change should be applied to entire file location or is empty.
      */
     boost::optional<off_t> changeStartOffset() const;
 
     /**
-     * Returns the end offset (exclusive) of the location change. If not
-     * defined, the change should be applied to entire file location.
+     * Returns the end offset (exclusive) of the location change. Not defined
+     * when the change should be applied to entire file location or is empty.
      */
     boost::optional<off_t> changeEndOffset() const;
 
+    /**
+     * @return Whether the event changes entire file location, i.e. it or
+     * one of the events aggregated into it does not limit the change to a
+     * range.
+     */
+    bool changesEntireLocation() const;
+
+    /**
+     * Returns disjoint ranges of the file location changed by this event and
+     * the events aggregated into it. Unless the event changes entire file
+     * location, only these ranges should be applied, and none if they are
+     * empty.
+     */
+    const boost::icl::interval_set<off_t> &changeRanges() const;
+
     std::string toString() const override;
 
     /**
-     * Aggregates @c *this event with the other event. Aggregation is done by
-     * choosing the other, more recently updated, file location.
+     * Aggregates @c *this event with the other event. A change of entire
+     * file location replaces the aggregated one, while a range-limited
+     * change is applied to the aggregated location in place and its range
+     * is added to the changed ranges.
      * @param event An event to be aggregated.
      */
     void aggregate(EventPtr<FileLocationChanged> event);
 
 private:
     std::unique_ptr<FileLocation> m_fileLocation;
-    boost::optional<off_t> m_changeBegOffset;
-    boost::optional<off_t> m_changeEndOffset;
+    bool m_entireChange;
+    boost::icl::interval_set<off_t> m_changeRanges;
 };
 
 } // namespace events
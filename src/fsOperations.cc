@@ -10,6 +10,7 @@
 
 #include "communication/exception.h"
 #include "fslogic/composite.h"
+#include "fslogic/interrupt.h"
 #include "fuseOperations.h"
 #include "logging.h"
 #include "monitoring/monitoring.h"
@@ -26,11 +27,15 @@
 #include <fuse.h>
 
 #include <array>
+#include <atomic>
+#include <cstdint>
 #include <exception>
 #include <execinfo.h>
 #include <memory>
+#include <mutex>
 #include <sys/xattr.h>
 #include <system_error>
+#include <unordered_map>
 
 namespace fslogic = one::client::fslogic;
 namespace xattr = one::client::util::xattr;
@@ -111,6 +116,63 @@ void wrap(Fun &&fun, Cb &&callback, fuse_req_t req, Args &&... args)
         });
 }
 
+// FUSE may call the interrupt callback of a request while it is being replied
+// to, so the callback receives an id of the request's interrupt, which is
+// looked up in a registry, instead of a pointer to the interrupt itself
+std::mutex interruptsMutex;
+std::unordered_map<std::uintptr_t, std::weak_ptr<fslogic::Interrupt>>
+    interrupts;
+std::atomic<std::uintptr_t> nextInterruptId{1};
+
+void interruptRequest(fuse_req_t req, void *data)
+{
+    const auto id = reinterpret_cast<std::uintptr_t>(data);
+
+    std::shared_ptr<fslogic::Interrupt> interrupt;
+    {
+        std::lock_guard<std::mutex> guard{interruptsMutex};
+        auto it = interrupts.find(id);
+        if (it != interrupts.end())
+            interrupt = it->second.lock();
+    }
+
+    if (interrupt) {
+        LOG_DBG(1) << "Interrupting request " << req;
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.fuse.interrupted");
+        interrupt->interrupt();
+    }
+}
+
+/**
+ * Creates an interrupt of a FUSE request and registers it to be triggered
+ * when the request is interrupted. The interrupt is unregistered when the
+ * last reference to it is released.
+ */
+std::shared_ptr<fslogic::Interrupt> makeInterrupt(fuse_req_t req)
+{
+    const auto id = nextInterruptId++;
+
+    std::shared_ptr<fslogic::Interrupt> interrupt{
+        new fslogic::Interrupt, [id](fslogic::Interrupt *released) {
+            {
+                std::lock_guard<std::mutex> guard{interruptsMutex};
+                interrupts.erase(id);
+            }
+            delete released;
+        }};
+
+    {
+        std::lock_guard<std::mutex> guard{interruptsMutex};
+        interrupts.emplace(id, interrupt);
+    }
+
+    // Calls interruptRequest right away if the request is already interrupted
+    fuse_req_interrupt_func(
+        req, interruptRequest, reinterpret_cast<void *>(id));
+
+    return interrupt;
+}
+
 extern "C" {
 
 void wrap_lookup(fuse_req_t req, fuse_ino_t parent, const char *name)
@@ -229,9 +291,13 @@ void wrap_read(fuse_req_t req, fuse_ino_t ino, size_t size, off_t off,
 
     auto timer = ONE_METRIC_TIMERCTX_CREATE("comp.oneclient.mod.fuse.read");
 
+    // Reads waiting for block synchronization can take long, so they fail
+    // with EINTR as soon as the reading process is interrupted
+    auto interrupt = makeInterrupt(req);
+
     wrap(&fslogic::Composite::read,
-        [ req, timer = std::move(timer), ino, fh = fi->fh, size, off ](
-            folly::IOBufQueue && buf) {
+        [ req, timer = std::move(timer), ino, fh = fi->fh, size, off,
+            interrupt ](folly::IOBufQueue && buf) {
             if (!buf.empty()) {
                 auto &fsLogic =
                     (*static_cast<std::unique_ptr<fslogic::Composite> *>(
@@ -244,7 +310,8 @@ void wrap_read(fuse_req_t req, fuse_ino_t ino, size_t size, off_t off,
                 while (fsLogic.isFullBlockReadForced() &&
                     (buf.chainLength() < size)) {
                     auto remainderBuf = fsLogic.read(ino, fh,
-                        off + buf.chainLength(), size - buf.chainLength());
+                        off + buf.chainLength(), size - buf.chainLength(),
+                        interrupt);
                     if (remainderBuf.chainLength() > 0)
                         buf.append(std::move(remainderBuf));
                     else
@@ -266,7 +333,7 @@ void wrap_read(fuse_req_t req, fuse_ino_t ino, size_t size, off_t off,
                 ONE_METRIC_TIMERCTX_STOP(timer, 0);
             }
         },
-        req, ino, fi->fh, off, size);
+        req, ino, fi->fh, off, size, interrupt);
 }
 
 void wrap_write(fuse_req_t req, fuse_ino_t ino, const char *buf, size_t size,
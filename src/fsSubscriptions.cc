@@ -15,8 +15,10 @@
 #include "monitoring/monitoring.h"
 #include "scheduler.h"
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
+#include <vector>
 
 namespace one {
 namespace client {
@@ -56,6 +58,7 @@ void FsSubscriptions::handleFileAttrChanged(
     m_runInFiber([ this, events = std::move(events) ] {
         for (auto &event : events) {
             auto &attr = event->fileAttr();
+            m_onFileAttrChanged(attr.uuid());
             if (m_metadataCache.updateAttr(attr))
                 LOG_DBG(2) << "Updated attributes for uuid: '" << attr.uuid()
                            << "', size: " << (attr.size() ? *attr.size() : -1);
@@ -101,10 +104,14 @@ void FsSubscriptions::handleFileLocationChanged(
         for (auto &event : events) {
             bool updateSucceeded = false;
 
-            if (event->changeStartOffset() && event->changeEndOffset())
-                updateSucceeded = m_metadataCache.updateLocation(
-                    *(event->changeStartOffset()), *(event->changeEndOffset()),
-                    event->fileLocation());
+            // Apply only the changed ranges in place, replacing the entire
+            // location only when the event does not limit the change
+            if (!event->changesEntireLocation()) {
+                updateSucceeded = true;
+                for (const auto &range : event->changeRanges())
+                    updateSucceeded &= m_metadataCache.updateLocation(
+                        range.lower(), range.upper(), event->fileLocation());
+            }
             else
                 updateSucceeded =
                     m_metadataCache.updateLocation(event->fileLocation());
@@ -156,9 +163,18 @@ void FsSubscriptions::handlePermissionChanged(
     ONE_METRIC_COUNTER_INC(
         "comp.oneclient.mod.events.submod.received.file_permission_changed");
     m_runInFiber([ this, events = std::move(events) ] {
+        std::vector<folly::fbstring> uuids;
+        uuids.reserve(events.size());
         for (auto &event : events) {
             m_forceProxyIOCache.remove(event->fileUuid());
+            uuids.emplace_back(event->fileUuid());
         }
+
+        // Cached attributes of the files, e.g. their mode, may be stale
+        // after the change and are revalidated together in batches
+        std::sort(uuids.begin(), uuids.end());
+        uuids.erase(std::unique(uuids.begin(), uuids.end()), uuids.end());
+        m_metadataCache.fetchAttrs(uuids);
     });
 }
 
@@ -17,6 +17,7 @@
 #include "messages/fuse/createDir.h"
 #include "messages/fuse/createFile.h"
 #include "messages/fuse/deleteFile.h"
+#include "messages/fuse/dirCreated.h"
 #include "messages/fuse/fileAttr.h"
 #include "messages/fuse/fileBlock.h"
 #include "messages/fuse/fileChildren.h"
@@ -46,6 +47,7 @@
 #include "messages/fuse/xattr.h"
 #include "messages/fuse/xattrList.h"
 #include "monitoring/monitoring.h"
+#include "scheduler.h"
 #include "util/cdmi.h"
 #include "util/xattrHelper.h"
 
@@ -99,6 +101,7 @@ inline helpers::Flag getOpenFlag(const helpers::FlagsSet &flagsSet)
 }
 
 constexpr auto XATTR_FILE_BLOCKS_MAP_LENGTH = 50;
+constexpr auto PATH_WALK_TAILS_LIMIT = 64;
 
 inline static folly::fbstring ONE_XATTR(std::string name)
 {
@@ -114,7 +117,11 @@ FsLogic::FsLogic(std::shared_ptr<Context> context,
     std::function<void(folly::Function<void()>)> runInFiber)
     : m_context{context}
     , m_metadataCache{*m_context->communicator(), metadataCacheSize,
-          providerTimeout}
+          providerTimeout,
+          cache::parseEvictionPolicyType(
+              m_context->options()->getMetadataCacheEvictionPolicy()),
+          m_context->options()->getMetadataCacheMemoryLimit() * 1024UL *
+              1024UL}
     , m_helpersCache{std::move(helpersCache)}
     , m_readdirCache{std::make_shared<cache::ReaddirCache>(
           m_metadataCache, m_context, runInFiber)}
@@ -145,6 +152,26 @@ FsLogic::FsLogic(std::shared_ptr<Context> context,
     , m_ioTraceLoggerEnabled{m_context->options()->isIOTraceLoggerEnabled()}
     , m_tagOnCreate{m_context->options()->getOnCreateTag()}
     , m_tagOnModify{m_context->options()->getOnModifyTag()}
+    , m_smallFileCache{m_context->options()->getSmallFileCacheSize(),
+          m_context->options()->getSmallFileCacheThreshold()}
+    , m_diskBlockCache{
+          m_context->options()->getDiskCacheDirPath().get_value_or({}),
+          m_context->options()->getDiskCacheSize() * 1024UL * 1024UL}
+    , m_sharedReadCache{m_context->options()->getSharedReadCacheSize()}
+    , m_hedgedReadPolicy{std::make_shared<HedgedReadPolicy>(
+          m_context->options()->areHedgedReadsEnabled(),
+          m_context->options()->getHedgedReadPercentile(),
+          m_context->options()->getHedgedReadBudget())}
+    , m_cacheSnapshot{
+          m_context->options()->getCacheSnapshotPath().get_value_or({})}
+    , m_cacheSnapshotSize{metadataCacheSize}
+    , m_cacheSnapshotInterval{m_context->options()
+          ->getCacheSnapshotInterval()}
+    , m_pathWalkPrefetchSize{m_context->options()
+          ->getPathWalkPrefetchSize()}
+    , m_pathWalkTails{PATH_WALK_TAILS_LIMIT}
+    , m_xattrCache{m_context->options()->getXAttrCacheSize(),
+          m_context->options()->getXAttrCacheTTL()}
 /* clang-format on */
 {
     m_nextFuseHandleId = 0;
@@ -152,6 +179,8 @@ FsLogic::FsLogic(std::shared_ptr<Context> context,
     m_eventManager.subscribe(*configuration);
 
     m_metadataCache.setReaddirCache(m_readdirCache);
+    m_metadataCache.setLocationMemoryLimit(
+        m_context->options()->getFileLocationMemoryLimit() * 1024UL * 1024UL);
 
     // Quota initial configuration
     m_eventManager.subscribe(
@@ -186,6 +215,9 @@ FsLogic::FsLogic(std::shared_ptr<Context> context,
     });
 
     m_metadataCache.onPrune([this](const folly::fbstring &uuid) {
+        m_smallFileCache.invalidate(uuid);
+        m_sharedReadCache.invalidate(uuid);
+        m_xattrCache.invalidate(uuid);
         m_fsSubscriptions.unsubscribeFileAttrChanged(uuid);
         m_fsSubscriptions.unsubscribeFileLocationChanged(uuid);
         m_fsSubscriptions.unsubscribeFileRemoved(uuid);
@@ -204,11 +236,25 @@ FsLogic::FsLogic(std::shared_ptr<Context> context,
             if (m_fsSubscriptions.unsubscribeFileLocationChanged(oldUuid))
                 m_fsSubscriptions.subscribeFileLocationChanged(newUuid);
 
+            m_smallFileCache.invalidate(oldUuid);
+            m_diskBlockCache.invalidate(oldUuid);
+            m_sharedReadCache.invalidate(oldUuid);
+            m_xattrCache.invalidate(oldUuid);
+
             m_onRename(oldUuid, newUuid);
         });
 
-    m_metadataCache.onMarkDeleted(
-        [this](const folly::fbstring &uuid) { m_onMarkDeleted(uuid); });
+    m_metadataCache.onMarkDeleted([this](const folly::fbstring &uuid) {
+        m_smallFileCache.invalidate(uuid);
+        m_diskBlockCache.invalidate(uuid);
+        m_sharedReadCache.invalidate(uuid);
+        m_xattrCache.invalidate(uuid);
+        m_onMarkDeleted(uuid);
+    });
+
+    m_fsSubscriptions.onFileAttrChanged([this](const folly::fbstring &uuid) {
+        m_xattrCache.invalidate(uuid);
+    });
 
     if (m_clusterPrefetchThresholdRandom) {
         m_clusterPrefetchDistribution = std::uniform_int_distribution<int>(
@@ -221,10 +267,96 @@ FsLogic::FsLogic(std::shared_ptr<Context> context,
             configuration->rootUuid(), 0,
             context->options()->getMountpoint().string());
     }
+
+    if (m_cacheSnapshot.enabled()) {
+        auto uuids = m_cacheSnapshot.load();
+        if (!uuids.empty()) {
+            m_runInFiber([ this, uuids = std::move(uuids) ]() mutable {
+                warmUpMetadataCache(std::move(uuids));
+            });
+        }
+
+        scheduleCacheSnapshotSave();
+    }
 }
 
 FsLogic::~FsLogic() { m_context->communicator()->stop(); }
 
+void FsLogic::stop()
+{
+    LOG_FCALL();
+
+    {
+        std::lock_guard<std::mutex> guard{m_stopState->mutex};
+        if (m_stopState->stopped)
+            return;
+
+        m_stopState->stopped = true;
+    }
+
+    m_cancelCacheSnapshotSave();
+    saveCacheSnapshot();
+}
+
+void FsLogic::warmUpMetadataCache(std::vector<folly::fbstring> uuids)
+{
+    LOG_FCALL() << LOG_FARG(uuids.size());
+
+    if (uuids.size() > m_cacheSnapshotSize)
+        uuids.resize(m_cacheSnapshotSize);
+
+    LOG(INFO) << "Warming up metadata cache with " << uuids.size()
+              << " files from cache snapshot";
+
+    // Files removed or made inaccessible since the snapshot was saved are
+    // skipped by the bulk fetch
+    const auto warmedUp = m_metadataCache.fetchAttrs(uuids).size();
+
+    ONE_METRIC_COUNTER_SET(
+        "comp.oneclient.mod.metadatacache.warmup", warmedUp);
+
+    LOG(INFO) << "Warmed up metadata cache with " << warmedUp << " files";
+}
+
+void FsLogic::saveCacheSnapshot()
+{
+    LOG_FCALL();
+
+    if (m_cacheSnapshot.enabled())
+        m_cacheSnapshot.save(m_metadataCache.recentlyUsed(m_cacheSnapshotSize));
+}
+
+void FsLogic::scheduleCacheSnapshotSave()
+{
+    LOG_FCALL();
+
+    if (m_cacheSnapshotInterval.count() == 0)
+        return;
+
+    std::weak_ptr<StopState> weakState = m_stopState;
+
+    m_cancelCacheSnapshotSave = m_context->scheduler()->schedule(
+        m_cacheSnapshotInterval, [this, weakState] {
+            auto state = weakState.lock();
+            if (!state)
+                return;
+
+            std::lock_guard<std::mutex> guard{state->mutex};
+            if (state->stopped)
+                return;
+
+            m_runInFiber([this, weakState] {
+                // The save may have been queued just before stopping
+                auto fiberState = weakState.lock();
+                if (!fiberState || fiberState->stopped)
+                    return;
+
+                saveCacheSnapshot();
+                scheduleCacheSnapshotSave();
+            });
+        });
+}
+
 FileAttrPtr FsLogic::lookup(
     const folly::fbstring &uuid, const folly::fbstring &name)
 {
@@ -232,8 +364,14 @@ FileAttrPtr FsLogic::lookup(
 
     IOTRACE_START()
 
+    const bool cold = !m_metadataCache.isCached(uuid, name);
     auto attr = m_metadataCache.getAttr(uuid, name);
 
+    notePathWalk(uuid, attr, cold);
+
+    if (attr->type() == FileAttr::FileType::directory)
+        m_readdirCache->noteDirectoryLookup(uuid, attr->uuid());
+
     auto type = attr->type() == FileAttr::FileType::directory ? "d" : "f";
     auto size = attr->size();
 
@@ -243,6 +381,66 @@ FileAttrPtr FsLogic::lookup(
     return attr;
 }
 
+void FsLogic::notePathWalk(const folly::fbstring &parentUuid,
+    const FileAttrPtr &attr, const bool cold)
+{
+    if (m_pathWalkPrefetchSize == 0 ||
+        attr->type() != FileAttr::FileType::directory)
+        return;
+
+    // A cold lookup starts a candidate path walk, which is confirmed by
+    // the next lookup made inside of the found directory. From then on each
+    // directory found on the walk is prefetched in the background, so that
+    // later lookups of its entries, e.g. of sibling paths or by other
+    // processes walking the same tree, hit the cache. Lookups never wait
+    // for a prefetch. Walks made concurrently are tracked separately by
+    // their deepest directories.
+    if (m_pathWalkTails.exists(parentUuid)) {
+        m_pathWalkTails.erase(parentUuid);
+        prefetchPathWalk(attr->uuid());
+        m_pathWalkTails.set(attr->uuid(), true);
+    }
+    else if (cold) {
+        m_pathWalkTails.set(attr->uuid(), true);
+    }
+}
+
+void FsLogic::prefetchPathWalk(const folly::fbstring &uuid)
+{
+    LOG_FCALL() << LOG_FARG(uuid);
+
+    if (!m_pathWalkPrefetches.emplace(uuid).second)
+        return;
+
+    LOG_DBG(2) << "Prefetching entries of directory " << uuid
+               << " on path walk";
+
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.metadatacache.pathwalk");
+
+    using messages::fuse::FileChildrenAttrs;
+
+    communicateAsync<FileChildrenAttrs>(
+        messages::fuse::GetFileChildrenAttrs{uuid, 0, m_pathWalkPrefetchSize},
+        m_providerTimeout)
+        .then([this, uuid](folly::Try<FileChildrenAttrs> &&result) {
+            m_runInFiber([ this, uuid, result = std::move(result) ] {
+                if (result.hasValue()) {
+                    for (const auto &attr : result.value().childrenAttrs()) {
+                        if (!m_metadataCache.updateAttr(attr))
+                            m_metadataCache.putAttr(
+                                std::make_shared<FileAttr>(attr));
+                    }
+                }
+                else {
+                    LOG_DBG(1) << "Path walk prefetch of directory " << uuid
+                               << " failed";
+                }
+
+                m_pathWalkPrefetches.erase(uuid);
+            });
+        });
+}
+
 FileAttrPtr FsLogic::getattr(const folly::fbstring &uuid)
 {
     LOG_FCALL() << LOG_FARG(uuid);
@@ -273,7 +471,8 @@ std::uint64_t FsLogic::open(const folly::fbstring &uuid, const int flags)
 
     IOTRACE_START()
 
-    auto openFileToken = m_metadataCache.open(uuid);
+    // Make sure the file exists before asking the provider to open it
+    m_metadataCache.getAttr(uuid);
 
     const auto filteredFlags = flags & (~O_CREAT) & (~O_APPEND);
 
@@ -282,9 +481,33 @@ std::uint64_t FsLogic::open(const folly::fbstring &uuid, const int flags)
 
     LOG_DBG(2) << "Sending file opened message for " << uuid;
 
-    auto opened = communicate<messages::fuse::FileOpened>(
+    // The provider opens the file while the file location is being fetched
+    // and the storage helper for the file is being resolved
+    auto openedFuture = communicateAsync<messages::fuse::FileOpened>(
         std::move(msg), m_providerTimeout);
 
+    std::shared_ptr<cache::LRUMetadataCache::OpenFileToken> openFileToken;
+    try {
+        openFileToken = m_metadataCache.open(uuid);
+    }
+    catch (...) {
+        try {
+            auto opened = std::move(openedFuture).get();
+            communicate(messages::fuse::Release{uuid.toStdString(),
+                            opened.handleId()},
+                m_providerTimeout);
+        }
+        catch (...) {
+            LOG_DBG(1) << "Failed to release file " << uuid
+                       << " after unsuccessful open";
+        }
+        throw;
+    }
+
+    resolveHelperAsync(uuid);
+
+    auto opened = std::move(openedFuture).get();
+
     const auto fuseFileHandleId = m_nextFuseHandleId++;
 
     m_fuseFileHandles.emplace(fuseFileHandleId,
@@ -301,6 +524,25 @@ std::uint64_t FsLogic::open(const folly::fbstring &uuid, const int flags)
     return fuseFileHandleId;
 }
 
+void FsLogic::resolveHelperAsync(const folly::fbstring &uuid)
+{
+    LOG_FCALL() << LOG_FARG(uuid);
+
+    try {
+        const auto defaultBlock = m_metadataCache.getDefaultBlock(uuid);
+        const folly::fbstring spaceId = m_metadataCache.getSpaceId(uuid);
+
+        // The helper is cached by the helpers cache, so the first read on the
+        // default block will not have to wait for storage detection
+        m_helpersCache->get(uuid, spaceId, defaultBlock.storageId(),
+            m_forceProxyIOCache.contains(uuid));
+    }
+    catch (const std::exception &e) {
+        LOG_DBG(1) << "Failed to resolve storage helper for file " << uuid
+                   << " on open: " << e.what();
+    }
+}
+
 void FsLogic::release(
     const folly::fbstring &uuid, const std::uint64_t fileHandleId)
 {
@@ -398,11 +640,16 @@ void FsLogic::fsync(const folly::fbstring &uuid,
 folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
     const std::uint64_t fileHandleId, const off_t offset,
     const std::size_t size, folly::Optional<folly::fbstring> checksum,
-    const int retriesLeft, std::unique_ptr<IOTraceRead> ioTraceEntry)
+    const int retriesLeft, std::unique_ptr<IOTraceRead> ioTraceEntry,
+    std::shared_ptr<Interrupt> interrupt)
 {
     LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(fileHandleId) << LOG_FARG(offset)
                 << LOG_FARG(size);
 
+    // Do not start another attempt of an interrupted read
+    if (interrupt)
+        interrupt->check();
+
     if (m_ioTraceLoggerEnabled && !ioTraceEntry) {
         ioTraceEntry = std::make_unique<IOTraceRead>();
         ioTraceEntry->opType = IOTraceLogger::OpType::READ;
@@ -441,6 +688,54 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
     // available to read right now, for simplicity we'll only read a single
     // block per a read operation.
     try {
+        folly::Optional<folly::IOBufQueue> cached;
+        if (!checksum && m_smallFileCache.accepts(fileSize))
+            cached = readSmallFile(
+                uuid, fuseFileHandle, *attr, offset, size, interrupt);
+
+        if (!cached && !checksum && m_sharedReadCache.enabled()) {
+            const std::size_t wantedSize = boost::icl::size(wantedRange);
+            cached = m_sharedReadCache.read(uuid,
+                m_metadataCache.getLocation(uuid)->version(), offset,
+                wantedSize);
+
+            // Another handle may be reading the range from storage right now,
+            // wait for it instead of reading the same data again
+            auto pending = cached
+                ? folly::Optional<folly::Future<folly::Unit>>{}
+                : m_sharedReadCache.pendingRead(uuid, offset, wantedSize);
+            if (pending) {
+                LOG_DBG(2) << "Waiting for read of range " << wantedRange
+                           << " of file " << uuid << " in progress";
+
+                interruptible(std::move(*pending), interrupt).get();
+                cached = m_sharedReadCache.read(uuid,
+                    m_metadataCache.getLocation(uuid)->version(), offset,
+                    wantedSize);
+            }
+        }
+
+        if (cached) {
+            const auto bytesRead = cached->chainLength();
+            if (!m_readEventsDisabled) {
+                m_eventManager.emit<events::FileRead>(
+                    uuid.toStdString(), offset, bytesRead);
+            }
+
+            LOG_DBG(2) << "Read " << bytesRead << " bytes from " << uuid
+                       << " at offset " << offset << " from memory cache";
+
+            if (m_ioTraceLoggerEnabled) {
+                namespace sc = std::chrono;
+                std::get<1>(ioTraceEntry->arguments) = bytesRead;
+                ioTraceEntry->duration = sc::duration_cast<sc::microseconds>(
+                    sc::system_clock::now() - ioTraceEntry->timestamp);
+                m_ioTraceLogger->log(*ioTraceEntry);
+            }
+
+            return std::move(*cached);
+        }
+
         auto locationData = m_metadataCache.getBlock(uuid, offset);
         if (!locationData.hasValue()) {
             LOG_DBG(2) << "Requested block for " << uuid
@@ -453,16 +748,16 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
 
             folly::Optional<folly::fbstring> csum;
             if (helperHandle->needsDataConsistencyCheck())
-                csum = syncAndFetchChecksum(uuid, wantedRange);
+                csum = syncAndFetchChecksum(uuid, wantedRange, interrupt);
             else
-                sync(uuid, wantedRange);
+                sync(uuid, wantedRange, interrupt);
 
             if (m_ioTraceLoggerEnabled)
                 std::get<2>(ioTraceEntry->arguments) = false;
 
             if (retriesLeft > 0) {
                 return read(uuid, fileHandleId, offset, size, std::move(csum),
-                    retriesLeft - 1, std::move(ioTraceEntry));
+                    retriesLeft - 1, std::move(ioTraceEntry), interrupt);
             }
 
             LOG_DBG(2) << "Cannot synchronize block " << wantedRange
@@ -514,9 +809,33 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
         LOG_DBG(2) << "Reading " << availableSize << " bytes from " << uuid
                    << " at offset " << offset;
 
-        auto readBuffer = communication::wait(
-            helperHandle->read(offset, availableSize, continuousSize),
-            helperHandle->timeout());
+        const auto locationVersion =
+            m_metadataCache.getLocation(uuid)->version();
+
+        // Data read while the file is written must not be put in the shared
+        // read cache, even if no data of the file is cached yet
+        const auto fillGeneration = m_sharedReadCache.beginFill(uuid);
+        SCOPE_EXIT { m_sharedReadCache.endFill(uuid); };
+
+        // Readers of the range waiting for this read are woken up once its
+        // data is put in the cache or the read fails
+        const bool registerRead = !checksum && m_sharedReadCache.enabled();
+        if (registerRead)
+            m_sharedReadCache.beginRead(uuid, offset, availableSize);
+        SCOPE_EXIT
+        {
+            if (registerRead)
+                m_sharedReadCache.endRead(uuid, offset, availableSize);
+        };
+
+        auto hedgedRead = checksum
+            ? HedgedReadPolicy::ReadFunction{}
+            : getHedgedRead(uuid, fuseFileHandle, fileBlock, offset,
+                  availableSize, continuousSize);
+
+        auto readBuffer = readFromStorage(uuid, fileBlock.storageId(),
+            helperHandle, std::move(hedgedRead), fileSize, offset,
+            availableSize, continuousSize, !checksum);
 
         if (helperHandle->needsDataConsistencyCheck() && checksum &&
             dataCorrupted(uuid, readBuffer, *checksum, wantedAvailableRange,
@@ -539,7 +858,7 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
                     ioTraceEntry->retries++;
 
                 return read(uuid, fileHandleId, offset, size, checksum,
-                    retriesLeft - 1, std::move(ioTraceEntry));
+                    retriesLeft - 1, std::move(ioTraceEntry), interrupt);
             }
 
             LOG(ERROR) << "Failed to read " << size << " bytes at offset "
@@ -549,6 +868,10 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
             throw std::system_error(std::make_error_code(std::errc::io_error));
         }
 
+        if (!checksum &&
+            !m_sharedReadCache.invalidatedSince(uuid, fillGeneration))
+            m_sharedReadCache.put(uuid, locationVersion, offset, readBuffer);
+
         const auto bytesRead = readBuffer.chainLength();
         if (!m_readEventsDisabled) {
             m_eventManager.emit<events::FileRead>(
@@ -572,7 +895,7 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
         if ((e.code().value() == EAGAIN) && (retriesLeft > 0)) {
             fiberRetryDelay(retriesLeft);
             return read(uuid, fileHandleId, offset, size, checksum,
-                retriesLeft - 1, std::move(ioTraceEntry));
+                retriesLeft - 1, std::move(ioTraceEntry), interrupt);
         }
 
         if ((e.code().value() != EPERM) && (e.code().value() != EACCES)) {
@@ -600,8 +923,207 @@ folly::IOBufQueue FsLogic::read(const folly::fbstring &uuid,
                    << " via proxy fallback";
 
         return read(uuid, fileHandleId, offset, size, checksum,
-            FSLOGIC_RETRY_COUNT, std::move(ioTraceEntry));
+            FSLOGIC_RETRY_COUNT, std::move(ioTraceEntry), interrupt);
+    }
+}
+
+folly::Optional<folly::IOBufQueue> FsLogic::readSmallFile(
+    const folly::fbstring &uuid, std::shared_ptr<FuseFileHandle> fuseFileHandle,
+    const FileAttr &attr, const off_t offset, const std::size_t size,
+    const std::shared_ptr<Interrupt> &interrupt)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(offset) << LOG_FARG(size);
+
+    auto location = m_metadataCache.getLocation(uuid);
+
+    auto cached = m_smallFileCache.read(
+        uuid, location->version(), attr.mtime(), offset, size);
+    if (cached)
+        return cached;
+
+    const auto fileSize = *attr.size();
+    if (!location->isReplicationComplete(fileSize))
+        return {};
+
+    // Another handle may be reading the file into the cache right now, wait
+    // for it instead of reading the same file again
+    auto pending = m_smallFileCache.pendingFill(uuid);
+    if (pending) {
+        LOG_DBG(2) << "Waiting for small file " << uuid
+                   << " to be read into small file cache";
+
+        interruptible(std::move(*pending), interrupt).get();
+        return m_smallFileCache.read(
+            uuid, location->version(), attr.mtime(), offset, size);
+    }
+
+    LOG_DBG(2) << "Reading entire small file " << uuid << " of size "
+               << fileSize << " into small file cache";
+
+    // Writes of the file issued while its content is read invalidate the
+    // cache only before they yield, so they have to be detected separately
+    const auto fillGeneration = m_smallFileCache.beginFill(uuid);
+    SCOPE_EXIT { m_smallFileCache.endFill(uuid); };
+
+    // Blocks of a fully replicated file can still reside on different
+    // storages, so each block is read through its own helper
+    folly::IOBufQueue content{folly::IOBufQueue::cacheChainLength()};
+    off_t blockOffset = 0;
+    while (blockOffset < fileSize) {
+        auto block = m_metadataCache.getBlock(uuid, blockOffset);
+        if (!block)
+            return {};
+
+        const auto blockEnd =
+            std::min(boost::icl::last_next(block->first), fileSize);
+        const auto blockSize = static_cast<std::size_t>(blockEnd - blockOffset);
+
+        auto helperHandle = fuseFileHandle->getHelperHandle(uuid,
+            m_metadataCache.getSpaceId(uuid), block->second.storageId(),
+            block->second.fileId());
+
+        auto blockContent = communication::wait(
+            helperHandle->read(blockOffset, blockSize, blockSize),
+            helperHandle->timeout());
+
+        if (blockContent.chainLength() != blockSize) {
+            LOG_DBG(1) << "Read only " << blockContent.chainLength()
+                       << " out of " << blockSize << " bytes at offset "
+                       << blockOffset << " of small file " << uuid;
+            return {};
+        }
+
+        content.append(blockContent.move());
+        blockOffset = blockEnd;
+    }
+
+    if (m_smallFileCache.invalidatedSince(uuid, fillGeneration)) {
+        LOG_DBG(2) << "Small file " << uuid
+                   << " has been modified while it was read - not caching";
+        return {};
+    }
+
+    m_smallFileCache.put(
+        uuid, location->version(), attr.mtime(), content.move());
+
+    return m_smallFileCache.read(
+        uuid, location->version(), attr.mtime(), offset, size);
+}
+
+folly::IOBufQueue FsLogic::readFromStorage(const folly::fbstring &uuid,
+    const folly::fbstring &storageId, helpers::FileHandlePtr helperHandle,
+    HedgedReadPolicy::ReadFunction hedgedRead, const std::size_t fileSize,
+    const off_t offset, const std::size_t size,
+    const std::size_t continuousSize, const bool useDiskCache)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(storageId)
+                << LOG_FARG(fileSize) << LOG_FARG(offset) << LOG_FARG(size)
+                << LOG_FARG(continuousSize) << LOG_FARG(useDiskCache);
+
+    // Only data transferred via proxy is worth caching on local disk
+    const bool cacheable = useDiskCache && m_diskBlockCache.enabled() &&
+        (m_forceProxyIOCache.contains(uuid) ||
+            m_helpersCache->getAccessType(storageId) ==
+                cache::HelpersCache::AccessType::PROXY);
+
+    if (!cacheable && hedgedRead) {
+        auto primary = [=] {
+            return helperHandle->read(offset, size, continuousSize);
+        };
+
+        return communication::wait(
+            m_hedgedReadPolicy->read(std::move(primary), std::move(hedgedRead)),
+            helperHandle->timeout());
+    }
+
+    if (!cacheable) {
+        return communication::wait(
+            helperHandle->read(offset, size, continuousSize),
+            helperHandle->timeout());
+    }
+
+    const auto locationVersion = m_metadataCache.getLocation(uuid)->version();
+
+    auto cached = m_diskBlockCache.read(uuid, locationVersion, offset, size);
+    if (cached) {
+        try {
+            auto cachedBuffer = communication::wait(
+                std::move(*cached), helperHandle->timeout());
+
+            LOG_DBG(2) << "Read " << cachedBuffer.chainLength()
+                       << " bytes from " << uuid << " at offset " << offset
+                       << " from disk cache";
+
+            return cachedBuffer;
+        }
+        catch (const std::system_error &e) {
+            LOG_DBG(1) << "Reading from disk cache failed for " << uuid
+                       << " - falling back to storage: " << e.what();
+        }
     }
+
+    auto readBuffer = communication::wait(
+        helperHandle->read(offset, size, continuousSize),
+        helperHandle->timeout());
+
+    m_diskBlockCache.write(uuid, locationVersion, fileSize, offset, readBuffer);
+
+    return readBuffer;
+}
+
+HedgedReadPolicy::ReadFunction FsLogic::getHedgedRead(
+    const folly::fbstring &uuid, std::shared_ptr<FuseFileHandle> fuseFileHandle,
+    const messages::fuse::FileBlock &fileBlock, const off_t offset,
+    const std::size_t size, const std::size_t continuousSize)
+{
+    if (!m_hedgedReadPolicy->enabled() ||
+        (fuseFileHandle->flags() & O_ACCMODE) != O_RDONLY ||
+        m_context->options()->isDirectIOForced() ||
+        m_forceProxyIOCache.contains(uuid) ||
+        m_helpersCache->getAccessType(fileBlock.storageId()) !=
+            cache::HelpersCache::AccessType::DIRECT)
+        return {};
+
+    // The proxy handle is open only when the read is actually hedged. The
+    // hedge is issued from a timer thread, so the handle is open in the main
+    // fiber, unless the file has been released in the meantime
+    std::weak_ptr<FuseFileHandle> weakFileHandle = fuseFileHandle;
+    std::weak_ptr<StopState> weakStopState = m_stopState;
+    const auto storageId = fileBlock.storageId();
+    const auto fileId = fileBlock.fileId();
+
+    return [=] {
+        auto stopState = weakStopState.lock();
+        if (!stopState)
+            return folly::makeFuture<folly::IOBufQueue>(std::system_error{
+                std::make_error_code(std::errc::operation_canceled)});
+
+        std::lock_guard<std::mutex> guard{stopState->mutex};
+        if (stopState->stopped)
+            return folly::makeFuture<folly::IOBufQueue>(std::system_error{
+                std::make_error_code(std::errc::operation_canceled)});
+
+        auto promise = std::make_shared<folly::Promise<folly::IOBufQueue>>();
+        auto future = promise->getFuture();
+
+        m_runInFiber([=] {
+            folly::makeFutureWith([&] {
+                auto openFileHandle = weakFileHandle.lock();
+                if (!openFileHandle)
+                    throw std::system_error{
+                        std::make_error_code(std::errc::bad_file_descriptor)};
+
+                auto proxyHandle = openFileHandle->getProxyHelperHandle(uuid,
+                    m_metadataCache.getSpaceId(uuid), storageId, fileId);
+
+                return proxyHandle->read(offset, size, continuousSize);
+            }).then([promise](folly::Try<folly::IOBufQueue> &&result) {
+                promise->setTry(std::move(result));
+            });
+        });
+
+        return future;
+    };
 }
 
 std::pair<size_t, IOTraceLogger::PrefetchType> FsLogic::prefetchAsync(
@@ -632,8 +1154,11 @@ std::pair<size_t, IOTraceLogger::PrefetchType> FsLogic::prefetchAsync(
     bool clusterPrefetchRequested = false;
     int prefetchPriority = SYNCHRONIZE_BLOCK_PRIORITY_IMMEDIATE;
 
-    // Check if we should consider block cluster prefetch
-    if (m_randomReadPrefetchClusterWindow != 0) {
+    // Check if we should consider block cluster prefetch, which cannot be
+    // evaluated for windowed locations as their blocks are not known outside
+    // of the retained ranges
+    if (m_randomReadPrefetchClusterWindow != 0 &&
+        !fileLocation->isWindowed()) {
         off_t leftRange = 0;
         off_t rightRange = 0;
         bool blockAligned;
@@ -791,6 +1316,9 @@ std::size_t FsLogic::write(const folly::fbstring &uuid,
         return 0;
     }
 
+    m_smallFileCache.invalidate(uuid);
+    m_diskBlockCache.invalidate(uuid);
+
     if (m_ioTraceLoggerEnabled && !ioTraceEntry) {
         ioTraceEntry = std::make_unique<IOTraceWrite>();
         ioTraceEntry->opType = IOTraceLogger::OpType::WRITE;
@@ -814,11 +1342,20 @@ std::size_t FsLogic::write(const folly::fbstring &uuid,
 
     auto fileBlock = m_metadataCache.getDefaultBlock(uuid);
 
+    // Keep a reference to the written data, to overlay it on the shared read
+    // cache once the write succeeds
+    folly::IOBufQueue written{folly::IOBufQueue::cacheChainLength()};
+    if (m_sharedReadCache.enabled())
+        written.append(buf.front()->clone());
+
     size_t bytesWritten = 0;
     try {
         auto helperHandle = fuseFileHandle->getHelperHandle(
             uuid, spaceId, fileBlock.storageId(), fileBlock.fileId());
 
+        fuseFileHandle->beginWrite();
+        SCOPE_EXIT { fuseFileHandle->endWrite(); };
+
         bytesWritten =
             communication::wait(helperHandle->write(offset, std::move(buf)),
                 helperHandle->timeout());
@@ -854,6 +1391,15 @@ std::size_t FsLogic::write(const folly::fbstring &uuid,
             retriesLeft, std::move(ioTraceEntry));
     }
 
+    // Small files read while this write was in progress could have been
+    // cached with the previous content
+    m_smallFileCache.invalidate(uuid);
+
+    if (!written.empty()) {
+        written.trimEnd(written.chainLength() - bytesWritten);
+        m_sharedReadCache.write(uuid, offset, written);
+    }
+
     m_eventManager.emit<events::FileWritten>(uuid.toStdString(), offset,
         bytesWritten, fileBlock.storageId(), fileBlock.fileId());
 
@@ -901,15 +1447,25 @@ FileAttrPtr FsLogic::mkdir(const folly::fbstring &parentUuid,
 
     IOTRACE_START()
 
-    // TODO: CreateDir should probably also return attrs
-    communicate(messages::fuse::CreateDir{parentUuid.toStdString(),
-                    name.toStdString(), mode},
+    auto created = communicate<messages::fuse::DirCreated>(
+        messages::fuse::CreateDir{
+            parentUuid.toStdString(), name.toStdString(), mode},
         m_providerTimeout);
 
     LOG_DBG(2) << "Created directory " << name << " in " << parentUuid;
 
-    // TODO: Provider returns uuid of the created dir, no need for lookup
-    auto attr = m_metadataCache.getAttr(parentUuid, name);
+    m_readdirCache->invalidate(parentUuid);
+
+    FileAttrPtr attr;
+    if (created.attr()) {
+        // Newer providers return the attributes of the created directory,
+        // which saves a separate lookup round trip
+        attr = std::make_shared<FileAttr>(*created.attr());
+        m_metadataCache.putAttr(attr);
+    }
+    else {
+        attr = m_metadataCache.getAttr(parentUuid, name);
+    }
 
     IOTRACE_END(IOTraceMkdir, IOTraceLogger::OpType::MKDIR, parentUuid, 0, name,
         attr->uuid(), mode)
@@ -1060,15 +1616,17 @@ FileAttrPtr FsLogic::setattr(
     IOTRACE_GUARD(IOTraceSetAttr, IOTraceLogger::OpType::SETATTR, uuid, 0,
         toSet, attr.st_mode, attr.st_size, attr.st_atime, attr.st_mtime)
 
-    // TODO: this operation can be optimized with a single message to the
-    // provider
-
     if ((toSet & FUSE_SET_ATTR_UID) != 0 || (toSet & FUSE_SET_ATTR_GID) != 0) {
         LOG_DBG(1) << "Attempting to modify uid or gid attempted for " << uuid
                    << ". Operation not supported.";
         throw std::errc::operation_not_supported; // NOLINT
     }
 
+    // Requests are sent one after another, as the provider may apply
+    // concurrent requests in any order, e.g. update times before a truncate
+    // which changes them again. A failed request fails the entire setattr
+    // and the following changes are not sent.
+
     if ((toSet & FUSE_SET_ATTR_MODE) != 0) {
         // ALLPERMS is a macro of sys/stat.h
         const mode_t normalizedMode = attr.st_mode & ALLPERMS;
@@ -1087,6 +1645,9 @@ FileAttrPtr FsLogic::setattr(
         communicate(messages::fuse::Truncate{uuid.toStdString(), attr.st_size},
             m_providerTimeout);
         m_metadataCache.truncate(uuid, attr.st_size);
+        m_smallFileCache.invalidate(uuid);
+        m_diskBlockCache.invalidate(uuid);
+        m_sharedReadCache.invalidate(uuid);
         m_eventManager.emit<events::FileTruncated>(
             uuid.toStdString(), attr.st_size);
 
@@ -1171,7 +1732,8 @@ folly::fbstring FsLogic::getxattr(
 
     if (name == ONE_XATTR("file_blocks_count")) {
         auto forceLocationUpdate =
-            !m_fsSubscriptions.isSubscribedToFileLocationChanged(uuid);
+            !m_fsSubscriptions.isSubscribedToFileLocationChanged(uuid) ||
+            m_metadataCache.getLocation(uuid)->isWindowed();
         return "\"" +
             std::to_string(
                 m_metadataCache.getLocation(uuid, forceLocationUpdate)
@@ -1186,7 +1748,8 @@ folly::fbstring FsLogic::getxattr(
         }
 
         auto forceLocationUpdate =
-            !m_fsSubscriptions.isSubscribedToFileLocationChanged(uuid);
+            !m_fsSubscriptions.isSubscribedToFileLocationChanged(uuid) ||
+            m_metadataCache.getLocation(uuid)->isWindowed();
         return "\"[" +
             m_metadataCache.getLocation(uuid, forceLocationUpdate)
                 ->progressString(size, XATTR_FILE_BLOCKS_MAP_LENGTH) +
@@ -1197,7 +1760,8 @@ folly::fbstring FsLogic::getxattr(
         std::size_t size = m_metadataCache.getAttr(uuid)->size().value_or(0);
 
         auto forceLocationUpdate =
-            !m_fsSubscriptions.isSubscribedToFileLocationChanged(uuid);
+            !m_fsSubscriptions.isSubscribedToFileLocationChanged(uuid) ||
+            m_metadataCache.getLocation(uuid)->isWindowed();
         auto replicationProgress =
             m_metadataCache.getLocation(uuid, forceLocationUpdate)
                 ->replicationProgress(size);
@@ -1209,10 +1773,32 @@ folly::fbstring FsLogic::getxattr(
             "%\"";
     }
 
+    if (auto cachedValue = m_xattrCache.getValue(uuid, name)) {
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.xattrcache.hit");
+        return *cachedValue;
+    }
+
+    if (m_xattrCache.isKnownMissing(uuid, name)) {
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.xattrcache.hit");
+        throw std::system_error{
+            std::make_error_code(std::errc::no_message_available)};
+    }
+
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.xattrcache.miss");
+
     messages::fuse::GetXAttr getXAttrRequest{uuid, name};
-    auto xattr =
-        communicate<messages::fuse::XAttr>(getXAttrRequest, m_providerTimeout);
-    result = xattr.value();
+    try {
+        auto xattr = communicate<messages::fuse::XAttr>(
+            getXAttrRequest, m_providerTimeout);
+        result = xattr.value();
+    }
+    catch (const std::system_error &e) {
+        if (e.code().value() == ENODATA)
+            m_xattrCache.putMissing(uuid, name);
+        throw;
+    }
+
+    m_xattrCache.putValue(uuid, name, result);
 
     LOG_DBG(2) << "Received xattr " << name << " value for file " << uuid;
 
@@ -1233,6 +1819,8 @@ void FsLogic::setxattr(const folly::fbstring &uuid, const folly::fbstring &name,
     communicate<messages::fuse::FuseResponse>(
         setXAttrRequest, m_providerTimeout);
 
+    m_xattrCache.set(uuid, name, value);
+
     LOG_DBG(2) << "Set xattr " << name << " value for file " << uuid;
 }
 
@@ -1248,6 +1836,8 @@ void FsLogic::removexattr(
     communicate<messages::fuse::FuseResponse>(
         removeXAttrRequest, m_providerTimeout);
 
+    m_xattrCache.remove(uuid, name);
+
     LOG_DBG(2) << "Removed xattr " << name << " from file " << uuid;
 }
 
@@ -1261,12 +1851,22 @@ folly::fbvector<folly::fbstring> FsLogic::listxattr(const folly::fbstring &uuid)
 
     folly::fbvector<folly::fbstring> result;
 
-    omf::ListXAttr listXAttrRequest{uuid};
-    omf::XAttrList fuseResponse =
-        communicate<omf::XAttrList>(listXAttrRequest, m_providerTimeout);
+    if (auto cachedNames = m_xattrCache.getNames(uuid)) {
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.xattrcache.hit");
+        result = std::move(*cachedNames);
+    }
+    else {
+        ONE_METRIC_COUNTER_INC("comp.oneclient.mod.xattrcache.miss");
+
+        omf::ListXAttr listXAttrRequest{uuid};
+        omf::XAttrList fuseResponse =
+            communicate<omf::XAttrList>(listXAttrRequest, m_providerTimeout);
 
-    for (const auto &xattrName : fuseResponse.xattrNames()) {
-        result.push_back(xattrName.c_str());
+        for (const auto &xattrName : fuseResponse.xattrNames()) {
+            result.push_back(xattrName.c_str());
+        }
+
+        m_xattrCache.putNames(uuid, result);
     }
 
     result.push_back(ONE_XATTR("uuid"));
@@ -1287,6 +1887,13 @@ folly::fbvector<folly::fbstring> FsLogic::listxattr(const folly::fbstring &uuid)
 
 template <typename SrvMsg, typename CliMsg>
 SrvMsg FsLogic::communicate(CliMsg &&msg, const std::chrono::seconds timeout)
+{
+    return communicateAsync<SrvMsg>(std::forward<CliMsg>(msg), timeout).get();
+}
+
+template <typename SrvMsg, typename CliMsg>
+folly::Future<SrvMsg> FsLogic::communicateAsync(
+    CliMsg &&msg, const std::chrono::seconds timeout)
 {
     auto messageString = msg.toString();
     return m_context->communicator()
@@ -1300,18 +1907,21 @@ SrvMsg FsLogic::communicate(CliMsg &&msg, const std::chrono::seconds timeout)
                            << " not received within " << timeout << " seconds.";
                 return folly::makeFuture<SrvMsg>(std::system_error{
                     std::make_error_code(std::errc::timed_out)});
-            })
-        .get();
+            });
 }
 
 folly::fbstring FsLogic::syncAndFetchChecksum(const folly::fbstring &uuid,
-    const boost::icl::discrete_interval<off_t> &range)
+    const boost::icl::discrete_interval<off_t> &range,
+    const std::shared_ptr<Interrupt> &interrupt)
 {
     messages::fuse::SynchronizeBlockAndComputeChecksum request{
         uuid.toStdString(), range, SYNCHRONIZE_BLOCK_PRIORITY_IMMEDIATE};
 
-    auto syncResponse = communicate<messages::fuse::SyncResponse>(
-        std::move(request), m_providerTimeout);
+    auto syncResponse =
+        interruptible(communicateAsync<messages::fuse::SyncResponse>(
+                          std::move(request), m_providerTimeout),
+            interrupt)
+            .get();
 
     auto &fileLocationUpdate = syncResponse.fileLocationChanged();
     if (fileLocationUpdate.changeStartOffset() &&
@@ -1327,12 +1937,19 @@ folly::fbstring FsLogic::syncAndFetchChecksum(const folly::fbstring &uuid,
 }
 
 void FsLogic::sync(const folly::fbstring &uuid,
-    const boost::icl::discrete_interval<off_t> &range)
+    const boost::icl::discrete_interval<off_t> &range,
+    const std::shared_ptr<Interrupt> &interrupt)
 {
     messages::fuse::SynchronizeBlock request{
         uuid.toStdString(), range, SYNCHRONIZE_BLOCK_PRIORITY_IMMEDIATE, false};
-    auto fileLocationUpdate = communicate<messages::fuse::FileLocationChanged>(
-        std::move(request), m_providerTimeout);
+
+    // The block synchronization cannot be cancelled on the provider, but an
+    // interrupted read does not wait for it to complete
+    auto fileLocationUpdate =
+        interruptible(communicateAsync<messages::fuse::FileLocationChanged>(
+                          std::move(request), m_providerTimeout),
+            interrupt)
+            .get();
 
     if (fileLocationUpdate.changeStartOffset() &&
         fileLocationUpdate.changeEndOffset())
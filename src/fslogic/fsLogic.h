@@ -11,26 +11,36 @@
 #include "fuseFileHandle.h"
 
 #include "attrs.h"
+#include "cache/cacheSnapshot.h"
+#include "cache/diskBlockCache.h"
 #include "cache/forceProxyIOCache.h"
 #include "cache/helpersCache.h"
 #include "cache/lruMetadataCache.h"
 #include "cache/readdirCache.h"
+#include "cache/sharedReadCache.h"
+#include "cache/smallFileCache.h"
+#include "cache/xattrCache.h"
 #include "events/events.h"
 #include "fsSubscriptions.h"
+#include "hedgedReadPolicy.h"
+#include "interrupt.h"
 #include "ioTraceLogger.h"
 
 #include <asio/buffer.hpp>
 #include <boost/icl/discrete_interval.hpp>
 #include <folly/FBString.h>
+#include <folly/EvictingCacheMap.h>
 #include <folly/FBVector.h>
 #include <folly/Function.h>
 #include <folly/io/IOBufQueue.h>
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 constexpr auto ONE_XATTR_PREFIX = "org.onedata.";
 
@@ -85,6 +95,13 @@ public:
 
     ~FsLogic();
 
+    /**
+     * Stops periodic saving of the cache snapshot and saves it for the last
+     * time. Must be called on the fiber before @c FsLogic is destroyed, so
+     * that the snapshot isn't saved while the cache is modified.
+     */
+    void stop();
+
     /**
      * FUSE @c lookup callback.
      * @see https://libfuse.github.io/doxygen/structfuse__lowlevel__ops.html
@@ -119,13 +136,17 @@ public:
 
     /**
      * FUSE @c read callback.
+     * When @p interrupt is given, waiting for synchronization of the block is
+     * abandoned and the read fails with @c EINTR once the FUSE request is
+     * interrupted.
      * @see https://libfuse.github.io/doxygen/structfuse__lowlevel__ops.html
      */
     folly::IOBufQueue read(const folly::fbstring &uuid,
         const std::uint64_t fileHandleId, const off_t offset,
         const std::size_t size, folly::Optional<folly::fbstring> checksum,
         const int retriesLeft = FSLOGIC_RETRY_COUNT,
-        std::unique_ptr<IOTraceRead> ioTraceEntry = {});
+        std::unique_ptr<IOTraceRead> ioTraceEntry = {},
+        std::shared_ptr<Interrupt> interrupt = {});
 
     /**
      * FUSE @c write callback.
@@ -249,11 +270,17 @@ private:
     template <typename SrvMsg = messages::fuse::FuseResponse, typename CliMsg>
     SrvMsg communicate(CliMsg &&msg, const std::chrono::seconds timeout);
 
+    template <typename SrvMsg = messages::fuse::FuseResponse, typename CliMsg>
+    folly::Future<SrvMsg> communicateAsync(
+        CliMsg &&msg, const std::chrono::seconds timeout);
+
     folly::fbstring syncAndFetchChecksum(const folly::fbstring &uuid,
-        const boost::icl::discrete_interval<off_t> &range);
+        const boost::icl::discrete_interval<off_t> &range,
+        const std::shared_ptr<Interrupt> &interrupt = {});
 
     void sync(const folly::fbstring &uuid,
-        const boost::icl::discrete_interval<off_t> &range);
+        const boost::icl::discrete_interval<off_t> &range,
+        const std::shared_ptr<Interrupt> &interrupt = {});
 
     bool dataCorrupted(const folly::fbstring &uuid,
         const folly::IOBufQueue &buf, const folly::fbstring &serverChecksum,
@@ -278,6 +305,95 @@ private:
         const boost::icl::discrete_interval<off_t> possibleRange,
         const boost::icl::discrete_interval<off_t> availableRange);
 
+    folly::Optional<folly::IOBufQueue> readSmallFile(
+        const folly::fbstring &uuid,
+        std::shared_ptr<FuseFileHandle> fuseFileHandle, const FileAttr &attr,
+        const off_t offset, const std::size_t size,
+        const std::shared_ptr<Interrupt> &interrupt);
+
+    /**
+     * Reads data from the storage helper. Data read via proxy is served from,
+     * and stored in, the local disk cache when it is enabled.
+     * @param uuid Uuid of the file
+     * @param storageId Id of the storage on which the data is located
+     * @param helperHandle Handle of the storage helper
+     * @param hedgedRead Alternate read used to hedge slow reads, or an empty
+     * function if the read should not be hedged
+     * @param fileSize Current size of the file
+     * @param offset Offset of the range to read
+     * @param size Size of the range to read
+     * @param continuousSize Size of the continuous block available at offset
+     * @param useDiskCache Whether the disk cache can be used for this read
+     */
+    folly::IOBufQueue readFromStorage(const folly::fbstring &uuid,
+        const folly::fbstring &storageId, helpers::FileHandlePtr helperHandle,
+        HedgedReadPolicy::ReadFunction hedgedRead, const std::size_t fileSize,
+        const off_t offset, const std::size_t size,
+        const std::size_t continuousSize, const bool useDiskCache);
+
+    /**
+     * Returns a read via proxy used to hedge reads of a block, if hedged
+     * reads are enabled and the block is accessed directly. Files open for
+     * writing are not hedged, as data buffered in the direct handle would not
+     * be visible via proxy. The proxy helper handle is open only when the
+     * returned function is called, i.e. when the read is actually hedged.
+     * @param uuid Uuid of the file
+     * @param fuseFileHandle Handle of the open file
+     * @param fileBlock Block from which the data is read
+     * @param offset Offset of the range to read
+     * @param size Size of the range to read
+     * @param continuousSize Size of the continuous block available at offset
+     * @return Read function or an empty function if the read should not be
+     * hedged
+     */
+    HedgedReadPolicy::ReadFunction getHedgedRead(const folly::fbstring &uuid,
+        std::shared_ptr<FuseFileHandle> fuseFileHandle,
+        const messages::fuse::FileBlock &fileBlock, const off_t offset,
+        const std::size_t size, const std::size_t continuousSize);
+
+    /**
+     * Starts resolution of the storage helper for the default block of an
+     * opened file, without waiting for its result.
+     * @param uuid Uuid of the opened file
+     */
+    void resolveHelperAsync(const folly::fbstring &uuid);
+
+    /**
+     * Detects lookups walking down a path on a cold cache and prefetches
+     * entries of the directories on the path.
+     * @param parentUuid Uuid of the directory in which the lookup was made.
+     * @param attr Attributes of the looked up file.
+     * @param cold Whether the lookup could not be answered from the cache.
+     */
+    void notePathWalk(const folly::fbstring &parentUuid,
+        const FileAttrPtr &attr, const bool cold);
+
+    /**
+     * Fetches attributes of entries of a directory in a single request and
+     * puts them in the metadata cache in the background.
+     * @param uuid Uuid of the directory.
+     */
+    void prefetchPathWalk(const folly::fbstring &uuid);
+
+    /**
+     * Fetches attributes of files listed in the cache snapshot from the
+     * provider in batches and puts them in the metadata cache, which also
+     * subscribes for their changes.
+     * Must be called on the fiber.
+     * @param uuids Uuids of files to fetch.
+     */
+    void warmUpMetadataCache(std::vector<folly::fbstring> uuids);
+
+    /**
+     * Saves uuids of files cached in the metadata cache to the snapshot.
+     */
+    void saveCacheSnapshot();
+
+    /**
+     * Schedules periodic saving of the cache snapshot.
+     */
+    void scheduleCacheSnapshotSave();
+
     /**
      * Suspends current fiber for a random timed delay depending
      * on current retry number.
@@ -324,6 +440,30 @@ private:
     const bool m_ioTraceLoggerEnabled;
     const boost::optional<std::pair<std::string, std::string>> m_tagOnCreate;
     const boost::optional<std::pair<std::string, std::string>> m_tagOnModify;
+    cache::SmallFileCache m_smallFileCache;
+    cache::DiskBlockCache m_diskBlockCache;
+    cache::SharedReadCache m_sharedReadCache;
+    std::shared_ptr<HedgedReadPolicy> m_hedgedReadPolicy;
+    cache::CacheSnapshot m_cacheSnapshot;
+    const std::size_t m_cacheSnapshotSize;
+    const std::chrono::seconds m_cacheSnapshotInterval;
+    std::function<void()> m_cancelCacheSnapshotSave = [] {};
+    // Set by @c stop() and held weakly by callbacks called from other
+    // threads, such as scheduled snapshot saves and hedged reads, so that
+    // they don't reach @c FsLogic after it's stopped or destroyed
+    struct StopState {
+        std::mutex mutex;
+        bool stopped = false;
+    };
+    std::shared_ptr<StopState> m_stopState = std::make_shared<StopState>();
+
+    const std::size_t m_pathWalkPrefetchSize;
+    // Deepest directories of paths recently walked by lookups, one for each
+    // walk in progress
+    folly::EvictingCacheMap<folly::fbstring, bool> m_pathWalkTails;
+    std::unordered_set<folly::fbstring> m_pathWalkPrefetches;
+
+    cache::XAttrCache m_xattrCache;
 
     std::shared_ptr<IOTraceLogger> m_ioTraceLogger;
 
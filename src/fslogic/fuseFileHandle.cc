@@ -12,12 +12,18 @@
 #include "cache/helpersCache.h"
 #include "logging.h"
 
+#include <folly/ScopeGuard.h>
+#include <folly/fibers/Baton.h>
+
+#include <algorithm>
+
 namespace one {
 namespace client {
 namespace fslogic {
 
 constexpr auto FSLOGIC_RECENT_PREFETCH_CACHE_SIZE = 1000u;
 constexpr auto FSLOGIC_RECENT_PREFETCH_CACHE_PRUNE_SIZE = 50u;
+constexpr std::chrono::milliseconds FSLOGIC_RETIRED_HANDLE_POLL_INTERVAL{10};
 
 FuseFileHandle::FuseFileHandle(const int flags_, folly::fbstring handleId,
     std::shared_ptr<cache::LRUMetadataCache::OpenFileToken> openFileToken,
@@ -51,12 +57,30 @@ helpers::FileHandlePtr FuseFileHandle::getHelperHandle(
 {
     LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(storageId) << LOG_FARG(fileId);
 
+    if (!m_retiredHelperHandles.empty())
+        releaseRetiredHelperHandles();
+
     const bool forceProxyIO = m_forceProxyIOCache.contains(uuid);
-    const auto key = std::make_tuple(storageId, fileId, forceProxyIO);
+    const auto accessGeneration = m_helpersCache.accessGeneration();
+    const auto key = std::make_tuple(storageId, fileId);
+
+    // Only one fiber at a time opens or replaces the handle of a location,
+    // the others wait for it and look the handle up again
+    waitForPendingOpen(m_pendingOpens, key);
 
     auto it = m_helperHandles.find(key);
-    if (it != m_helperHandles.end())
-        return it->second;
+    if (it != m_helperHandles.end() &&
+        it->second.forceProxyIO == forceProxyIO &&
+        it->second.accessGeneration == accessGeneration)
+        return it->second.handle;
+
+    auto pendingOpen = std::make_shared<folly::SharedPromise<folly::Unit>>();
+    m_pendingOpens.emplace(key, pendingOpen);
+    SCOPE_EXIT
+    {
+        m_pendingOpens.erase(key);
+        pendingOpen->setValue();
+    };
 
     auto helper =
         m_helpersCache.get(uuid, spaceId, storageId, forceProxyIO).get();
@@ -67,13 +91,73 @@ helpers::FileHandlePtr FuseFileHandle::getHelperHandle(
         throw std::errc::resource_unavailable_try_again; // NOLINT
     }
 
+    it = m_helperHandles.find(key);
+    if (it != m_helperHandles.end()) {
+        if (it->second.forceProxyIO == forceProxyIO &&
+            it->second.helper == helper) {
+            it->second.accessGeneration = accessGeneration;
+            return it->second.handle;
+        }
+
+        LOG_DBG(1) << "Switching helper handle of file " << uuid
+                   << " on storage " << storageId << " to "
+                   << (forceProxyIO ? "forced proxy" : "newly detected")
+                   << " storage access";
+
+        auto replacedHandle = std::move(it->second.handle);
+        m_helperHandles.erase(it);
+        retireHelperHandle(std::move(replacedHandle));
+    }
+
+    const auto filteredFlags = m_flags & (~O_CREAT) & (~O_APPEND);
+
+    auto handle = communication::wait(
+        helper->open(fileId, filteredFlags, makeParameters(uuid)),
+        m_providerTimeout);
+
+    m_helperHandles[key] =
+        HelperHandle{handle, std::move(helper), forceProxyIO, accessGeneration};
+    return handle;
+}
+
+helpers::FileHandlePtr FuseFileHandle::getProxyHelperHandle(
+    const folly::fbstring &uuid, const folly::fbstring &spaceId,
+    const folly::fbstring &storageId, const folly::fbstring &fileId)
+{
+    LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(storageId) << LOG_FARG(fileId);
+
+    const auto key = std::make_tuple(storageId, fileId);
+
+    // Concurrent hedged reads of a location share a single proxy handle
+    waitForPendingOpen(m_pendingProxyOpens, key);
+
+    auto it = m_proxyHelperHandles.find(key);
+    if (it != m_proxyHelperHandles.end())
+        return it->second;
+
+    auto pendingOpen = std::make_shared<folly::SharedPromise<folly::Unit>>();
+    m_pendingProxyOpens.emplace(key, pendingOpen);
+    SCOPE_EXIT
+    {
+        m_pendingProxyOpens.erase(key);
+        pendingOpen->setValue();
+    };
+
+    auto helper = m_helpersCache.get(uuid, spaceId, storageId, true).get();
+
+    if (!helper) {
+        LOG(ERROR) << "Could not create proxy storage helper for file "
+                   << uuid << " on storage " << storageId;
+        throw std::errc::resource_unavailable_try_again; // NOLINT
+    }
+
     const auto filteredFlags = m_flags & (~O_CREAT) & (~O_APPEND);
 
     auto handle = communication::wait(
         helper->open(fileId, filteredFlags, makeParameters(uuid)),
         m_providerTimeout);
 
-    m_helperHandles[key] = handle;
+    m_proxyHelperHandles[key] = handle;
     return handle;
 }
 
@@ -82,13 +166,20 @@ void FuseFileHandle::releaseHelperHandle(const folly::fbstring &uuid,
 {
     LOG_FCALL() << LOG_FARG(uuid) << LOG_FARG(storageId) << LOG_FARG(fileId);
 
-    for (bool forceProxyIO : {true, false}) {
-        const auto key = std::make_tuple(storageId, fileId, forceProxyIO);
-        auto it = m_helperHandles.find(key);
-        if (it != m_helperHandles.end()) {
-            communication::wait(it->second->release(), m_providerTimeout);
-            m_helperHandles.erase(key);
-        }
+    const auto key = std::make_tuple(storageId, fileId);
+    waitForPendingOpen(m_pendingOpens, key);
+    waitForPendingOpen(m_pendingProxyOpens, key);
+
+    auto it = m_helperHandles.find(key);
+    if (it != m_helperHandles.end()) {
+        communication::wait(it->second.handle->release(), m_providerTimeout);
+        m_helperHandles.erase(key);
+    }
+
+    auto proxyIt = m_proxyHelperHandles.find(key);
+    if (proxyIt != m_proxyHelperHandles.end()) {
+        communication::wait(proxyIt->second->release(), m_providerTimeout);
+        m_proxyHelperHandles.erase(proxyIt);
     }
 }
 
@@ -96,10 +187,74 @@ folly::fbvector<helpers::FileHandlePtr> FuseFileHandle::helperHandles() const
 {
     folly::fbvector<helpers::FileHandlePtr> result;
     for (auto &elem : m_helperHandles)
+        result.emplace_back(elem.second.handle);
+    for (auto &elem : m_proxyHelperHandles)
         result.emplace_back(elem.second);
+    for (auto &handle : m_retiredHelperHandles)
+        result.emplace_back(handle);
     return result;
 }
 
+void FuseFileHandle::retireHelperHandle(helpers::FileHandlePtr handle)
+{
+    // Wait for writes still in progress through the old handle, so that the
+    // flush writes out all their data before any new data is written through
+    // the new handle and older data cannot overwrite it. New writes wait for
+    // the new handle, and reads do not have to be waited for.
+    const auto deadline = std::chrono::steady_clock::now() + m_providerTimeout;
+    while (m_writesInProgress > 0 &&
+        std::chrono::steady_clock::now() < deadline) {
+        folly::fibers::Baton baton;
+        baton.timed_wait(FSLOGIC_RETIRED_HANDLE_POLL_INTERVAL);
+    }
+
+    try {
+        communication::wait(handle->flush(), handle->timeout());
+    }
+    catch (const std::exception &e) {
+        LOG(ERROR) << "Failed to flush replaced helper handle: " << e.what();
+    }
+
+    // Handles still used by reads in progress are released later
+    m_retiredHelperHandles.emplace_back(std::move(handle));
+    releaseRetiredHelperHandles();
+}
+
+void FuseFileHandle::waitForPendingOpen(
+    const PendingOpens &pendingOpens, const HelperHandleKey &key)
+{
+    auto it = pendingOpens.find(key);
+    while (it != pendingOpens.end()) {
+        auto pendingOpen = it->second;
+        pendingOpen->getFuture().wait();
+        it = pendingOpens.find(key);
+    }
+}
+
+void FuseFileHandle::releaseRetiredHelperHandles()
+{
+    // Handles still referenced elsewhere are used by IO operations in
+    // progress and are released on a later call or when the file is closed
+    auto it = std::partition(m_retiredHelperHandles.begin(),
+        m_retiredHelperHandles.end(),
+        [](const helpers::FileHandlePtr &handle) {
+            return handle.use_count() > 1;
+        });
+
+    for (auto released = it; released != m_retiredHelperHandles.end();
+         ++released) {
+        try {
+            communication::wait((*released)->release(), m_providerTimeout);
+        }
+        catch (const std::exception &e) {
+            LOG(WARNING) << "Failed to release replaced helper handle: "
+                         << e.what();
+        }
+    }
+
+    m_retiredHelperHandles.erase(it, m_retiredHelperHandles.end());
+}
+
 folly::Optional<folly::fbstring> FuseFileHandle::providerHandleId() const
 {
     return m_handleId;
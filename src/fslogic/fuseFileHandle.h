@@ -19,6 +19,7 @@
 #include <folly/Optional.h>
 #include <folly/Synchronized.h>
 #include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
 
 #include <unordered_map>
 
@@ -57,6 +58,13 @@ public:
 
     /**
      * Retrieves a helper handle for an open file.
+     * If a different helper has become available for the location since the
+     * handle has been open, i.e. direct access to the storage has been
+     * detected or proxy IO has been forced for the file, the handle is
+     * replaced with one open using the new helper. The replaced handle is
+     * flushed after writes in progress complete, before the new handle is
+     * open, and released as soon as reads using it complete. Handles of
+     * a location are open and replaced by one caller at a time.
      * @param uuid Uuid of the file.
      * @param spaceId Id of the space for which the helper should be returned.
      * @param storageId ID of the storage of the file.
@@ -68,7 +76,21 @@ public:
         const folly::fbstring &fileId);
 
     /**
-     * Releases an open helper handle for a file.
+     * Retrieves a helper handle for an open file, which accesses the storage
+     * via proxy regardless of the storage access type detected for the
+     * location. Used as an alternate path for hedged reads.
+     * @param uuid Uuid of the file.
+     * @param spaceId Id of the space for which the helper should be returned.
+     * @param storageId ID of the storage of the file.
+     * @param fileId ID of a file on the storage.
+     * @returns A new or cached proxy file handle for the location.
+     */
+    helpers::FileHandlePtr getProxyHelperHandle(const folly::fbstring &uuid,
+        const folly::fbstring &spaceId, const folly::fbstring &storageId,
+        const folly::fbstring &fileId);
+
+    /**
+     * Releases open helper handles for a file, including its proxy handle.
      * @todo @c getHelperHandle could return a releaseable object instead that
      * would wrap a @c FileHandlePtr .
      * @param uuid Uuid of the file.
@@ -78,13 +100,25 @@ public:
     void releaseHelperHandle(const folly::fbstring &uuid,
         const folly::fbstring &storageId, const folly::fbstring &fileId);
 
+    /**
+     * Marks a write through a helper handle of the file as in progress.
+     * Replacing a helper handle waits for such writes to complete.
+     */
+    void beginWrite() { ++m_writesInProgress; }
+
+    /**
+     * Marks a write started with @c beginWrite as completed.
+     */
+    void endWrite() { --m_writesInProgress; }
+
     /**
      * @returns Open flags with which the handle was created.
      */
     int flags() const { return m_flags; }
 
     /**
-     * @returns All helper file handles open in this handle.
+     * @returns All helper file handles open in this handle, including proxy
+     * handles and replaced handles which have not been released yet.
      */
     folly::fbvector<helpers::FileHandlePtr> helperHandles() const;
 
@@ -126,17 +160,41 @@ public:
     bool isOnModifyTagSet() { return m_tagOnModifySet; }
 
 private:
+    struct HelperHandle {
+        helpers::FileHandlePtr handle;
+        std::shared_ptr<helpers::StorageHelper> helper;
+        bool forceProxyIO;
+        std::size_t accessGeneration;
+    };
+
+    using HelperHandleKey = std::tuple<folly::fbstring, folly::fbstring>;
+    using PendingOpens = std::unordered_map<HelperHandleKey,
+        std::shared_ptr<folly::SharedPromise<folly::Unit>>>;
+
     std::unordered_map<folly::fbstring, folly::fbstring> makeParameters(
         const folly::fbstring &uuid);
 
+    void retireHelperHandle(helpers::FileHandlePtr handle);
+
+    static void waitForPendingOpen(
+        const PendingOpens &pendingOpens, const HelperHandleKey &key);
+
+    void releaseRetiredHelperHandles();
+
     const int m_flags;
     folly::fbstring m_handleId;
     std::shared_ptr<cache::LRUMetadataCache::OpenFileToken> m_openFileToken;
     cache::HelpersCache &m_helpersCache;
     cache::ForceProxyIOCache &m_forceProxyIOCache;
-    std::unordered_map<std::tuple<folly::fbstring, folly::fbstring, bool>,
-        helpers::FileHandlePtr>
-        m_helperHandles;
+    std::unordered_map<HelperHandleKey, HelperHandle> m_helperHandles;
+    std::unordered_map<HelperHandleKey, helpers::FileHandlePtr>
+        m_proxyHelperHandles;
+    // Helper handles being open or replaced, fulfilled once done
+    PendingOpens m_pendingOpens;
+    PendingOpens m_pendingProxyOpens;
+    // Replaced helper handles, which may still be used by reads in progress
+    folly::fbvector<helpers::FileHandlePtr> m_retiredHelperHandles;
+    std::atomic<std::size_t> m_writesInProgress{0};
     const std::chrono::seconds m_providerTimeout;
     boost::icl::discrete_interval<off_t> m_lastPrefetch;
     std::atomic<bool> m_fullPrefetchTriggered;
@@ -0,0 +1,191 @@
+/**
+ * @file hedgedReadPolicy.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "hedgedReadPolicy.h"
+
+#include "logging.h"
+#include "monitoring/monitoring.h"
+
+#include <algorithm>
+
+namespace one {
+namespace client {
+namespace fslogic {
+
+struct HedgedReadPolicy::HedgedRead {
+    folly::Promise<folly::IOBufQueue> promise;
+    std::mutex mutex;
+    bool done = false;
+    int pending = 1;
+    folly::exception_wrapper primaryError;
+    folly::exception_wrapper alternateError;
+};
+
+HedgedReadPolicy::HedgedReadPolicy(
+    bool enabled, unsigned int percentile, unsigned int budget)
+    : m_enabled{enabled}
+    , m_percentile{std::min(percentile, 100u)}
+    , m_budget{budget}
+{
+    m_latencies.reserve(HEDGED_READ_LATENCY_SAMPLES);
+}
+
+folly::Future<folly::IOBufQueue> HedgedReadPolicy::read(
+    ReadFunction primary, ReadFunction alternate)
+{
+    if (!m_enabled)
+        return folly::makeFutureWith(std::move(primary));
+
+    {
+        std::lock_guard<std::mutex> guard{m_mutex};
+        m_availableBudget = std::min(
+            m_availableBudget + m_budget, HEDGED_READ_MAX_BUDGET * 100);
+    }
+
+    auto hedgedRead = std::make_shared<HedgedRead>();
+    auto future = hedgedRead->promise.getFuture();
+
+    const auto start = std::chrono::steady_clock::now();
+    auto self = shared_from_this();
+
+    folly::makeFutureWith(std::move(primary))
+        .then([self, hedgedRead, start](
+                  folly::Try<folly::IOBufQueue> &&result) mutable {
+            if (result.hasValue()) {
+                self->recordLatency(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start));
+            }
+            self->complete(std::move(hedgedRead), std::move(result), true);
+        });
+
+    const auto hedgeDelay = delay();
+    if (hedgeDelay == std::chrono::microseconds::max())
+        return future;
+
+    // The timekeeper has a millisecond resolution
+    const auto hedgeDelayMs = std::max(std::chrono::milliseconds{1},
+        std::chrono::duration_cast<std::chrono::milliseconds>(hedgeDelay));
+
+    folly::futures::sleep(hedgeDelayMs)
+        .then([self, hedgedRead, alternate = std::move(alternate)](
+                  folly::Try<folly::Unit> &&) mutable {
+            self->hedge(std::move(hedgedRead), std::move(alternate));
+        });
+
+    return future;
+}
+
+void HedgedReadPolicy::hedge(
+    std::shared_ptr<HedgedRead> hedgedRead, ReadFunction alternate)
+{
+    {
+        std::lock_guard<std::mutex> guard{hedgedRead->mutex};
+        if (hedgedRead->done || !acquireBudget())
+            return;
+
+        ++hedgedRead->pending;
+    }
+
+    LOG_DBG(2) << "Issuing hedged read after primary read exceeded "
+               << delay().count() << " us";
+
+    ONE_METRIC_COUNTER_INC("comp.oneclient.mod.fslogic.hedgedread.issued");
+
+    auto self = shared_from_this();
+    folly::makeFutureWith(std::move(alternate))
+        .then([self, hedgedRead](
+                  folly::Try<folly::IOBufQueue> &&result) mutable {
+            self->complete(std::move(hedgedRead), std::move(result), false);
+        });
+}
+
+void HedgedReadPolicy::complete(std::shared_ptr<HedgedRead> hedgedRead,
+    folly::Try<folly::IOBufQueue> &&result, bool primary)
+{
+    std::unique_lock<std::mutex> lock{hedgedRead->mutex};
+    if (hedgedRead->done)
+        return;
+
+    --hedgedRead->pending;
+
+    if (result.hasValue()) {
+        hedgedRead->done = true;
+        lock.unlock();
+
+        if (!primary) {
+            ONE_METRIC_COUNTER_INC(
+                "comp.oneclient.mod.fslogic.hedgedread.won");
+        }
+
+        hedgedRead->promise.setValue(std::move(result.value()));
+        return;
+    }
+
+    if (primary)
+        hedgedRead->primaryError = std::move(result.exception());
+    else
+        hedgedRead->alternateError = std::move(result.exception());
+
+    // Wait for the other read, if it is in progress
+    if (hedgedRead->pending > 0)
+        return;
+
+    hedgedRead->done = true;
+    auto error = hedgedRead->primaryError ? hedgedRead->primaryError
+                                          : hedgedRead->alternateError;
+    lock.unlock();
+
+    hedgedRead->promise.setException(std::move(error));
+}
+
+void HedgedReadPolicy::recordLatency(std::chrono::microseconds latency)
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+
+    if (m_latencies.size() < HEDGED_READ_LATENCY_SAMPLES)
+        m_latencies.emplace_back(latency.count());
+    else
+        m_latencies[m_nextLatency] = latency.count();
+
+    m_nextLatency = (m_nextLatency + 1) % HEDGED_READ_LATENCY_SAMPLES;
+
+    if (m_latencies.size() < HEDGED_READ_MIN_LATENCY_SAMPLES)
+        return;
+
+    // Recalculating the percentile requires a copy of the samples, so it is
+    // done only periodically once the first delay is known
+    const bool delayKnown =
+        m_delay != std::chrono::microseconds::max().count();
+    if (delayKnown &&
+        ++m_latenciesSinceUpdate < HEDGED_READ_DELAY_UPDATE_INTERVAL)
+        return;
+
+    m_latenciesSinceUpdate = 0;
+
+    auto latencies = m_latencies;
+    const auto nth = std::min(latencies.size() * m_percentile / 100,
+        latencies.size() - 1);
+    std::nth_element(latencies.begin(), latencies.begin() + nth,
+        latencies.end());
+
+    m_delay = latencies[nth];
+}
+
+bool HedgedReadPolicy::acquireBudget()
+{
+    std::lock_guard<std::mutex> guard{m_mutex};
+    if (m_availableBudget < 100)
+        return false;
+
+    m_availableBudget -= 100;
+    return true;
+}
+
+} // namespace fslogic
+} // namespace client
+} // namespace one
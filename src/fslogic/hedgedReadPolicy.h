@@ -0,0 +1,115 @@
+/**
+ * @file hedgedReadPolicy.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <folly/futures/Future.h>
+#include <folly/io/IOBufQueue.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace one {
+namespace client {
+namespace fslogic {
+
+constexpr std::size_t HEDGED_READ_LATENCY_SAMPLES = 1024;
+constexpr std::size_t HEDGED_READ_MIN_LATENCY_SAMPLES = 32;
+constexpr std::size_t HEDGED_READ_DELAY_UPDATE_INTERVAL = 64;
+constexpr unsigned int HEDGED_READ_MAX_BUDGET = 10;
+
+/**
+ * @c HedgedReadPolicy performs reads which, if not completed within
+ * a percentile of recent read latencies, are repeated using an alternate
+ * read function, e.g. via proxy instead of direct storage access. The first
+ * successful result is returned.
+ *
+ * Hedged reads are limited by a budget, which grows by the budget percentage
+ * of a hedged read with each read and is capped at
+ * @c HEDGED_READ_MAX_BUDGET hedged reads, so that a slow storage cannot double
+ * the load on the alternate path.
+ */
+class HedgedReadPolicy
+    : public std::enable_shared_from_this<HedgedReadPolicy> {
+public:
+    using ReadFunction = std::function<folly::Future<folly::IOBufQueue>()>;
+
+    /**
+     * Constructor.
+     * @param enabled Whether reads should be hedged.
+     * @param percentile Percentile of recent read latencies after which the
+     * alternate read is issued.
+     * @param budget Maximum number of hedged reads, as a percentage of reads.
+     */
+    HedgedReadPolicy(
+        bool enabled, unsigned int percentile, unsigned int budget);
+
+    /**
+     * @return Whether reads are hedged.
+     */
+    bool enabled() const { return m_enabled; }
+
+    /**
+     * Performs a read using the primary function. If it does not complete
+     * within the current hedging delay and the budget allows, the alternate
+     * function is also called. If both reads fail, the error of the primary
+     * read is returned.
+     * @param primary Primary read function.
+     * @param alternate Alternate read function.
+     * @return Future result of the first successful read.
+     */
+    folly::Future<folly::IOBufQueue> read(
+        ReadFunction primary, ReadFunction alternate);
+
+    /**
+     * @return Delay after which reads are hedged, or
+     * @c std::chrono::microseconds::max() if not enough read latencies have
+     * been recorded yet.
+     */
+    std::chrono::microseconds delay() const
+    {
+        return std::chrono::microseconds{m_delay.load()};
+    }
+
+    /**
+     * Records latency of a completed primary read.
+     * @param latency Latency of the read.
+     */
+    void recordLatency(std::chrono::microseconds latency);
+
+private:
+    struct HedgedRead;
+
+    void complete(std::shared_ptr<HedgedRead> hedgedRead,
+        folly::Try<folly::IOBufQueue> &&result, bool primary);
+
+    void hedge(std::shared_ptr<HedgedRead> hedgedRead, ReadFunction alternate);
+
+    bool acquireBudget();
+
+    const bool m_enabled;
+    const unsigned int m_percentile;
+    const unsigned int m_budget;
+
+    std::mutex m_mutex;
+    std::vector<std::int64_t> m_latencies;
+    std::size_t m_nextLatency = 0;
+    std::size_t m_latenciesSinceUpdate = 0;
+    // Available budget in percents of a hedged read
+    unsigned int m_availableBudget = 0;
+    std::atomic<std::int64_t> m_delay{
+        std::chrono::microseconds::max().count()};
+};
+
+} // namespace fslogic
+} // namespace client
+} // namespace one
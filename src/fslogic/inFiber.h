@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "interrupt.h"
+
 #include <boost/preprocessor.hpp>
 #include <folly/FBString.h>
 #include <folly/Function.h>
@@ -68,10 +70,13 @@ public:
 
     /**
      * Destructor.
-     * Stops the fiber worker thread.
+     * Stops FsLogic inside the fiber and then the fiber worker thread.
      */
     ~InFiber()
     {
+        m_fiberManager.addTaskRemoteFuture([this] { m_fsLogic.stop(); })
+            .wait();
+
         m_eventBase.terminateLoopSoon();
         m_thread.join();
     }
@@ -98,7 +103,8 @@ public:
             const folly::fbstring &))
 
     WRAP(read,
-        (const fuse_ino_t)(const std::uint64_t)(const off_t)(const std::size_t))
+        (const fuse_ino_t)(const std::uint64_t)(const off_t)(const std::size_t)(
+            std::shared_ptr<Interrupt>))
 
     WRAP(write,
         (const fuse_ino_t)(const std::uint64_t)(const std::size_t)(
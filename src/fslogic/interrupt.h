@@ -0,0 +1,104 @@
+/**
+ * @file interrupt.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
+
+#include <atomic>
+#include <memory>
+#include <system_error>
+
+namespace one {
+namespace client {
+namespace fslogic {
+
+/**
+ * @c Interrupt represents interruption of a FUSE request, e.g. when the
+ * process which issued the request has been sent a signal. Futures awaited on
+ * behalf of the request can be made interruptible, so that the request fails
+ * with @c EINTR as soon as it is interrupted instead of waiting for
+ * a response which is no longer needed.
+ */
+class Interrupt {
+public:
+    /**
+     * Marks the request as interrupted and fails all futures made
+     * interruptible with @c EINTR.
+     */
+    void interrupt()
+    {
+        if (!m_interrupted.exchange(true))
+            m_promise.setValue();
+    }
+
+    /**
+     * @return Whether the request has been interrupted.
+     */
+    bool interrupted() const { return m_interrupted; }
+
+    /**
+     * Throws @c EINTR if the request has been interrupted.
+     */
+    void check() const
+    {
+        if (interrupted())
+            throw std::system_error{
+                std::make_error_code(std::errc::interrupted)};
+    }
+
+    /**
+     * Makes a future interruptible.
+     * @param future Future to wrap.
+     * @return Future fulfilled with the result of @p future, or failed with
+     * @c EINTR if the request is interrupted first.
+     */
+    template <typename T>
+    folly::Future<T> interruptible(folly::Future<T> future)
+    {
+        auto promise = std::make_shared<folly::Promise<T>>();
+        auto done = std::make_shared<std::atomic<bool>>(false);
+        auto result = promise->getFuture();
+
+        std::move(future).then([promise, done](folly::Try<T> &&value) {
+            if (!done->exchange(true))
+                promise->setTry(std::move(value));
+        });
+
+        m_promise.getFuture().then([promise, done] {
+            if (!done->exchange(true))
+                promise->setException(std::system_error{
+                    std::make_error_code(std::errc::interrupted)});
+        });
+
+        return result;
+    }
+
+private:
+    std::atomic<bool> m_interrupted{false};
+    folly::SharedPromise<folly::Unit> m_promise;
+};
+
+/**
+ * Makes a future interruptible by a request interrupt, if there is one.
+ * @param future Future to wrap.
+ * @param interrupt Interrupt of the request or nullptr.
+ */
+template <typename T>
+folly::Future<T> interruptible(
+    folly::Future<T> future, const std::shared_ptr<Interrupt> &interrupt)
+{
+    if (!interrupt)
+        return future;
+
+    return interrupt->interruptible(std::move(future));
+}
+
+} // namespace fslogic
+} // namespace client
+} // namespace one
@@ -10,9 +10,11 @@
 
 #include "attrs.h"
 #include "cache/inodeCache.h"
+#include "interrupt.h"
 #include "ioTraceLogger.h"
 #include "logging.h"
 #include "messages/fuse/fileAttr.h"
+#include "options/options.h"
 
 #include <folly/FBString.h>
 #include <folly/io/IOBufQueue.h>
@@ -37,10 +39,20 @@ constexpr auto WITHUUIDS_RETRY_COUNT = 4;
 template <typename FsLogicT> class WithUuids {
 public:
     template <typename... Args>
-    WithUuids(folly::fbstring rootUuid, Args &&... args)
-        : m_inodeCache{std::move(rootUuid)}
-        , m_generation{std::chrono::system_clock::to_time_t(
-              std::chrono::system_clock::now())}
+    WithUuids(folly::fbstring rootUuid, const options::Options &options,
+        Args &&... args)
+        : m_inodeCache{std::move(rootUuid), cache::DEFAULT_INODE_CACHE_SIZE,
+              cache::parseEvictionPolicyType(
+                  options.getMetadataCacheEvictionPolicy()),
+              options.areStableInodesEnabled(),
+              options.getInodeTablePath().get_value_or({})}
+        // Inodes which outlive the mount must keep their generation, so that
+        // file handles held by NFS clients remain valid
+        , m_generation{options.areStableInodesEnabled() ||
+                      options.getInodeTablePath()
+                  ? 0
+                  : std::chrono::system_clock::to_time_t(
+                        std::chrono::system_clock::now())}
         , m_fsLogic{std::forward<Args>(args)...}
     {
         m_fsLogic.onMarkDeleted(std::bind(&cache::InodeCache::markDeleted,
@@ -54,7 +66,10 @@ public:
     {
         LOG_FCALL() << LOG_FARG(ino) << LOG_FARG(name);
 
-        FileAttrPtr attr = wrap(&FsLogicT::lookup, ino, name);
+        // Kernel looks up '.' to resolve inodes from NFS file handles
+        FileAttrPtr attr = name == "."
+            ? wrap(&FsLogicT::getattr, ino)
+            : wrap(&FsLogicT::lookup, ino, name);
         return toEntry(std::move(attr));
     }
 
@@ -88,14 +103,15 @@ public:
     }
 
     auto read(const fuse_ino_t ino, const std::uint64_t handle,
-        const off_t offset, const std::size_t size)
+        const off_t offset, const std::size_t size,
+        std::shared_ptr<Interrupt> interrupt = {})
     {
         LOG_FCALL() << LOG_FARG(ino) << LOG_FARG(handle) << LOG_FARG(offset)
                     << LOG_FARG(size);
 
         return wrap(&FsLogicT::read, ino, handle, offset, size,
             folly::Optional<folly::fbstring>{}, WITHUUIDS_RETRY_COUNT,
-            std::unique_ptr<IOTraceRead>{});
+            std::unique_ptr<IOTraceRead>{}, std::move(interrupt));
     }
 
     auto write(const fuse_ino_t ino, const std::uint64_t handle,
@@ -229,6 +245,8 @@ public:
         return m_fsLogic.isFullBlockReadForced();
     }
 
+    void stop() { m_fsLogic.stop(); }
+
 private:
     template <typename Ret, typename... FunArgs, typename... Args>
     inline constexpr Ret wrap(
@@ -44,13 +44,17 @@
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <chrono>
 #include <exception>
 #include <future>
 #include <iostream>
 #include <memory>
 #include <random>
 #include <regex>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace one;             // NOLINT
 using namespace one::client;     // NOLINT
@@ -203,6 +207,51 @@ int startPerformanceMonitoring(std::shared_ptr<options::Options> options)
     return EXIT_SUCCESS;
 }
 
+/**
+ * Measures durations of consecutive startup phases, so that the time to
+ * mount can be broken down in the log.
+ */
+class StartupTimer {
+public:
+    /**
+     * Ends the current phase.
+     * @param phase Name of the phase.
+     */
+    void mark(const char *phase)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        m_phases.emplace_back(phase, now - m_last);
+        m_last = now;
+    }
+
+    /**
+     * Logs durations of all phases and the total startup time.
+     */
+    void report() const
+    {
+        std::stringstream timing;
+        for (const auto &phase : m_phases)
+            timing << phase.first << "=" << toMillis(phase.second) << " ";
+
+        LOG(INFO) << "Startup timing [ms]: " << timing.str()
+                  << "total=" << toMillis(m_last - m_start);
+    }
+
+private:
+    static auto toMillis(const std::chrono::steady_clock::duration d)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(d)
+            .count();
+    }
+
+    const std::chrono::steady_clock::time_point m_start =
+        std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point m_last = m_start;
+    std::vector<
+        std::pair<const char *, std::chrono::steady_clock::duration>>
+        m_phases;
+};
+
 std::string generateSessionId()
 {
     std::random_device rd;
@@ -296,7 +345,7 @@ std::shared_ptr<messages::Configuration> getConfiguration(
     catch (const std::exception &e) {
         std::cerr << "Connection error: '" << e.what() << "'. Aborting..."
                   << std::endl;
-        exit(EXIT_FAILURE);
+        return {};
     }
 }
 
@@ -372,14 +421,29 @@ int main(int argc, char *argv[])
         std::cout << options->formatDeprecated();
     }
 
+    try {
+        cache::parseEvictionPolicyType(
+            options->getMetadataCacheEvictionPolicy());
+    }
+    catch (const std::invalid_argument &e) {
+        std::cerr << e.what() << "\n"
+                  << "See '" << argv[0] << " --help'." << std::endl;
+        return EXIT_FAILURE;
+    }
+
     startLogging(argv[0], options);
+    StartupTimer startupTimer;
 
     context->setScheduler(
         std::make_shared<Scheduler>(options->getSchedulerThreadCount()));
 
     auto authManager = getAuthManager(context);
     auto sessionId = generateSessionId();
-    auto configuration = getConfiguration(sessionId, authManager, context);
+
+    // Handshake and fetch the configuration while FUSE is being set up. Both
+    // have to be done before daemonizing, as threads do not survive fork()
+    auto configurationFuture = std::async(std::launch::async,
+        [&] { return getConfiguration(sessionId, authManager, context); });
 
     auto fuse_oper = fuseOperations();
     auto args = options->getFuseArgs(argv[0]);
@@ -421,6 +485,14 @@ int main(int argc, char *argv[])
     fuse_session_add_chan(fuse, ch);
     ScopeExit removeChannel{[&] { fuse_session_remove_chan(ch); }};
 
+    startupTimer.mark("fuse");
+
+    auto configuration = configurationFuture.get();
+    if (!configuration)
+        return EXIT_FAILURE;
+
+    startupTimer.mark("configuration");
+
     std::cout << "Oneclient has been successfully mounted in '"
               << options->getMountpoint().c_str() << "'." << std::endl;
 
@@ -444,22 +516,34 @@ int main(int argc, char *argv[])
         FLAGS_stderrthreshold = options->getDebug() ? 0 : 1;
     }
 
+    startupTimer.mark("daemonize");
+
     if (startPerformanceMonitoring(options) != EXIT_SUCCESS)
         return EXIT_FAILURE;
 
     auto communicator = getCommunicator(sessionId, authManager, context);
     context->setCommunicator(communicator);
+
+    // Start storage helper workers while the connection pool is established
+    auto helpersCacheFuture = std::async(std::launch::async, [&] {
+        return std::make_unique<cache::HelpersCache>(
+            *communicator, *context->scheduler(), *options);
+    });
+
     communicator->connect();
+    auto helpersCache = helpersCacheFuture.get();
 
-    auto helpersCache = std::make_unique<cache::HelpersCache>(
-        *communicator, *context->scheduler(), *options);
+    startupTimer.mark("connection");
 
     const auto &rootUuid = configuration->rootUuid();
-    fsLogic = std::make_unique<fslogic::Composite>(rootUuid, std::move(context),
-        std::move(configuration), std::move(helpersCache),
+    fsLogic = std::make_unique<fslogic::Composite>(rootUuid, *options,
+        std::move(context), std::move(configuration), std::move(helpersCache),
         options->getMetadataCacheSize(), options->areFileReadEventsDisabled(),
         options->isFullblockReadForced(), options->getProviderTimeout());
 
+    startupTimer.mark("fslogic");
+    startupTimer.report();
+
     res = (multithreaded != 0) ? fuse_session_loop_mt(fuse)
                                : fuse_session_loop(fuse);
 
@@ -0,0 +1,38 @@
+/**
+ * @file dirCreated.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "dirCreated.h"
+
+#include "messages.pb.h"
+
+#include <sstream>
+
+namespace one {
+namespace messages {
+namespace fuse {
+
+DirCreated::DirCreated(std::unique_ptr<ProtocolServerMessage> serverMessage)
+    : FuseResponse{serverMessage}
+{
+    if (serverMessage->fuse_response().has_file_attr())
+        m_attr.emplace(serverMessage->fuse_response().file_attr());
+}
+
+std::string DirCreated::toString() const
+{
+    std::stringstream stream;
+    stream << "type: 'DirCreated', attr: ";
+    if (m_attr)
+        stream << m_attr->toString();
+    else
+        stream << "none";
+    return stream.str();
+}
+
+} // namespace fuse
+} // namespace messages
+} // namespace one
@@ -0,0 +1,46 @@
+/**
+ * @file dirCreated.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include "fileAttr.h"
+#include "fuseResponse.h"
+
+#include <folly/Optional.h>
+
+namespace one {
+namespace messages {
+namespace fuse {
+
+/**
+ * The @c DirCreated class represents server response to the @c CreateDir
+ * request. Depending on the provider version the response carries either only
+ * the status or the attributes of the newly created directory.
+ */
+class DirCreated : public FuseResponse {
+public:
+    /**
+     * Constructor.
+     * @param serverMessage Protocol Buffers message representing
+     * @c DirCreated counterpart.
+     */
+    DirCreated(std::unique_ptr<ProtocolServerMessage> serverMessage);
+
+    /**
+     * @return Attributes of the created directory, if sent by the provider.
+     */
+    const folly::Optional<FileAttr> &attr() const { return m_attr; }
+
+    std::string toString() const override;
+
+private:
+    folly::Optional<FileAttr> m_attr;
+};
+
+} // namespace fuse
+} // namespace messages
+} // namespace one
@@ -0,0 +1,311 @@
+/**
+ * @file fileBlocksMap.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "fileBlocksMap.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace one {
+namespace messages {
+namespace fuse {
+
+void FileBlocksMap::add(
+    const off_t start, const off_t end, const FileBlock &block)
+{
+    if (start >= end)
+        return;
+
+    const auto id = intern(block);
+    const auto first = firstEndingAfter(start);
+
+    std::vector<Entry> segments;
+    auto cursor = start;
+    auto last = first;
+    for (; last < m_entries.size() && m_entries[last].start < end; ++last) {
+        const auto &entry = m_entries[last];
+        if (entry.start < start)
+            segments.push_back({entry.start, start, entry.block});
+        else if (cursor < entry.start)
+            segments.push_back({cursor, entry.start, id});
+
+        segments.push_back({std::max(entry.start, start),
+            std::min(entry.end, end), aggregate(entry.block, id)});
+
+        if (entry.end > end)
+            segments.push_back({end, entry.end, entry.block});
+
+        cursor = entry.end;
+    }
+
+    if (cursor < end)
+        segments.push_back({cursor, end, id});
+
+    splice(first, last, std::move(segments));
+}
+
+void FileBlocksMap::erase(const off_t start, const off_t end)
+{
+    if (start >= end)
+        return;
+
+    const auto first = firstEndingAfter(start);
+    const auto last = firstStartingAt(first, end);
+    if (first == last)
+        return;
+
+    std::vector<Entry> segments;
+    if (m_entries[first].start < start)
+        segments.push_back(
+            {m_entries[first].start, start, m_entries[first].block});
+
+    if (m_entries[last - 1].end > end)
+        segments.push_back(
+            {end, m_entries[last - 1].end, m_entries[last - 1].block});
+
+    splice(first, last, std::move(segments));
+}
+
+void FileBlocksMap::update(
+    const off_t start, const off_t end, const FileBlocksMap &other)
+{
+    if (start >= end)
+        return;
+
+    const auto first = firstEndingAfter(start);
+    const auto last = firstStartingAt(first, end);
+
+    std::vector<Entry> segments;
+    if (first < last && m_entries[first].start < start)
+        segments.push_back(
+            {m_entries[first].start, start, m_entries[first].block});
+
+    const auto otherFirst = other.firstEndingAfter(start);
+    const auto otherLast = other.firstStartingAt(otherFirst, end);
+    for (auto i = otherFirst; i < otherLast; ++i) {
+        const auto &entry = other.m_entries[i];
+        segments.push_back({std::max(entry.start, start),
+            std::min(entry.end, end), intern(other.m_blocks[entry.block])});
+    }
+
+    if (first < last && m_entries[last - 1].end > end)
+        segments.push_back(
+            {end, m_entries[last - 1].end, m_entries[last - 1].block});
+
+    splice(first, last, std::move(segments));
+}
+
+void FileBlocksMap::intersect(const off_t start, const off_t end)
+{
+    if (start >= end) {
+        clear();
+        return;
+    }
+
+    erase(end, std::numeric_limits<off_t>::max());
+    erase(std::numeric_limits<off_t>::min(), start);
+}
+
+FileBlocksMap FileBlocksMap::intersection(
+    const off_t start, const off_t end) const
+{
+    FileBlocksMap result;
+    if (start >= end)
+        return result;
+
+    const auto first = firstEndingAfter(start);
+    const auto last = firstStartingAt(first, end);
+    for (auto i = first; i < last; ++i) {
+        const auto &entry = m_entries[i];
+        result.add(std::max(entry.start, start), std::min(entry.end, end),
+            m_blocks[entry.block]);
+    }
+
+    return result;
+}
+
+void FileBlocksMap::clear()
+{
+    m_entries.clear();
+    m_blocks.clear();
+    m_length = 0;
+    m_prefixLengths.resize(1);
+    m_prefixLengthsValid = 0;
+}
+
+FileBlocksMap::const_iterator FileBlocksMap::find(const off_t offset) const
+{
+    const auto index = firstEndingAfter(offset);
+    if (index < m_entries.size() && m_entries[index].start <= offset)
+        return {this, index};
+
+    return end();
+}
+
+std::size_t FileBlocksMap::countInRange(
+    const off_t start, const off_t end) const
+{
+    if (start >= end)
+        return 0;
+
+    const auto first = firstEndingAfter(start);
+    return firstStartingAt(first, end) - first;
+}
+
+std::size_t FileBlocksMap::lengthInRange(
+    const off_t start, const off_t end) const
+{
+    if (start >= end)
+        return 0;
+
+    const auto first = firstEndingAfter(start);
+    const auto last = firstStartingAt(first, end);
+    if (first == last)
+        return 0;
+
+    updatePrefixLengths();
+
+    auto result = m_prefixLengths[last] - m_prefixLengths[first];
+    result -= std::max<off_t>(0, start - m_entries[first].start);
+    result -= std::max<off_t>(0, m_entries[last - 1].end - end);
+
+    return result;
+}
+
+std::size_t FileBlocksMap::footprint() const
+{
+    std::size_t result = m_entries.capacity() * sizeof(Entry) +
+        m_prefixLengths.capacity() * sizeof(off_t) +
+        m_blocks.capacity() * sizeof(FileBlock);
+
+    for (const auto &block : m_blocks)
+        result += block.storageId().size() + block.fileId().size();
+
+    return result;
+}
+
+bool FileBlocksMap::operator==(const FileBlocksMap &other) const
+{
+    if (m_entries.size() != other.m_entries.size())
+        return false;
+
+    for (std::size_t i = 0; i < m_entries.size(); ++i) {
+        const auto &entry = m_entries[i];
+        const auto &otherEntry = other.m_entries[i];
+        if (entry.start != otherEntry.start || entry.end != otherEntry.end ||
+            !(m_blocks[entry.block] == other.m_blocks[otherEntry.block]))
+            return false;
+    }
+
+    return true;
+}
+
+FileBlocksMap::value_type FileBlocksMap::at(const std::size_t index) const
+{
+    const auto &entry = m_entries[index];
+    return {Interval::right_open(entry.start, entry.end),
+        m_blocks[entry.block]};
+}
+
+std::uint32_t FileBlocksMap::intern(const FileBlock &block)
+{
+    // Locations usually refer to one or two storages, so a linear search is
+    // faster than hashing the ids
+    auto it = std::find(m_blocks.begin(), m_blocks.end(), block);
+    if (it != m_blocks.end())
+        return static_cast<std::uint32_t>(it - m_blocks.begin());
+
+    m_blocks.emplace_back(block);
+    return static_cast<std::uint32_t>(m_blocks.size() - 1);
+}
+
+std::uint32_t FileBlocksMap::aggregate(
+    const std::uint32_t existing, const std::uint32_t added) const
+{
+    FileBlock result = m_blocks[existing];
+    result += m_blocks[added];
+    return result == m_blocks[existing] ? existing : added;
+}
+
+std::size_t FileBlocksMap::firstEndingAfter(const off_t offset) const
+{
+    return std::partition_point(m_entries.begin(), m_entries.end(),
+               [&](const Entry &entry) { return entry.end <= offset; }) -
+        m_entries.begin();
+}
+
+std::size_t FileBlocksMap::firstStartingAt(
+    const std::size_t from, const off_t offset) const
+{
+    return std::partition_point(m_entries.begin() + from, m_entries.end(),
+               [&](const Entry &entry) { return entry.start < offset; }) -
+        m_entries.begin();
+}
+
+void FileBlocksMap::splice(
+    std::size_t first, std::size_t last, std::vector<Entry> segments)
+{
+    // Join the new segments with touching neighbours mapped to equal blocks
+    if (!segments.empty()) {
+        if (first > 0 && m_entries[first - 1].end == segments.front().start &&
+            m_entries[first - 1].block == segments.front().block) {
+            segments.front().start = m_entries[first - 1].start;
+            --first;
+        }
+
+        if (last < m_entries.size() &&
+            m_entries[last].start == segments.back().end &&
+            m_entries[last].block == segments.back().block) {
+            segments.back().end = m_entries[last].end;
+            ++last;
+        }
+    }
+
+    std::size_t joined = 0;
+    for (const auto &segment : segments) {
+        if (joined > 0 && segments[joined - 1].end == segment.start &&
+            segments[joined - 1].block == segment.block)
+            segments[joined - 1].end = segment.end;
+        else
+            segments[joined++] = segment;
+    }
+    segments.resize(joined);
+
+    for (auto i = first; i < last; ++i)
+        m_length -= m_entries[i].end - m_entries[i].start;
+
+    for (const auto &segment : segments)
+        m_length += segment.end - segment.start;
+
+    // Overwrite replaced entries in place and only shift the tail of the
+    // vector when the number of entries changes
+    const auto replaced = last - first;
+    const auto common = std::min(replaced, segments.size());
+    std::copy_n(segments.begin(), common, m_entries.begin() + first);
+    if (segments.size() > replaced)
+        m_entries.insert(m_entries.begin() + first + common,
+            segments.begin() + common, segments.end());
+    else if (segments.size() < replaced)
+        m_entries.erase(m_entries.begin() + first + common,
+            m_entries.begin() + last);
+
+    m_prefixLengthsValid = std::min(m_prefixLengthsValid, first);
+}
+
+void FileBlocksMap::updatePrefixLengths() const
+{
+    m_prefixLengths.resize(m_entries.size() + 1);
+    for (auto i = m_prefixLengthsValid; i < m_entries.size(); ++i)
+        m_prefixLengths[i + 1] =
+            m_prefixLengths[i] + m_entries[i].end - m_entries[i].start;
+
+    m_prefixLengthsValid = m_entries.size();
+}
+
+} // namespace fuse
+} // namespace messages
+} // namespace one
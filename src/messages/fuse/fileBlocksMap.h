@@ -0,0 +1,221 @@
+/**
+ * @file fileBlocksMap.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#ifndef ONECLIENT_MESSAGES_FUSE_FILE_BLOCKS_MAP_H
+#define ONECLIENT_MESSAGES_FUSE_FILE_BLOCKS_MAP_H
+
+#include "fileBlock.h"
+
+#include <boost/icl/discrete_interval.hpp>
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace one {
+namespace messages {
+namespace fuse {
+
+/**
+ * @c FileBlocksMap maps disjoint ranges of file data to @c FileBlock
+ * instances describing where the data is stored.
+ * Ranges are kept in a vector sorted by offset, with adjacent ranges mapped
+ * to equal blocks joined together. Blocks are interned in a per-map table,
+ * so each range only stores a small index instead of its own copies of
+ * storage and file ids. Lengths of the ranges are prefix-summed lazily,
+ * which allows counting and measuring ranges within an arbitrary interval
+ * in O(log n).
+ * Adding a range which overlaps existing ranges aggregates blocks the way
+ * @c FileBlock::operator+= does, i.e. existing blocks keep their identity
+ * unless they have been default-constructed.
+ */
+class FileBlocksMap {
+    struct Entry {
+        off_t start;
+        off_t end;
+        std::uint32_t block;
+    };
+
+public:
+    using Interval = boost::icl::discrete_interval<off_t>;
+    using value_type = std::pair<Interval, const FileBlock &>;
+
+    /**
+     * Iterator over ranges of the map, dereferencing to pairs of the range
+     * interval and the block mapped to it.
+     */
+    class const_iterator {
+    public:
+        /**
+         * Helper object returned by @c operator->() .
+         */
+        struct Pointer {
+            const value_type *operator->() const { return &value; }
+            value_type value;
+        };
+
+        const_iterator(const FileBlocksMap *map, const std::size_t index)
+            : m_map{map}
+            , m_index{index}
+        {
+        }
+
+        value_type operator*() const { return m_map->at(m_index); }
+
+        Pointer operator->() const { return Pointer{m_map->at(m_index)}; }
+
+        const_iterator &operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        bool operator==(const const_iterator &other) const
+        {
+            return m_index == other.m_index && m_map == other.m_map;
+        }
+
+        bool operator!=(const const_iterator &other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        const FileBlocksMap *m_map;
+        std::size_t m_index;
+    };
+
+    /**
+     * Maps range [start, end) to a block, aggregating it with blocks
+     * already mapped to overlapping ranges.
+     * @param start Offset of the range (inclusive).
+     * @param end End of the range (exclusive).
+     * @param block Block to map.
+     */
+    void add(const off_t start, const off_t end, const FileBlock &block);
+
+    /**
+     * Removes range [start, end) from the map.
+     * @param start Offset of the range (inclusive).
+     * @param end End of the range (exclusive).
+     */
+    void erase(const off_t start, const off_t end);
+
+    /**
+     * Replaces the part of the map within range [start, end) with the part
+     * of another map within that range, in place.
+     * @param start Offset of the range (inclusive).
+     * @param end End of the range (exclusive).
+     * @param other Map from which the ranges are copied.
+     */
+    void update(
+        const off_t start, const off_t end, const FileBlocksMap &other);
+
+    /**
+     * Removes everything outside of range [start, end) from the map.
+     * @param start Offset of the range (inclusive).
+     * @param end End of the range (exclusive).
+     */
+    void intersect(const off_t start, const off_t end);
+
+    /**
+     * @return A map containing only the part of this map within range
+     * [start, end).
+     * @param start Offset of the range (inclusive).
+     * @param end End of the range (exclusive).
+     */
+    FileBlocksMap intersection(const off_t start, const off_t end) const;
+
+    /**
+     * Removes all ranges from the map.
+     */
+    void clear();
+
+    /**
+     * Finds the range containing an offset.
+     * @param offset The offset.
+     * @return Iterator pointing to the range or @c end() if the offset is
+     * not mapped.
+     */
+    const_iterator find(const off_t offset) const;
+
+    /**
+     * @return Number of ranges overlapping range [start, end).
+     * @param start Offset of the range (inclusive).
+     * @param end End of the range (exclusive).
+     */
+    std::size_t countInRange(const off_t start, const off_t end) const;
+
+    /**
+     * @return Number of bytes mapped within range [start, end).
+     * @param start Offset of the range (inclusive).
+     * @param end End of the range (exclusive).
+     */
+    std::size_t lengthInRange(const off_t start, const off_t end) const;
+
+    /**
+     * @return Number of bytes mapped by the whole map.
+     */
+    std::size_t length() const { return m_length; }
+
+    /**
+     * @return Number of separate ranges in the map.
+     */
+    std::size_t size() const { return m_entries.size(); }
+
+    /**
+     * @return Whether the map is empty.
+     */
+    bool empty() const { return m_entries.empty(); }
+
+    /**
+     * @return Approximate number of bytes of heap memory used by the map.
+     */
+    std::size_t footprint() const;
+
+    const_iterator begin() const { return {this, 0}; }
+
+    const_iterator end() const { return {this, m_entries.size()}; }
+
+    /**
+     * Checks two maps for equality of their ranges and blocks.
+     * @param other The other map.
+     */
+    bool operator==(const FileBlocksMap &other) const;
+
+    bool operator!=(const FileBlocksMap &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    value_type at(const std::size_t index) const;
+    std::uint32_t intern(const FileBlock &block);
+    std::uint32_t aggregate(
+        const std::uint32_t existing, const std::uint32_t added) const;
+    std::size_t firstEndingAfter(const off_t offset) const;
+    std::size_t firstStartingAt(
+        const std::size_t from, const off_t offset) const;
+    void splice(
+        std::size_t first, std::size_t last, std::vector<Entry> segments);
+    void updatePrefixLengths() const;
+
+    std::vector<Entry> m_entries;
+    std::vector<FileBlock> m_blocks;
+    std::size_t m_length = 0;
+
+    mutable std::vector<off_t> m_prefixLengths{0};
+    mutable std::size_t m_prefixLengthsValid = 0;
+};
+
+} // namespace fuse
+} // namespace messages
+} // namespace one
+
+#endif // ONECLIENT_MESSAGES_FUSE_FILE_BLOCKS_MAP_H
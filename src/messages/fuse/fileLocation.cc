@@ -10,6 +10,8 @@
 
 #include "messages.pb.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 #include <system_error>
 
@@ -19,6 +21,14 @@ namespace one {
 namespace messages {
 namespace fuse {
 
+namespace {
+std::size_t adjustTotal(
+    const std::size_t total, const std::size_t before, const std::size_t after)
+{
+    return total + after > before ? total + after - before : 0;
+}
+} // namespace
+
 FileLocation::FileLocation(std::unique_ptr<ProtocolServerMessage> serverMessage)
     : FuseResponse{serverMessage}
     , m_version{}
@@ -66,60 +76,90 @@ const FileLocation::FileBlocksMap &FileLocation::blocks() const
     return m_blocks;
 }
 
-unsigned int FileLocation::blocksCount() const
-{
-    return boost::icl::interval_count(m_blocks);
-}
+unsigned int FileLocation::blocksCount() const { return m_blocks.size(); }
 
 unsigned int FileLocation::blocksInRange(
     const off_t start, const off_t end) const
 {
-    auto rangeIt = m_blocks.equal_range(
-        boost::icl::discrete_interval<off_t>::right_open(start, end));
-
-    unsigned int res = 0;
-    for (auto it = rangeIt.first; it != rangeIt.second; ++it)
-        res++;
-
-    return res;
+    return m_blocks.countInRange(start, end);
 }
 
 size_t FileLocation::blocksLengthInRange(
     const off_t start, const off_t end) const
 {
-    auto rangeIt = m_blocks.equal_range(
-        boost::icl::discrete_interval<off_t>::right_open(start, end));
-
-    size_t res = 0;
-    for (auto it = rangeIt.first; it != rangeIt.second; ++it) {
-        auto lower = std::max(start, it->first.lower());
-        auto upper = std::min(it->first.upper(), end);
-        res += (upper - lower);
-    }
-
-    return res;
+    return m_blocks.lengthInRange(start, end);
 }
 
 void FileLocation::putBlock(
     const off_t offset, const size_t size, FileBlock &&block)
 {
-    auto interval =
+    const auto range =
         boost::icl::discrete_interval<off_t>::right_open(offset, offset + size);
+    const auto knownBlocksBefore = knownBlocksIn(range);
+
+    m_blocks.add(offset, offset + size, block);
+    updateKnownRange(range, knownBlocksBefore);
 
-    putBlock(std::make_pair(interval, std::forward<FileBlock>(block)));
+    invalidateCachedValues();
 }
 
 void FileLocation::putBlock(
     const std::pair<boost::icl::discrete_interval<off_t>, FileBlock> &block)
 {
-    m_blocks += block;
+    if (boost::icl::is_empty(block.first))
+        return;
+
+    const auto knownBlocksBefore = knownBlocksIn(block.first);
+
+    m_blocks.add(boost::icl::first(block.first),
+        boost::icl::last_next(block.first), block.second);
+    updateKnownRange(block.first, knownBlocksBefore);
 
     invalidateCachedValues();
 }
 
 void FileLocation::truncate(const boost::icl::discrete_interval<off_t> &range)
 {
-    m_blocks &= range;
+    if (boost::icl::is_empty(range)) {
+        m_blocks.clear();
+        m_knownRanges.clear();
+        m_fullLength = 0;
+        m_fullBlocksCount = 0;
+        m_fullTotalsStale = false;
+    }
+    else if (m_windowed && boost::icl::contains(m_knownRanges, range)) {
+        // All blocks left after truncation are known
+        m_blocks.intersect(
+            boost::icl::first(range), boost::icl::last_next(range));
+        m_knownRanges.clear();
+        m_windowed = false;
+        m_fullTotalsStale = false;
+    }
+    else if (m_windowed) {
+        // Blocks truncated within the known ranges are subtracted from the
+        // full location, but the full location may also hold blocks outside
+        // of them, which are truncated as well
+        const auto knownBlocksBefore = knownBlocksIn(
+            boost::icl::discrete_interval<off_t>::right_open(
+                0, std::numeric_limits<off_t>::max()));
+
+        m_blocks.intersect(
+            boost::icl::first(range), boost::icl::last_next(range));
+        m_knownRanges &= range;
+
+        const auto knownBlocksAfter = knownBlocksIn(range);
+        m_fullLength = std::min<std::size_t>(
+            adjustTotal(m_fullLength, knownBlocksBefore.first,
+                knownBlocksAfter.first),
+            boost::icl::size(range));
+        m_fullBlocksCount = adjustTotal(m_fullBlocksCount,
+            knownBlocksBefore.second, knownBlocksAfter.second);
+        m_fullTotalsStale = true;
+    }
+    else {
+        m_blocks.intersect(
+            boost::icl::first(range), boost::icl::last_next(range));
+    }
 
     invalidateCachedValues();
 }
@@ -127,6 +167,9 @@ void FileLocation::truncate(const boost::icl::discrete_interval<off_t> &range)
 void FileLocation::update(const FileBlocksMap &blocks)
 {
     m_blocks = blocks;
+    m_windowed = false;
+    m_knownRanges.clear();
+    m_fullTotalsStale = false;
 
     invalidateCachedValues();
 }
@@ -134,15 +177,94 @@ void FileLocation::update(const FileBlocksMap &blocks)
 void FileLocation::updateInRange(
     const off_t start, const off_t end, const FileLocation &blocks)
 {
-    const auto updateRange =
+    if (start >= end)
+        return;
+
+    const auto range =
         boost::icl::discrete_interval<off_t>::right_open(start, end);
+    const auto knownBlocksBefore = knownBlocksIn(range);
 
-    m_blocks.erase(updateRange);
-    m_blocks += blocks.blocks() & updateRange;
+    m_blocks.update(start, end, blocks.blocks());
+    updateKnownRange(range, knownBlocksBefore);
 
     invalidateCachedValues();
 }
 
+void FileLocation::retainRanges(const boost::icl::interval_set<off_t> &ranges)
+{
+    if (!m_windowed) {
+        m_fullLength = m_blocks.length();
+        m_fullBlocksCount = m_blocks.size();
+    }
+
+    FileBlocksMap retained;
+    for (const auto &range : ranges)
+        retained.update(range.lower(), range.upper(), m_blocks);
+
+    m_blocks = std::move(retained);
+    m_knownRanges = m_windowed ? m_knownRanges & ranges : ranges;
+    m_windowed = true;
+
+    invalidateCachedValues();
+}
+
+bool FileLocation::isKnown(const off_t offset) const
+{
+    return !m_windowed || boost::icl::contains(m_knownRanges, offset);
+}
+
+std::pair<std::size_t, std::size_t> FileLocation::knownBlocksIn(
+    const boost::icl::discrete_interval<off_t> &range) const
+{
+    std::size_t length = 0;
+    std::size_t count = 0;
+
+    if (!m_windowed)
+        return {length, count};
+
+    for (const auto &known : m_knownRanges & range) {
+        length += m_blocks.lengthInRange(known.lower(), known.upper());
+        count += m_blocks.countInRange(known.lower(), known.upper());
+    }
+
+    return {length, count};
+}
+
+void FileLocation::updateKnownRange(
+    const boost::icl::discrete_interval<off_t> &range,
+    const std::pair<std::size_t, std::size_t> &knownBlocksBefore)
+{
+    if (!m_windowed || boost::icl::is_empty(range))
+        return;
+
+    // Changes of the full location are counted only within the known ranges.
+    // Blocks which the full location held in the rest of the range before
+    // the change are not known, so the totals can't be adjusted by them
+    // until the full location is fetched again.
+    if (!boost::icl::contains(m_knownRanges, range))
+        m_fullTotalsStale = true;
+
+    const auto knownBlocksAfter = knownBlocksIn(range);
+    m_fullLength = adjustTotal(
+        m_fullLength, knownBlocksBefore.first, knownBlocksAfter.first);
+    m_fullBlocksCount = adjustTotal(
+        m_fullBlocksCount, knownBlocksBefore.second, knownBlocksAfter.second);
+
+    m_knownRanges += range;
+}
+
+std::size_t FileLocation::fullLength() const
+{
+    // Blocks held by the location are a lower bound of the full location
+    return m_windowed && !m_fullTotalsStale ? m_fullLength : m_blocks.length();
+}
+
+std::size_t FileLocation::fullBlocksCount() const
+{
+    return m_windowed && !m_fullTotalsStale ? m_fullBlocksCount
+                                            : m_blocks.size();
+}
+
 std::uint64_t FileLocation::version() const { return m_version; }
 
 void FileLocation::version(std::uint64_t v) { m_version = v; }
@@ -173,7 +295,7 @@ std::string FileLocation::progressString(
 
         if (fileSize < progressSteps * 2) {
             size_t intersectionLength =
-                std::min<size_t>(boost::icl::length(m_blocks), fileSize);
+                std::min<size_t>(fullLength(), fileSize);
 
             if (intersectionLength == 0)
                 result.append(progressSteps, ' ');
@@ -221,8 +343,7 @@ double FileLocation::replicationProgress(const size_t fileSize) const
         return 0.0;
 
     if (!m_replicationProgressCachedValid) {
-        size_t intersectionLength =
-            std::min<size_t>(boost::icl::length(m_blocks), fileSize);
+        size_t intersectionLength = std::min<size_t>(fullLength(), fileSize);
 
         m_replicationProgressCachedValue =
             (static_cast<double>(intersectionLength)) /
@@ -239,18 +360,17 @@ bool FileLocation::isReplicationComplete(const size_t fileSize) const
     if (fileSize == 0)
         return true;
 
-    if (blocksCount() != 1)
+    if (fullBlocksCount() != 1 || (m_windowed && m_fullTotalsStale))
         return false;
 
-    return static_cast<size_t>(boost::icl::length(m_blocks)) >= fileSize;
+    return fullLength() >= fileSize;
 }
 
 bool FileLocation::linearReadPrefetchThresholdReached(
     const double threshold, const size_t fileSize) const
 {
     const auto fileThresholdRange = static_cast<size_t>(fileSize * threshold);
-    return static_cast<size_t>(boost::icl::length(m_blocks)) >
-        fileThresholdRange;
+    return fullLength() > fileThresholdRange;
 }
 
 bool FileLocation::randomReadPrefetchThresholdReached(
@@ -261,8 +381,8 @@ bool FileLocation::randomReadPrefetchThresholdReached(
     // If at least 5 different blocks are in the map and their overall size
     // is larger then threshold, return true
     constexpr auto kFsLogicGlobalBlockThreshold = 5u;
-    return (blocksCount() > kFsLogicGlobalBlockThreshold) &&
-        static_cast<size_t>(boost::icl::length(m_blocks)) > fileThresholdBytes;
+    return (fullBlocksCount() > kFsLogicGlobalBlockThreshold) &&
+        fullLength() > fileThresholdBytes;
 }
 
 void FileLocation::deserialize(const ProtocolMessage &message)
@@ -272,25 +392,21 @@ void FileLocation::deserialize(const ProtocolMessage &message)
     m_storageId = message.storage_id();
     m_fileId = message.file_id();
     m_version = message.version();
-    std::string fileId_;
-    std::string storageId_;
-
-    for (const auto &block : message.blocks()) {
-        auto interval = boost::icl::discrete_interval<off_t>::right_open(
-            block.offset(), block.offset() + block.size());
 
-        if (block.has_file_id())
-            fileId_ = block.file_id();
-        else
-            fileId_ = m_fileId;
+    // Most blocks are stored on the default storage, so the default block is
+    // built once and only blocks overriding the ids need their own copies
+    const FileBlock defaultBlock{m_storageId, m_fileId};
 
-        if (block.has_storage_id())
-            storageId_ = block.storage_id();
-        else
-            storageId_ = m_storageId;
+    for (const auto &block : message.blocks()) {
+        const auto end = block.offset() + block.size();
+        if (!block.has_file_id() && !block.has_storage_id()) {
+            m_blocks.add(block.offset(), end, defaultBlock);
+            continue;
+        }
 
-        m_blocks += std::make_pair(
-            interval, FileBlock{std::move(storageId_), std::move(fileId_)});
+        m_blocks.add(block.offset(), end,
+            FileBlock{block.has_storage_id() ? block.storage_id() : m_storageId,
+                block.has_file_id() ? block.file_id() : m_fileId});
     }
 }
 
@@ -11,9 +11,11 @@
 
 #include "events/types/event.h"
 #include "fileBlock.h"
+#include "fileBlocksMap.h"
 #include "fuseResponse.h"
 
-#include <boost/icl/interval_map.hpp>
+#include <boost/icl/discrete_interval.hpp>
+#include <boost/icl/interval_set.hpp>
 #include <folly/FBString.h>
 
 #include <sys/types.h>
@@ -22,6 +24,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 namespace one {
 namespace clproto {
@@ -36,8 +39,7 @@ namespace fuse {
  */
 class FileLocation : public FuseResponse {
 public:
-    using FileBlocksMap = boost::icl::interval_map<off_t, FileBlock,
-        boost::icl::partial_enricher>;
+    using FileBlocksMap = one::messages::fuse::FileBlocksMap;
     using ProtocolMessage = clproto::FileLocation;
 
     FileLocation() = default;
@@ -140,6 +142,32 @@ public:
      */
     unsigned int blocksCount() const;
 
+    /**
+     * Drops blocks outside of given ranges, making the location windowed.
+     * Blocks of a windowed location are known only within ranges retained
+     * from the full location and ranges updated afterwards. Length and number
+     * of blocks of the full location are recorded before the first trimming
+     * and adjusted by changes within the known ranges, so that replication
+     * state of a windowed location is still reported for the whole file.
+     * Once a change reaches beyond the known ranges, only the held blocks
+     * are reported until the full location is fetched again.
+     * @param ranges Ranges of blocks to retain.
+     */
+    void retainRanges(const boost::icl::interval_set<off_t> &ranges);
+
+    /**
+     * @return Whether only some ranges of blocks are held by the location.
+     */
+    bool isWindowed() const { return m_windowed; }
+
+    /**
+     * Checks whether blocks around an offset are known to the location.
+     * @param offset The offset.
+     * @return True if the location is not windowed or the offset lies
+     * within one of its known ranges.
+     */
+    bool isKnown(const off_t offset) const;
+
     /**
      * @return Version of this location.
      */
@@ -177,7 +205,8 @@ public:
     bool isReplicationComplete(const size_t fileSize) const;
 
     /**
-     * Calculates the number of different blocks in a given range
+     * Calculates the number of different blocks in a given range. Only
+     * blocks within the known ranges of a windowed location are counted.
      * @param start The start offset of the requested range (inclusive)
      * @param end The end offset of the range  (noninclusive)
      * @return Number of blocks in range [start, end)
@@ -208,6 +237,13 @@ private:
     void deserialize(const ProtocolMessage &message);
     void invalidateCachedValues();
 
+    std::pair<std::size_t, std::size_t> knownBlocksIn(
+        const boost::icl::discrete_interval<off_t> &range) const;
+    void updateKnownRange(const boost::icl::discrete_interval<off_t> &range,
+        const std::pair<std::size_t, std::size_t> &knownBlocksBefore);
+    std::size_t fullLength() const;
+    std::size_t fullBlocksCount() const;
+
     std::string m_uuid;
     std::string m_spaceId;
     std::string m_storageId;
@@ -215,6 +251,14 @@ private:
     FileBlocksMap m_blocks;
     std::uint64_t m_version;
 
+    bool m_windowed = false;
+    boost::icl::interval_set<off_t> m_knownRanges;
+    std::size_t m_fullLength = 0;
+    std::size_t m_fullBlocksCount = 0;
+    // Set when the full location changed outside of the known ranges, in
+    // which case only the held blocks are reported until the next fetch
+    bool m_fullTotalsStale = false;
+
     mutable bool m_replicationProgressCachedValid;
     mutable double m_replicationProgressCachedValue;
 
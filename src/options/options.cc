@@ -191,6 +191,21 @@ Options::Options()
         .withGroup(OptionGroup::ADVANCED)
         .withDescription("Specify number of parallel storage helper threads.");
 
+    add<std::string>()
+        ->withLongName("storage-helper-thread-counts")
+        .withConfigName("storage_helper_thread_counts")
+        .withValueName("<type=threads,...>")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify numbers of storage helper threads for "
+                         "specific storage types, e.g. 'posix=32,s3=16'. "
+                         "Helpers of each storage run in a separate thread "
+                         "pool, so that a slow storage does not block "
+                         "access to other storages. Pools of storages of "
+                         "types which are not listed have the number of "
+                         "threads set by 'storage-helper-thread-count'. "
+                         "Threads of a pool are started only when its "
+                         "storage is first accessed.");
+
     add<bool>()
         ->asSwitch()
         .withLongName("no-buffer")
@@ -433,6 +448,253 @@ Options::Options()
         .withDescription("Specify the size of requests made during readdir "
                          "prefetch (in number of dir entries).");
 
+    add<std::size_t>()
+        ->withLongName("small-file-cache-size")
+        .withConfigName("small_file_cache_size")
+        .withValueName("<size>")
+        .withDefaultValue(DEFAULT_SMALL_FILE_CACHE_SIZE,
+            std::to_string(DEFAULT_SMALL_FILE_CACHE_SIZE))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify maximum total size in bytes of in-memory "
+                         "cache for contents of small files. When 0, the "
+                         "cache is disabled.");
+
+    add<std::size_t>()
+        ->withLongName("small-file-cache-threshold")
+        .withConfigName("small_file_cache_threshold")
+        .withValueName("<size>")
+        .withDefaultValue(DEFAULT_SMALL_FILE_CACHE_THRESHOLD,
+            std::to_string(DEFAULT_SMALL_FILE_CACHE_THRESHOLD))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify maximum size in bytes of a file, which "
+                         "contents can be stored in small file cache.");
+
+    add<boost::filesystem::path>()
+        ->withLongName("disk-cache-dir")
+        .withConfigName("disk_cache_dir")
+        .withValueName("<path>")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify path of a local directory, where data read "
+                         "from remote storages will be cached. When not set, "
+                         "the disk cache is disabled.");
+
+    add<unsigned int>()
+        ->withLongName("disk-cache-size")
+        .withConfigName("disk_cache_size")
+        .withValueName("<size>")
+        .withDefaultValue(DEFAULT_DISK_CACHE_SIZE,
+            std::to_string(DEFAULT_DISK_CACHE_SIZE))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify maximum total size in MiB of data stored in "
+                         "the local disk cache.");
+
+    add<unsigned int>()
+        ->withLongName("shared-read-cache-size")
+        .withConfigName("shared_read_cache_size")
+        .withValueName("<size>")
+        .withDefaultValue(DEFAULT_SHARED_READ_CACHE_SIZE,
+            std::to_string(DEFAULT_SHARED_READ_CACHE_SIZE))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify maximum total size in bytes of in-memory "
+                         "cache of recently read file ranges, shared by all "
+                         "handles of a file. When 0, the cache is disabled.");
+
+    add<unsigned int>()
+        ->withLongName("negative-lookup-cache-size")
+        .withConfigName("negative_lookup_cache_size")
+        .withValueName("<entries>")
+        .withDefaultValue(DEFAULT_NEGATIVE_LOOKUP_CACHE_SIZE,
+            std::to_string(DEFAULT_NEGATIVE_LOOKUP_CACHE_SIZE))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify maximum number of cached lookups of "
+                         "nonexistent files. Files created by other clients "
+                         "are reported as nonexistent until the cached "
+                         "lookups expire, so the TTL should not exceed the "
+                         "kernel entry timeout. When 0, such lookups are not "
+                         "cached.");
+
+    add<unsigned int>()
+        ->withLongName("negative-lookup-cache-ttl")
+        .withConfigName("negative_lookup_cache_ttl")
+        .withValueName("<duration>")
+        .withDefaultValue(DEFAULT_NEGATIVE_LOOKUP_CACHE_TTL,
+            std::to_string(DEFAULT_NEGATIVE_LOOKUP_CACHE_TTL))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify time in seconds after which cached lookups "
+                         "of nonexistent files expire.");
+
+    add<std::string>()
+        ->withLongName("metadata-cache-eviction-policy")
+        .withConfigName("metadata_cache_eviction_policy")
+        .withValueName("<policy>")
+        .withDefaultValue(DEFAULT_METADATA_CACHE_EVICTION_POLICY,
+            DEFAULT_METADATA_CACHE_EVICTION_POLICY)
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify eviction policy of file metadata and inode "
+                         "caches. Possible values are: lru, 2q. The 2q policy "
+                         "keeps frequently used entries cached during scans "
+                         "of large directory trees.");
+
+    add<unsigned int>()
+        ->withLongName("metadata-cache-memory-limit")
+        .withConfigName("metadata_cache_memory_limit")
+        .withValueName("<size>")
+        .withDefaultValue(DEFAULT_METADATA_CACHE_MEMORY_LIMIT,
+            std::to_string(DEFAULT_METADATA_CACHE_MEMORY_LIMIT))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify estimated memory in MiB, above which file "
+                         "metadata cache entries are pruned regardless of "
+                         "their number. When 0, only metadata-cache-size is "
+                         "enforced.");
+
+    add<bool>()
+        ->asSwitch()
+        .withLongName("stable-inodes")
+        .withConfigName("stable_inodes")
+        .withImplicitValue(true)
+        .withDefaultValue(false, "false")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Derive inode numbers from file uuids, so that files "
+                         "keep their inode numbers across remounts. Inode "
+                         "numbers use the full 64-bit range.");
+
+    add<boost::filesystem::path>()
+        ->withLongName("inode-table")
+        .withConfigName("inode_table")
+        .withValueName("<path>")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify path of a file, where inode numbers assigned "
+                         "to files are persisted, so that they can be "
+                         "resolved after remount. When not set, inode numbers "
+                         "are not persisted.");
+
+    add<boost::filesystem::path>()
+        ->withLongName("cache-snapshot")
+        .withConfigName("cache_snapshot")
+        .withValueName("<path>")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify path of a file, where uuids of cached files "
+                         "are saved on unmount and periodically, so that the "
+                         "metadata cache can be warmed up after remount. When "
+                         "not set, the cache starts empty.");
+
+    add<unsigned int>()
+        ->withLongName("cache-snapshot-interval")
+        .withConfigName("cache_snapshot_interval")
+        .withValueName("<duration>")
+        .withDefaultValue(DEFAULT_CACHE_SNAPSHOT_INTERVAL,
+            std::to_string(DEFAULT_CACHE_SNAPSHOT_INTERVAL))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify time in seconds between periodic saves of "
+                         "the metadata cache snapshot. When 0, the snapshot "
+                         "is saved only on unmount.");
+
+    add<boost::filesystem::path>()
+        ->withLongName("storage-access-cache")
+        .withConfigName("storage_access_cache")
+        .withValueName("<path>")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify path of a file, where local mount points "
+                         "verified to provide direct access to storages are "
+                         "persisted, so that they are checked first after "
+                         "remount. When not set, all mount points are checked "
+                         "on each mount.");
+
+    add<unsigned int>()
+        ->withLongName("path-walk-prefetch-size")
+        .withConfigName("path_walk_prefetch_size")
+        .withValueName("<entries>")
+        .withDefaultValue(DEFAULT_PATH_WALK_PREFETCH_SIZE,
+            std::to_string(DEFAULT_PATH_WALK_PREFETCH_SIZE))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify maximum number of directory entries "
+                         "prefetched in one request when consecutive lookups "
+                         "walk down a path on a cold cache. When 0, path "
+                         "walks are not prefetched.");
+
+    add<unsigned int>()
+        ->withLongName("xattr-cache-size")
+        .withConfigName("xattr_cache_size")
+        .withValueName("<entries>")
+        .withDefaultValue(DEFAULT_XATTR_CACHE_SIZE,
+            std::to_string(DEFAULT_XATTR_CACHE_SIZE))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify maximum number of files, whose extended "
+                         "attributes are cached. Extended attributes changed "
+                         "by other clients can be read from the cache until "
+                         "they expire. When 0, extended attributes are not "
+                         "cached.");
+
+    add<unsigned int>()
+        ->withLongName("xattr-cache-ttl")
+        .withConfigName("xattr_cache_ttl")
+        .withValueName("<duration>")
+        .withDefaultValue(DEFAULT_XATTR_CACHE_TTL,
+            std::to_string(DEFAULT_XATTR_CACHE_TTL))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify time in seconds after which cached extended "
+                         "attributes expire.");
+
+    add<bool>()
+        ->asSwitch()
+        .withLongName("readdir-tree-walk-prefetch")
+        .withConfigName("readdir_tree_walk_prefetch")
+        .withImplicitValue(true)
+        .withDefaultValue(false, "false")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Start fetching entries of a directory as soon as it "
+                         "is looked up, when directories looked up in its "
+                         "parent directory are being listed right after their "
+                         "lookup, e.g. by find or du.");
+
+    add<unsigned int>()
+        ->withLongName("file-location-memory-limit")
+        .withConfigName("file_location_memory_limit")
+        .withValueName("<size>")
+        .withDefaultValue(DEFAULT_FILE_LOCATION_MEMORY_LIMIT,
+            std::to_string(DEFAULT_FILE_LOCATION_MEMORY_LIMIT))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify estimated memory in MiB, above which a "
+                         "cached file location retains only blocks around "
+                         "recently accessed offsets and synchronizes other "
+                         "ranges on access. When 0, entire file locations are "
+                         "cached.");
+
+    add<bool>()
+        ->asSwitch()
+        .withLongName("hedged-reads")
+        .withConfigName("hedged_reads")
+        .withImplicitValue(true)
+        .withDefaultValue(false, "false")
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Enable hedged reads from directly accessible "
+                         "storages. When a direct read does not complete "
+                         "within the latency of the slowest reads, as "
+                         "specified by 'hedged-read-percentile', the same "
+                         "range is also read via proxy and the first result "
+                         "is returned.");
+
+    add<unsigned int>()
+        ->withLongName("hedged-read-percentile")
+        .withConfigName("hedged_read_percentile")
+        .withValueName("<percentile>")
+        .withDefaultValue(DEFAULT_HEDGED_READ_PERCENTILE,
+            std::to_string(DEFAULT_HEDGED_READ_PERCENTILE))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify the percentile of recent direct read "
+                         "latencies, after which a hedged read via proxy is "
+                         "issued.");
+
+    add<unsigned int>()
+        ->withLongName("hedged-read-budget")
+        .withConfigName("hedged_read_budget")
+        .withValueName("<percent>")
+        .withDefaultValue(DEFAULT_HEDGED_READ_BUDGET,
+            std::to_string(DEFAULT_HEDGED_READ_BUDGET))
+        .withGroup(OptionGroup::ADVANCED)
+        .withDescription("Specify the maximum number of hedged reads via "
+                         "proxy, as a percentage of direct reads.");
+
     add<std::string>()
         ->withEnvName("tag_on_create")
         .withLongName("tag-on-create")
@@ -780,6 +1042,12 @@ unsigned int Options::getStorageHelperThreadCount() const
         .get_value_or(DEFAULT_STORAGE_HELPER_THREAD_COUNT);
 }
 
+boost::optional<std::string> Options::getStorageHelperThreadCounts() const
+{
+    return get<std::string>(
+        {"storage-helper-thread-counts", "storage_helper_thread_counts"});
+}
+
 bool Options::areFileReadEventsDisabled() const
 {
     return get<bool>({"disable-read-events", "disable_read_events"})
@@ -930,6 +1198,148 @@ unsigned int Options::getReaddirPrefetchSize() const
         .get_value_or(DEFAULT_READDIR_PREFETCH_SIZE);
 }
 
+std::size_t Options::getSmallFileCacheSize() const
+{
+    return get<std::size_t>({"small-file-cache-size", "small_file_cache_size"})
+        .get_value_or(DEFAULT_SMALL_FILE_CACHE_SIZE);
+}
+
+std::size_t Options::getSmallFileCacheThreshold() const
+{
+    return get<std::size_t>(
+        {"small-file-cache-threshold", "small_file_cache_threshold"})
+        .get_value_or(DEFAULT_SMALL_FILE_CACHE_THRESHOLD);
+}
+
+boost::optional<boost::filesystem::path> Options::getDiskCacheDirPath() const
+{
+    return get<boost::filesystem::path>({"disk-cache-dir", "disk_cache_dir"});
+}
+
+unsigned int Options::getDiskCacheSize() const
+{
+    return get<unsigned int>({"disk-cache-size", "disk_cache_size"})
+        .get_value_or(DEFAULT_DISK_CACHE_SIZE);
+}
+
+unsigned int Options::getSharedReadCacheSize() const
+{
+    return get<unsigned int>(
+        {"shared-read-cache-size", "shared_read_cache_size"})
+        .get_value_or(DEFAULT_SHARED_READ_CACHE_SIZE);
+}
+
+unsigned int Options::getNegativeLookupCacheSize() const
+{
+    return get<unsigned int>(
+        {"negative-lookup-cache-size", "negative_lookup_cache_size"})
+        .get_value_or(DEFAULT_NEGATIVE_LOOKUP_CACHE_SIZE);
+}
+
+std::chrono::seconds Options::getNegativeLookupCacheTTL() const
+{
+    return std::chrono::seconds{
+        get<unsigned int>(
+            {"negative-lookup-cache-ttl", "negative_lookup_cache_ttl"})
+            .get_value_or(DEFAULT_NEGATIVE_LOOKUP_CACHE_TTL)};
+}
+
+std::string Options::getMetadataCacheEvictionPolicy() const
+{
+    return get<std::string>(
+        {"metadata-cache-eviction-policy", "metadata_cache_eviction_policy"})
+        .get_value_or(DEFAULT_METADATA_CACHE_EVICTION_POLICY);
+}
+
+unsigned int Options::getMetadataCacheMemoryLimit() const
+{
+    return get<unsigned int>(
+        {"metadata-cache-memory-limit", "metadata_cache_memory_limit"})
+        .get_value_or(DEFAULT_METADATA_CACHE_MEMORY_LIMIT);
+}
+
+bool Options::areStableInodesEnabled() const
+{
+    return get<bool>({"stable-inodes", "stable_inodes"}).get_value_or(false);
+}
+
+boost::optional<boost::filesystem::path> Options::getInodeTablePath() const
+{
+    return get<boost::filesystem::path>({"inode-table", "inode_table"});
+}
+
+boost::optional<boost::filesystem::path> Options::getCacheSnapshotPath() const
+{
+    return get<boost::filesystem::path>({"cache-snapshot", "cache_snapshot"});
+}
+
+std::chrono::seconds Options::getCacheSnapshotInterval() const
+{
+    return std::chrono::seconds{
+        get<unsigned int>(
+            {"cache-snapshot-interval", "cache_snapshot_interval"})
+            .get_value_or(DEFAULT_CACHE_SNAPSHOT_INTERVAL)};
+}
+
+boost::optional<boost::filesystem::path>
+Options::getStorageAccessCachePath() const
+{
+    return get<boost::filesystem::path>(
+        {"storage-access-cache", "storage_access_cache"});
+}
+
+unsigned int Options::getPathWalkPrefetchSize() const
+{
+    return get<unsigned int>(
+        {"path-walk-prefetch-size", "path_walk_prefetch_size"})
+        .get_value_or(DEFAULT_PATH_WALK_PREFETCH_SIZE);
+}
+
+unsigned int Options::getXAttrCacheSize() const
+{
+    return get<unsigned int>({"xattr-cache-size", "xattr_cache_size"})
+        .get_value_or(DEFAULT_XATTR_CACHE_SIZE);
+}
+
+std::chrono::seconds Options::getXAttrCacheTTL() const
+{
+    return std::chrono::seconds{
+        get<unsigned int>({"xattr-cache-ttl", "xattr_cache_ttl"})
+            .get_value_or(DEFAULT_XATTR_CACHE_TTL)};
+}
+
+bool Options::isReaddirTreeWalkPrefetchEnabled() const
+{
+    return get<bool>(
+        {"readdir-tree-walk-prefetch", "readdir_tree_walk_prefetch"})
+        .get_value_or(false);
+}
+
+unsigned int Options::getFileLocationMemoryLimit() const
+{
+    return get<unsigned int>(
+        {"file-location-memory-limit", "file_location_memory_limit"})
+        .get_value_or(DEFAULT_FILE_LOCATION_MEMORY_LIMIT);
+}
+
+bool Options::areHedgedReadsEnabled() const
+{
+    return get<bool>({"hedged-reads", "hedged_reads"}).get_value_or(false);
+}
+
+unsigned int Options::getHedgedReadPercentile() const
+{
+    return get<unsigned int>(
+        {"hedged-read-percentile", "hedged_read_percentile"})
+        .get_value_or(DEFAULT_HEDGED_READ_PERCENTILE);
+}
+
+unsigned int Options::getHedgedReadBudget() const
+{
+    return get<unsigned int>({"hedged-read-budget", "hedged_read_budget"})
+        .get_value_or(DEFAULT_HEDGED_READ_BUDGET);
+}
+
 boost::optional<std::pair<std::string, std::string>>
 Options::getOnModifyTag() const
 {
@@ -54,6 +54,21 @@ static constexpr auto DEFAULT_METADATA_CACHE_SIZE = 100000;
 static constexpr auto DEFAULT_READDIR_PREFETCH_SIZE = 2500;
 static constexpr auto DEFAULT_PROVIDER_TIMEOUT = 2 * 60;
 static constexpr auto DEFAULT_MONITORING_PERIOD_SECONDS = 30;
+static constexpr auto DEFAULT_SMALL_FILE_CACHE_SIZE = 0;
+static constexpr auto DEFAULT_SMALL_FILE_CACHE_THRESHOLD = 1024 * 1024;
+static constexpr auto DEFAULT_DISK_CACHE_SIZE = 10 * 1024;
+static constexpr auto DEFAULT_SHARED_READ_CACHE_SIZE = 0;
+static constexpr auto DEFAULT_NEGATIVE_LOOKUP_CACHE_SIZE = 0;
+static constexpr auto DEFAULT_NEGATIVE_LOOKUP_CACHE_TTL = 5;
+static constexpr auto DEFAULT_METADATA_CACHE_EVICTION_POLICY = "lru";
+static constexpr auto DEFAULT_METADATA_CACHE_MEMORY_LIMIT = 0;
+static constexpr auto DEFAULT_CACHE_SNAPSHOT_INTERVAL = 300;
+static constexpr auto DEFAULT_PATH_WALK_PREFETCH_SIZE = 0;
+static constexpr auto DEFAULT_XATTR_CACHE_SIZE = 0;
+static constexpr auto DEFAULT_XATTR_CACHE_TTL = 5;
+static constexpr auto DEFAULT_FILE_LOCATION_MEMORY_LIMIT = 0;
+static constexpr auto DEFAULT_HEDGED_READ_PERCENTILE = 95;
+static constexpr auto DEFAULT_HEDGED_READ_BUDGET = 5;
 }
 
 class Option;
@@ -209,6 +224,12 @@ public:
      */
     unsigned int getStorageHelperThreadCount() const;
 
+    /*
+     * @return Numbers of storage helper threads for specific storage types,
+     * in the 'type=threads,...' format.
+     */
+    boost::optional<std::string> getStorageHelperThreadCounts() const;
+
     /*
      * @return true if 'disable-read-events' is specified.
      */
@@ -331,6 +352,121 @@ public:
      */
     unsigned int getReaddirPrefetchSize() const;
 
+    /*
+     * @return Maximum total size in bytes of in-memory cache for small files
+     * contents.
+     */
+    std::size_t getSmallFileCacheSize() const;
+
+    /*
+     * @return Maximum size in bytes of a file, which contents can be stored in
+     * small file cache.
+     */
+    std::size_t getSmallFileCacheThreshold() const;
+
+    /*
+     * @return Path of the local disk cache directory, if set.
+     */
+    boost::optional<boost::filesystem::path> getDiskCacheDirPath() const;
+
+    /*
+     * @return Maximum total size in MiB of data stored in the local disk cache.
+     */
+    unsigned int getDiskCacheSize() const;
+
+    /*
+     * @return Maximum total size in bytes of in-memory cache of recently read
+     * file ranges, shared by all handles of a file.
+     */
+    unsigned int getSharedReadCacheSize() const;
+
+    /*
+     * @return Maximum number of cached lookups of nonexistent files.
+     */
+    unsigned int getNegativeLookupCacheSize() const;
+
+    /*
+     * @return Time after which cached lookups of nonexistent files expire.
+     */
+    std::chrono::seconds getNegativeLookupCacheTTL() const;
+
+    /*
+     * @return Eviction policy of file metadata and inode caches.
+     */
+    std::string getMetadataCacheEvictionPolicy() const;
+
+    /*
+     * @return Memory limit of file metadata cache in MiB.
+     */
+    unsigned int getMetadataCacheMemoryLimit() const;
+
+    /*
+     * @return Whether inode numbers should be derived from file uuids.
+     */
+    bool areStableInodesEnabled() const;
+
+    /*
+     * @return Path of the persistent inode table, if set.
+     */
+    boost::optional<boost::filesystem::path> getInodeTablePath() const;
+
+    /*
+     * @return Path of the metadata cache snapshot, if set.
+     */
+    boost::optional<boost::filesystem::path> getCacheSnapshotPath() const;
+
+    /*
+     * @return Time between periodic saves of the metadata cache snapshot.
+     */
+    std::chrono::seconds getCacheSnapshotInterval() const;
+
+    /*
+     * @return Path of the persisted storage access detection results, if set.
+     */
+    boost::optional<boost::filesystem::path> getStorageAccessCachePath() const;
+
+    /*
+     * @return Maximum number of entries prefetched for a directory on a path
+     * walk.
+     */
+    unsigned int getPathWalkPrefetchSize() const;
+
+    /*
+     * @return Maximum number of files with cached extended attributes.
+     */
+    unsigned int getXAttrCacheSize() const;
+
+    /*
+     * @return Time after which cached extended attributes expire.
+     */
+    std::chrono::seconds getXAttrCacheTTL() const;
+
+    /*
+     * @return Whether directory listings should be prefetched on tree walks.
+     */
+    bool isReaddirTreeWalkPrefetchEnabled() const;
+
+    /*
+     * @return Memory limit of a single cached file location in MiB.
+     */
+    unsigned int getFileLocationMemoryLimit() const;
+
+    /*
+     * @return Whether hedged reads via proxy are enabled.
+     */
+    bool areHedgedReadsEnabled() const;
+
+    /*
+     * @return Percentile of direct read latencies after which hedged reads are
+     * issued.
+     */
+    unsigned int getHedgedReadPercentile() const;
+
+    /*
+     * @return Maximum number of hedged reads as a percentage of direct reads.
+     */
+    unsigned int getHedgedReadBudget() const;
+
     /*
      * @return Get xattr on-modify tag.
      */
@@ -15,6 +15,8 @@
 #include "messages/fuse/verifyStorageTestFile.h"
 #include "posixHelper.h"
 
+#include <folly/Optional.h>
+#include <folly/String.h>
 #include <folly/io/IOBuf.h>
 
 #ifdef __APPLE__
@@ -23,7 +25,11 @@
 #include <mntent.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <exception>
+#include <mutex>
 #include <random>
 #include <vector>
 
@@ -105,36 +111,32 @@ std::vector<boost::filesystem::path> getMountPoints()
 } // namespace
 
 StorageAccessManager::StorageAccessManager(
-    helpers::StorageHelperCreator &helperFactory,
-    const options::Options &options)
-    : m_helperFactory{helperFactory}
+    HelperFactoryGetter helperFactory, const options::Options &options)
+    : m_helperFactory{std::move(helperFactory)}
     , m_options{options}
     , m_mountPoints{getMountPoints()}
+    , m_cachePath{options.getStorageAccessCachePath().get_value_or({})}
 {
+    loadVerifiedMountPoints();
 }
 
 std::shared_ptr<helpers::StorageHelper>
-StorageAccessManager::verifyStorageTestFile(
+StorageAccessManager::verifyStorageTestFile(const folly::fbstring &storageId,
     const messages::fuse::StorageTestFile &testFile)
 {
     const auto &helperParams = testFile.helperParams();
     if (helperParams.name() == helpers::POSIX_HELPER_NAME) {
-        for (const auto &mountPoint : m_mountPoints) {
-            auto helper = m_helperFactory.getStorageHelper(
-                helpers::POSIX_HELPER_NAME,
-                {{helpers::POSIX_HELPER_MOUNT_POINT_ARG, mountPoint.string()}},
-                m_options.isIOBuffered());
-            if (verifyStorageTestFile(helper, testFile))
-                return helper;
-        }
+        return verifyMountPoints(storageId, testFile);
     }
     else if (helperParams.name() == helpers::NULL_DEVICE_HELPER_NAME) {
-        return m_helperFactory.getStorageHelper(
-            helperParams.name(), helperParams.args(), m_options.isIOBuffered());
+        return m_helperFactory(storageId, helperParams.name())
+            .getStorageHelper(helperParams.name(), helperParams.args(),
+                m_options.isIOBuffered());
     }
     else {
-        auto helper = m_helperFactory.getStorageHelper(
-            helperParams.name(), helperParams.args(), m_options.isIOBuffered());
+        auto helper = m_helperFactory(storageId, helperParams.name())
+                          .getStorageHelper(helperParams.name(),
+                              helperParams.args(), m_options.isIOBuffered());
         if (verifyStorageTestFile(helper, testFile))
             return helper;
     }
@@ -142,36 +144,122 @@ StorageAccessManager::verifyStorageTestFile(
     return {};
 }
 
-bool StorageAccessManager::verifyStorageTestFile(
-    std::shared_ptr<helpers::StorageHelper> helper,
+std::shared_ptr<helpers::StorageHelper> StorageAccessManager::verifyMountPoints(
+    const folly::fbstring &storageId,
     const messages::fuse::StorageTestFile &testFile)
 {
-    try {
+    folly::Optional<boost::filesystem::path> knownMountPoint;
+    {
+        std::lock_guard<std::mutex> guard{m_verifiedMountPointsMutex};
+        auto it = m_verifiedMountPoints.find(storageId.toStdString());
+        if (it != m_verifiedMountPoints.end())
+            knownMountPoint = it->second;
+    }
+
+    if (knownMountPoint) {
+        auto helper = createPosixHelper(storageId, *knownMountPoint);
+        if (verifyStorageTestFile(helper, testFile)) {
+            LOG_DBG(1) << "Storage " << storageId
+                       << " verified at previously detected mount point "
+                       << *knownMountPoint;
+            return helper;
+        }
+    }
 
-        auto size = testFile.fileContent().size();
+    std::vector<boost::filesystem::path> mountPoints;
+    std::vector<std::shared_ptr<helpers::StorageHelper>> candidates;
+    for (const auto &mountPoint : m_mountPoints) {
+        if (knownMountPoint && mountPoint == *knownMountPoint)
+            continue;
 
-        auto handle = communication::wait(
-            helper->open(testFile.fileId(), O_RDONLY, {}), helper->timeout());
+        mountPoints.emplace_back(mountPoint);
+        candidates.emplace_back(createPosixHelper(storageId, mountPoint));
+    }
 
-        auto buf =
-            communication::wait(handle->read(0, size), helper->timeout());
-        std::string content;
-        buf.appendToString(content);
+    if (candidates.empty())
+        return {};
+
+    LOG_DBG(1) << "Verifying " << candidates.size()
+               << " candidate mount points of storage " << storageId;
+
+    // Read the test file through all candidate mount points at once, each
+    // with its own timeout, and use the first one at which the test file is
+    // verified without waiting for the slower ones
+    struct Verification {
+        folly::Promise<folly::Optional<std::size_t>> promise;
+        std::atomic<std::size_t> pending;
+        std::atomic<bool> completed{false};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    auto verification = std::make_shared<Verification>();
+    verification->pending = candidates.size();
+    auto verified = verification->promise.getFuture();
+
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        readStorageTestFile(candidates[i], testFile)
+            .onTimeout(candidates[i]->timeout(),
+                [] {
+                    return folly::makeFuture<std::string>(std::system_error{
+                        std::make_error_code(std::errc::timed_out)});
+                })
+            .then([verification, testFile, i](
+                      folly::Try<std::string> &&content) {
+                bool matches = false;
+                try {
+                    matches =
+                        checkStorageTestFileContent(content.value(), testFile);
+                }
+                catch (const std::system_error &e) {
+                    auto code = e.code().value();
+                    if (code == ETIMEDOUT) {
+                        LOG(WARNING) << "Storage test file validation timed "
+                                        "out at a candidate mount point";
+                    }
+                    else if (code != ENOENT && code != ENOTDIR &&
+                        code != EPERM) {
+                        LOG(WARNING) << "Storage test file validation failed!";
+                        std::lock_guard<std::mutex> guard{
+                            verification->errorMutex};
+                        if (!verification->error)
+                            verification->error = std::current_exception();
+                    }
+                }
+
+                if (matches && !verification->completed.exchange(true))
+                    verification->promise.setValue(i);
+
+                if (--verification->pending == 0 &&
+                    !verification->completed.exchange(true))
+                    verification->promise.setValue(folly::none);
+            });
+    }
 
-        if (content.size() != size) {
-            LOG(WARNING) << "Storage test file size mismatch, expected: "
-                         << size << ", actual: " << content.size();
-            return false;
-        }
+    auto index = verified.get();
+    if (!index) {
+        // Unexpected errors fail the verification only if no mount point
+        // could be verified
+        std::lock_guard<std::mutex> guard{verification->errorMutex};
+        if (verification->error)
+            std::rethrow_exception(verification->error);
 
-        if (testFile.fileContent() != content) {
-            LOG(WARNING) << "Storage test file content mismatch, expected: '"
-                         << testFile.fileContent() << "', actual: '" << content
-                         << "'";
-            return false;
-        }
+        return {};
+    }
+
+    rememberMountPoint(storageId, mountPoints[*index]);
+    return candidates[*index];
+}
+
+bool StorageAccessManager::verifyStorageTestFile(
+    std::shared_ptr<helpers::StorageHelper> helper,
+    const messages::fuse::StorageTestFile &testFile)
+{
+    try {
+        auto content = communication::wait(
+            readStorageTestFile(helper, testFile), helper->timeout());
 
-        return true;
+        return checkStorageTestFileContent(content, testFile);
     }
     catch (const std::system_error &e) {
         auto code = e.code().value();
@@ -184,6 +272,132 @@ bool StorageAccessManager::verifyStorageTestFile(
     return false;
 }
 
+folly::Future<std::string> StorageAccessManager::readStorageTestFile(
+    std::shared_ptr<helpers::StorageHelper> helper,
+    const messages::fuse::StorageTestFile &testFile)
+{
+    const auto size = testFile.fileContent().size();
+
+    return helper->open(testFile.fileId(), O_RDONLY, {})
+        .then([size](helpers::FileHandlePtr handle) {
+            return handle->read(0, size).then(
+                [handle](folly::IOBufQueue &&buf) {
+                    std::string content;
+                    buf.appendToString(content);
+                    return content;
+                });
+        });
+}
+
+bool StorageAccessManager::checkStorageTestFileContent(
+    const std::string &content, const messages::fuse::StorageTestFile &testFile)
+{
+    const auto size = testFile.fileContent().size();
+    if (content.size() != size) {
+        LOG(WARNING) << "Storage test file size mismatch, expected: " << size
+                     << ", actual: " << content.size();
+        return false;
+    }
+
+    if (testFile.fileContent() != content) {
+        LOG(WARNING) << "Storage test file content mismatch, expected: '"
+                     << testFile.fileContent() << "', actual: '" << content
+                     << "'";
+        return false;
+    }
+
+    return true;
+}
+
+std::shared_ptr<helpers::StorageHelper> StorageAccessManager::createPosixHelper(
+    const folly::fbstring &storageId, const boost::filesystem::path &mountPoint)
+{
+    return m_helperFactory(storageId, helpers::POSIX_HELPER_NAME)
+        .getStorageHelper(helpers::POSIX_HELPER_NAME,
+            {{helpers::POSIX_HELPER_MOUNT_POINT_ARG, mountPoint.string()}},
+            m_options.isIOBuffered());
+}
+
+void StorageAccessManager::loadVerifiedMountPoints()
+{
+    if (m_cachePath.empty())
+        return;
+
+    try {
+        if (m_cachePath.has_parent_path())
+            boost::filesystem::create_directories(m_cachePath.parent_path());
+    }
+    catch (const boost::filesystem::filesystem_error &e) {
+        LOG(WARNING) << "Cannot create directory of storage access cache "
+                     << m_cachePath << ": " << e.what();
+        return;
+    }
+
+    // Later lines override earlier ones; mount points which are no longer
+    // mounted are skipped
+    std::ifstream file{m_cachePath.string()};
+    std::string line;
+    while (std::getline(file, line)) {
+        std::vector<folly::StringPiece> parts;
+        folly::split(' ', line, parts);
+
+        std::string storageId;
+        std::string mountPoint;
+        if (parts.size() != 2 || !folly::unhexlify(parts[0], storageId) ||
+            !folly::unhexlify(parts[1], mountPoint)) {
+            LOG(WARNING) << "Skipping invalid line in storage access cache "
+                         << m_cachePath << ": '" << line << "'";
+            continue;
+        }
+
+        if (std::find(m_mountPoints.begin(), m_mountPoints.end(),
+                mountPoint) != m_mountPoints.end())
+            m_verifiedMountPoints[storageId] = mountPoint;
+        else
+            m_verifiedMountPoints.erase(storageId);
+    }
+
+    LOG(INFO) << "Loaded " << m_verifiedMountPoints.size()
+              << " verified storage mount points from storage access cache "
+              << m_cachePath;
+
+    m_cacheFile.open(m_cachePath.string(), std::ios::out | std::ios::app);
+    if (!m_cacheFile)
+        LOG(WARNING) << "Cannot open storage access cache " << m_cachePath
+                     << " - verified mount points will not be persisted";
+}
+
+void StorageAccessManager::rememberMountPoint(
+    const folly::fbstring &storageId, const boost::filesystem::path &mountPoint)
+{
+    std::lock_guard<std::mutex> guard{m_verifiedMountPointsMutex};
+
+    auto &verified = m_verifiedMountPoints[storageId.toStdString()];
+    if (verified == mountPoint)
+        return;
+
+    verified = mountPoint;
+
+    LOG(INFO) << "Storage " << storageId << " is accessible at mount point "
+              << mountPoint;
+
+    if (!m_cacheFile.is_open())
+        return;
+
+    std::string hexStorageId;
+    std::string hexMountPoint;
+    folly::hexlify(storageId, hexStorageId);
+    folly::hexlify(mountPoint.string(), hexMountPoint);
+    m_cacheFile << hexStorageId << ' ' << hexMountPoint << '\n';
+    m_cacheFile.flush();
+
+    if (!m_cacheFile) {
+        LOG(WARNING) << "Failed to write mount point of storage " << storageId
+                     << " to storage access cache " << m_cachePath;
+        m_cacheFile.clear();
+    }
+}
+
 folly::fbstring StorageAccessManager::modifyStorageTestFile(
     std::shared_ptr<helpers::StorageHelper> helper,
     const messages::fuse::StorageTestFile &testFile)
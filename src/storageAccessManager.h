@@ -14,7 +14,13 @@
 
 #include <boost/filesystem.hpp>
 #include <folly/FBString.h>
+#include <folly/futures/Future.h>
 
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace one {
@@ -32,24 +38,40 @@ namespace client {
 /**
  * The StorageAccessManager class is responsible for detecting storages that are
  * directly accessible to the client.
+ * Candidate mount points of POSIX storages are verified in parallel. Mount
+ * points verified for a storage are remembered and, if a storage access cache
+ * path is set, persisted, so that they are verified first on later detections
+ * and after remount.
  */
 class StorageAccessManager {
 public:
+    /**
+     * Returns the @c helpers::StorageHelperCreator of a storage, given its id
+     * and helper name.
+     */
+    using HelperFactoryGetter = std::function<helpers::StorageHelperCreator &(
+        const folly::fbstring &, const folly::fbstring &)>;
+
     /**
      * Constructor.
-     * @param helperFactory Instance of @c helpers::StorageHelperCreator.
+     * Loads mount points verified during previous mounts, skipping the ones
+     * which are no longer mounted.
+     * @param helperFactory Function returning helper factories of storages.
+     * @param options Options instance.
      */
-    StorageAccessManager(helpers::StorageHelperCreator &helperFactory,
-        const options::Options &options);
+    StorageAccessManager(
+        HelperFactoryGetter helperFactory, const options::Options &options);
 
     /**
      * Verifies the test file by reading it from the storage and checking its
      * content with the one sent by the server.
+     * @param storageId Id of the storage of the test file.
      * @param testFile Instance of @c messages::fuse::StorageTestFile.
      * @return Storage helper object used to access the test file or nullptr if
      * verification fails.
      */
     std::shared_ptr<helpers::StorageHelper> verifyStorageTestFile(
+        const folly::fbstring &storageId,
         const messages::fuse::StorageTestFile &testFile);
 
     /**
@@ -63,12 +85,40 @@ public:
         const messages::fuse::StorageTestFile &testFile);
 
 private:
+    std::shared_ptr<helpers::StorageHelper> verifyMountPoints(
+        const folly::fbstring &storageId,
+        const messages::fuse::StorageTestFile &testFile);
+
     bool verifyStorageTestFile(std::shared_ptr<helpers::StorageHelper> helper,
         const messages::fuse::StorageTestFile &testFile);
 
-    helpers::StorageHelperCreator &m_helperFactory;
+    folly::Future<std::string> readStorageTestFile(
+        std::shared_ptr<helpers::StorageHelper> helper,
+        const messages::fuse::StorageTestFile &testFile);
+
+    static bool checkStorageTestFileContent(const std::string &content,
+        const messages::fuse::StorageTestFile &testFile);
+
+    std::shared_ptr<helpers::StorageHelper> createPosixHelper(
+        const folly::fbstring &storageId,
+        const boost::filesystem::path &mountPoint);
+
+    void loadVerifiedMountPoints();
+
+    void rememberMountPoint(const folly::fbstring &storageId,
+        const boost::filesystem::path &mountPoint);
+
+    HelperFactoryGetter m_helperFactory;
     const options::Options &m_options;
     std::vector<boost::filesystem::path> m_mountPoints;
+
+    // Mount points verified to provide direct access to storages, by storage
+    // id, and the file where they are persisted
+    std::unordered_map<std::string, boost::filesystem::path>
+        m_verifiedMountPoints;
+    boost::filesystem::path m_cachePath;
+    std::ofstream m_cacheFile;
+    std::mutex m_verifiedMountPointsMutex;
 };
 
 } // namespace client
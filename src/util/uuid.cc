@@ -0,0 +1,151 @@
+/**
+ * @file uuid.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "uuid.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace one {
+namespace client {
+namespace util {
+
+struct Uuid::Entry {
+    Entry(const folly::fbstring &value_, const std::size_t hash_)
+        : value{value_}
+        , hash{hash_}
+    {
+    }
+
+    const folly::fbstring value;
+    const std::size_t hash;
+    std::atomic<std::size_t> refCount{1};
+};
+
+namespace {
+/**
+ * Interned uuids indexed by their hashes.
+ * Reference counts of interned entries drop to zero only with the mutex
+ * held, so lookups never return an entry which is being freed.
+ */
+struct InternTable {
+    std::mutex mutex;
+    std::unordered_multimap<std::size_t, void *> entries;
+};
+
+InternTable &internTable()
+{
+    static InternTable table;
+    return table;
+}
+} // namespace
+
+Uuid::Uuid(const folly::fbstring &uuid)
+{
+    if (uuid.empty())
+        return;
+
+    const auto hash = std::hash<folly::fbstring>{}(uuid);
+    auto &table = internTable();
+
+    std::lock_guard<std::mutex> guard{table.mutex};
+    auto range = table.entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        auto entry = static_cast<Entry *>(it->second);
+        if (entry->value == uuid) {
+            entry->refCount.fetch_add(1, std::memory_order_relaxed);
+            m_entry = entry;
+            return;
+        }
+    }
+
+    m_entry = new Entry{uuid, hash};
+    table.entries.emplace(hash, m_entry);
+}
+
+Uuid::Uuid(const Uuid &other)
+    : m_entry{other.m_entry}
+{
+    if (m_entry != nullptr)
+        m_entry->refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+Uuid::Uuid(Uuid &&other) noexcept : m_entry{other.m_entry}
+{
+    other.m_entry = nullptr;
+}
+
+Uuid &Uuid::operator=(const Uuid &other)
+{
+    if (m_entry != other.m_entry) {
+        Uuid copy{other};
+        std::swap(m_entry, copy.m_entry);
+    }
+    return *this;
+}
+
+Uuid &Uuid::operator=(Uuid &&other) noexcept
+{
+    std::swap(m_entry, other.m_entry);
+    return *this;
+}
+
+Uuid::~Uuid() { release(); }
+
+const folly::fbstring &Uuid::str() const
+{
+    static const folly::fbstring empty;
+    return m_entry != nullptr ? m_entry->value : empty;
+}
+
+std::size_t Uuid::hash() const
+{
+    static const auto emptyHash = std::hash<folly::fbstring>{}({});
+    return m_entry != nullptr ? m_entry->hash : emptyHash;
+}
+
+std::size_t Uuid::internedCount()
+{
+    auto &table = internTable();
+    std::lock_guard<std::mutex> guard{table.mutex};
+    return table.entries.size();
+}
+
+void Uuid::release()
+{
+    if (m_entry == nullptr)
+        return;
+
+    // Drop a reference without locking unless it may be the last one
+    auto count = m_entry->refCount.load(std::memory_order_relaxed);
+    while (count > 1) {
+        if (m_entry->refCount.compare_exchange_weak(
+                count, count - 1, std::memory_order_acq_rel)) {
+            m_entry = nullptr;
+            return;
+        }
+    }
+
+    auto &table = internTable();
+    std::lock_guard<std::mutex> guard{table.mutex};
+    if (m_entry->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        auto range = table.entries.equal_range(m_entry->hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == m_entry) {
+                table.entries.erase(it);
+                break;
+            }
+        }
+        delete m_entry;
+    }
+
+    m_entry = nullptr;
+}
+
+} // namespace util
+} // namespace client
+} // namespace one
@@ -0,0 +1,151 @@
+/**
+ * @file uuid.h
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#pragma once
+
+#include <folly/FBString.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+
+namespace one {
+namespace client {
+namespace util {
+
+/**
+ * @c Uuid is a pointer-sized, reference counted handle to an interned file
+ * uuid.
+ * Equal uuids share a single interned string with a precomputed hash, so
+ * copying a handle does not allocate, hashing it does not read the string
+ * and comparing two handles compares pointers. Strings are interned when a
+ * handle is created from a string, e.g. at the protocol boundary, and freed
+ * when the last handle referring to them is destroyed.
+ * Handles can be used from multiple threads.
+ */
+class Uuid {
+public:
+    /**
+     * Hash function accepting both handles and strings, hashing equal
+     * values to equal hashes.
+     */
+    struct Hash {
+        std::size_t operator()(const Uuid &uuid) const { return uuid.hash(); }
+
+        std::size_t operator()(const folly::fbstring &uuid) const
+        {
+            return std::hash<folly::fbstring>{}(uuid);
+        }
+    };
+
+    /**
+     * Equality predicate accepting both handles and strings.
+     */
+    struct Equal {
+        bool operator()(const Uuid &a, const Uuid &b) const { return a == b; }
+
+        bool operator()(const Uuid &a, const folly::fbstring &b) const
+        {
+            return a.str() == b;
+        }
+
+        bool operator()(const folly::fbstring &a, const Uuid &b) const
+        {
+            return a == b.str();
+        }
+    };
+
+    /**
+     * Constructs an empty uuid.
+     */
+    Uuid() = default;
+
+    /**
+     * Constructor.
+     * Interns the uuid string.
+     * @param uuid The uuid string.
+     */
+    explicit Uuid(const folly::fbstring &uuid);
+
+    Uuid(const Uuid &other);
+    Uuid(Uuid &&other) noexcept;
+    Uuid &operator=(const Uuid &other);
+    Uuid &operator=(Uuid &&other) noexcept;
+    ~Uuid();
+
+    /**
+     * @return The uuid string.
+     */
+    const folly::fbstring &str() const;
+
+    /**
+     * @return The uuid string.
+     */
+    operator const folly::fbstring &() const { return str(); }
+
+    /**
+     * @return Hash of the uuid string, equal to its @c std::hash.
+     */
+    std::size_t hash() const;
+
+    /**
+     * @return Whether the uuid is empty.
+     */
+    bool empty() const { return m_entry == nullptr; }
+
+    bool operator==(const Uuid &other) const
+    {
+        return m_entry == other.m_entry;
+    }
+
+    bool operator!=(const Uuid &other) const { return !(*this == other); }
+
+    /**
+     * @return Number of distinct uuids currently interned.
+     */
+    static std::size_t internedCount();
+
+private:
+    struct Entry;
+
+    void release();
+
+    Entry *m_entry = nullptr;
+};
+
+inline bool operator==(const Uuid &a, const folly::fbstring &b)
+{
+    return a.str() == b;
+}
+
+inline bool operator==(const folly::fbstring &a, const Uuid &b)
+{
+    return a == b.str();
+}
+
+inline bool operator==(const Uuid &a, const char *b) { return a.str() == b; }
+
+inline bool operator==(const char *a, const Uuid &b) { return a == b.str(); }
+
+inline std::ostream &operator<<(std::ostream &o, const Uuid &uuid)
+{
+    return o << uuid.str();
+}
+
+} // namespace util
+} // namespace client
+} // namespace one
+
+namespace std {
+template <> struct hash<one::client::util::Uuid> {
+    std::size_t operator()(const one::client::util::Uuid &uuid) const
+    {
+        return uuid.hash();
+    }
+};
+} // namespace std
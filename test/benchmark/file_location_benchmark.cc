@@ -523,4 +523,66 @@ BENCHMARK(benchmarkUpdateBlocksInRange100KBlocks)
     folly::doNotOptimizeAway(fileLocation);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(benchmarkFindBlock100KBlocks)
+{
+    auto fileLocation = FileLocation{};
+    auto randomOffset = 0;
+
+    BENCHMARK_SUSPEND
+    {
+        FOR_EACH_RANGE(i, 0, 100'000)
+        {
+            fileLocation.putBlock(
+                2 * blockSize * i, blockSize, FileBlock{" ", " "});
+        }
+
+        std::time_t now = std::time(0);
+        boost::random::mt19937 gen{static_cast<std::uint32_t>(now)};
+        boost::random::uniform_int_distribution<> randomBlock(
+            0, 2 * 100'000 * blockSize - 1);
+        randomOffset = randomBlock(gen);
+    }
+
+    auto res = fileLocation.blocks().find(randomOffset);
+    folly::doNotOptimizeAway(res);
+}
+
+BENCHMARK(benchmarkUpdate100KBlocks)
+{
+    auto fileLocation = FileLocation{};
+    auto fileLocationUpdate = FileLocation{};
+
+    BENCHMARK_SUSPEND
+    {
+        FOR_EACH_RANGE(i, 0, 100'000)
+        {
+            fileLocationUpdate.putBlock(
+                2 * blockSize * i, blockSize, FileBlock{" ", " "});
+        }
+    }
+
+    fileLocation.update(fileLocationUpdate.blocks());
+    folly::doNotOptimizeAway(fileLocation);
+}
+
+BENCHMARK(benchmarkReplicationProgressAfterPutTo100KBlocks)
+{
+    auto fileLocation = FileLocation{};
+
+    BENCHMARK_SUSPEND
+    {
+        FOR_EACH_RANGE(i, 0, 100'000)
+        {
+            fileLocation.putBlock(
+                2 * blockSize * i, blockSize, FileBlock{" ", " "});
+        }
+    }
+
+    fileLocation.putBlock(blockSize, blockSize, FileBlock{" ", " "});
+    auto res = fileLocation.replicationProgress(2 * blockSize * 100'000);
+    folly::doNotOptimizeAway(res);
+}
+
 int main() { folly::runBenchmarks(); }
@@ -0,0 +1,140 @@
+/**
+ * @file metadata_cache_benchmark.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/lruMetadataCache.h"
+#include "communication/communicator.h"
+#include "messages.pb.h"
+#include "messages/fuse/fileAttr.h"
+#include "messages/fuse/fileLocation.h"
+
+#include <folly/Benchmark.h>
+#include <folly/FBString.h>
+
+#include <malloc.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace one::client::cache;
+using namespace one::messages::fuse;
+using namespace std::literals;
+
+constexpr auto entryCount = 100'000;
+
+std::string makeUuid(const int i)
+{
+    // Real uuids are base64 encoded guids of similar length
+    return "Z3VpZCNmaWxlIyIjcqG9rJ7TcMhCm4kZTExxZWY" + std::to_string(i) +
+        "I3NwYWNlX2lkXzAxMjM0NTY3ODlhYmNkZWY";
+}
+
+std::shared_ptr<FileAttr> makeAttr(const int i)
+{
+    one::clproto::FileAttr message;
+    message.set_uuid(makeUuid(i));
+    message.set_parent_uuid(makeUuid(-1));
+    message.set_name("file" + std::to_string(i) + ".dat");
+    message.set_mode(0644);
+    message.set_uid(1000);
+    message.set_gid(1000);
+    message.set_atime(0);
+    message.set_mtime(0);
+    message.set_ctime(0);
+    message.set_type(one::clproto::FileType::REG);
+    message.set_size(1024);
+    return std::make_shared<FileAttr>(message);
+}
+
+std::unique_ptr<FileLocation> makeLocation(const int i)
+{
+    one::clproto::FileLocation message;
+    message.set_uuid(makeUuid(i));
+    message.set_provider_id("Provider1");
+    message.set_space_id("Space1");
+    message.set_storage_id("Storage1");
+    message.set_file_id("/space1/file" + std::to_string(i) + ".dat");
+    message.set_version(1);
+
+    auto block = message.add_blocks();
+    block->set_file_id(message.file_id());
+    block->set_storage_id(message.storage_id());
+    block->set_offset(0);
+    block->set_size(1024);
+
+    return std::make_unique<FileLocation>(message);
+}
+
+void populate(LRUMetadataCache &cache, const int count)
+{
+    for (int i = 0; i < count; ++i) {
+        cache.putAttr(makeAttr(i));
+        cache.putLocation(makeLocation(i));
+    }
+}
+
+BENCHMARK(benchmarkPut100KEntries)
+{
+    std::unique_ptr<one::communication::Communicator> communicator;
+    std::unique_ptr<LRUMetadataCache> cache;
+
+    BENCHMARK_SUSPEND
+    {
+        communicator = std::make_unique<one::communication::Communicator>(
+            1, 1, "127.0.0.1", 80, false);
+        cache = std::make_unique<LRUMetadataCache>(
+            *communicator, entryCount, 10s);
+    }
+
+    populate(*cache, entryCount);
+
+    folly::doNotOptimizeAway(cache);
+}
+
+BENCHMARK(benchmarkPut100KEntriesWith10KLimit)
+{
+    std::unique_ptr<one::communication::Communicator> communicator;
+    std::unique_ptr<LRUMetadataCache> cache;
+
+    BENCHMARK_SUSPEND
+    {
+        communicator = std::make_unique<one::communication::Communicator>(
+            1, 1, "127.0.0.1", 80, false);
+        cache = std::make_unique<LRUMetadataCache>(
+            *communicator, entryCount / 10, 10s);
+    }
+
+    populate(*cache, entryCount);
+
+    folly::doNotOptimizeAway(cache);
+}
+
+/**
+ * Reports heap memory used per cached file, measured as the growth of
+ * allocated heap after caching attributes and location of @c entryCount
+ * files, next to the footprint estimated by the cache for the memory limit.
+ */
+void reportMemoryPerEntry()
+{
+    one::communication::Communicator communicator{
+        1, 1, "127.0.0.1", 80, false};
+    LRUMetadataCache cache{communicator, entryCount, 10s};
+
+    const auto before = mallinfo().uordblks;
+    populate(cache, entryCount);
+    const auto after = mallinfo().uordblks;
+
+    std::cout << "Memory per metadata cache entry: "
+              << (after - before) / entryCount << " bytes (estimated "
+              << cache.footprint() / entryCount << " bytes)" << std::endl;
+}
+
+int main()
+{
+    folly::runBenchmarks();
+    reportMemoryPerEntry();
+}
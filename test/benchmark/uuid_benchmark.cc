@@ -0,0 +1,99 @@
+/**
+ * @file uuid_benchmark.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/inodeCache.h"
+#include "util/uuid.h"
+
+#include <folly/Benchmark.h>
+#include <folly/FBString.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace one::client;
+
+constexpr auto entryCount = 100'000;
+
+folly::fbstring makeUuid(const int i)
+{
+    // Real uuids are base64 encoded guids of similar length
+    return folly::fbstring{"Z3VpZCNmaWxlIyIjcqG9rJ7TcMhCm4kZTExxZWY"} +
+        std::to_string(i).c_str() + "I3NwYWNlX2lkXzAxMjM0NTY3ODlhYmNkZWY";
+}
+
+/**
+ * Translating an inode to an uuid and using the uuid as a key of another
+ * cache is what every FUSE operation, e.g. getattr, starts with. These
+ * benchmarks compare copying and hashing plain uuid strings with copying and
+ * hashing interned uuids.
+ */
+BENCHMARK(benchmarkCopyAndHashStringUuids, n)
+{
+    std::vector<folly::fbstring> uuids;
+    BENCHMARK_SUSPEND
+    {
+        for (int i = 0; i < entryCount; ++i)
+            uuids.emplace_back(makeUuid(i));
+    }
+
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const folly::fbstring uuid = uuids[i % entryCount];
+        result += std::hash<folly::fbstring>{}(uuid);
+    }
+
+    folly::doNotOptimizeAway(result);
+}
+
+BENCHMARK_RELATIVE(benchmarkCopyAndHashInternedUuids, n)
+{
+    std::vector<util::Uuid> uuids;
+    BENCHMARK_SUSPEND
+    {
+        for (int i = 0; i < entryCount; ++i)
+            uuids.emplace_back(makeUuid(i));
+    }
+
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const util::Uuid uuid = uuids[i % entryCount];
+        result += std::hash<util::Uuid>{}(uuid);
+    }
+
+    folly::doNotOptimizeAway(result);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(benchmarkInodeCacheAtThenLookup100KEntries, n)
+{
+    std::unique_ptr<cache::InodeCache> inodeCache;
+    std::unordered_map<folly::fbstring, int> attrs;
+    std::vector<fuse_ino_t> inodes;
+
+    BENCHMARK_SUSPEND
+    {
+        inodeCache = std::make_unique<cache::InodeCache>("rootUuid");
+        for (int i = 0; i < entryCount; ++i) {
+            inodes.emplace_back(inodeCache->lookup(makeUuid(i)));
+            attrs.emplace(makeUuid(i), i);
+        }
+    }
+
+    int result = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto uuid = inodeCache->at(inodes[i % entryCount]);
+        result += attrs.find(uuid)->second;
+    }
+
+    folly::doNotOptimizeAway(result);
+}
+
+int main() { folly::runBenchmarks(); }
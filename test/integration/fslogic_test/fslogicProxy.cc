@@ -180,6 +180,21 @@ public:
             uuid, statbuf, FUSE_SET_ATTR_ATIME | FUSE_SET_ATTR_MTIME);
     }
 
+    void setattr(std::string uuid, int mode, int size, Ubuf ubuf)
+    {
+        ReleaseGIL guard;
+
+        struct stat statbuf = {};
+        statbuf.st_mode = mode;
+        statbuf.st_size = size;
+        statbuf.st_atime = ubuf.actime;
+        statbuf.st_mtime = ubuf.modtime;
+
+        m_fsLogic.setattr(uuid, statbuf,
+            FUSE_SET_ATTR_MODE | FUSE_SET_ATTR_SIZE | FUSE_SET_ATTR_ATIME |
+                FUSE_SET_ATTR_MTIME);
+    }
+
     std::vector<std::string> readdir(
         std::string uuid, int chunkSize, int offset)
     {
@@ -368,6 +383,7 @@ BOOST_PYTHON_MODULE(fslogic)
         .def("chmod", &FsLogicProxy::chmod)
         .def("utime", &FsLogicProxy::utime)
         .def("utime_buf", &FsLogicProxy::utime_buf)
+        .def("setattr", &FsLogicProxy::setattr)
         .def("readdir", &FsLogicProxy::readdir)
         .def("mknod", &FsLogicProxy::mknod)
         .def("open", &FsLogicProxy::open)
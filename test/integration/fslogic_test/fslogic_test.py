@@ -235,7 +235,7 @@ def do_open(endpoint, fl, uuid, size=None, blocks=[], handle_id='handle_id'):
     location_response = prepare_location_response(uuid, blocks)
     open_response = prepare_open_response(handle_id)
 
-    with reply(endpoint, [attr_response, location_response, open_response]):
+    with reply(endpoint, [attr_response, open_response, location_response]):
         handle = fl.open(uuid, 0)
         assert handle >= 0
         return handle
@@ -343,6 +343,25 @@ def test_mkdir_should_pass_mkdir_errors(endpoint, fl):
     assert 'Operation not permitted' in str(excinfo.value)
 
 
+def test_mkdir_should_cache_attrs_returned_by_provider(endpoint, fl, uuid):
+    mkdir_response = prepare_attr_response(uuid, fuse_messages_pb2.DIR)
+
+    with reply(endpoint, [mkdir_response]) as queue:
+        fl.mkdir('parentUuid', 'name', 0123)
+        client_message = queue.get()
+
+    assert client_message.HasField('fuse_request')
+    assert client_message.fuse_request.HasField('file_request')
+
+    file_request = client_message.fuse_request.file_request
+    assert file_request.HasField('create_dir')
+
+    stat = fl.getattr(uuid)
+
+    assert stat.uid == mkdir_response.fuse_response.file_attr.uid
+    assert stat.gid == mkdir_response.fuse_response.file_attr.gid
+
+
 def test_rmdir_should_rmdir(endpoint, fl, uuid):
     getattr_response = prepare_attr_response(uuid, fuse_messages_pb2.DIR)
     response = messages_pb2.ServerMessage()
@@ -569,6 +588,41 @@ def test_utime_should_pass_utime_errors(endpoint, fl, uuid, stat):
     assert 'Operation not permitted' in str(excinfo.value)
 
 
+def test_setattr_should_stop_at_first_error(appmock_client,
+                                                           endpoint, fl, uuid):
+    getattr_response = prepare_attr_response(uuid, fuse_messages_pb2.REG)
+
+    with reply(endpoint, getattr_response):
+        fl.getattr(uuid)
+
+    appmock_client.reset_tcp_history()
+
+    ok_response = messages_pb2.ServerMessage()
+    ok_response.fuse_response.status.code = common_messages_pb2.Status.ok
+    eperm_response = messages_pb2.ServerMessage()
+    eperm_response.fuse_response.status.code = \
+        common_messages_pb2.Status.eperm
+
+    ubuf = fslogic.Ubuf()
+    ubuf.actime = 54321
+    ubuf.modtime = 12345
+
+    # Mode change, truncate and times update are sent in this order, each
+    # after the previous one succeeds, and the truncate fails
+    with pytest.raises(RuntimeError) as excinfo:
+        with reply(endpoint, [ok_response, eperm_response]):
+            fl.setattr(uuid, 0356, 4, ubuf)
+
+    assert 'Operation not permitted' in str(excinfo.value)
+
+    stat = fl.getattr(uuid)
+
+    assert stat.mode == 0356 | fslogic.regularMode()
+    assert stat.size == getattr_response.fuse_response.file_attr.size
+    assert stat.atime == getattr_response.fuse_response.file_attr.atime
+    assert stat.mtime == getattr_response.fuse_response.file_attr.mtime
+
+
 def test_readdir_should_read_dir(endpoint, fl, uuid, stat):
     #
     # Prepare first response with 5 files
@@ -0,0 +1,70 @@
+/**
+ * @file cache_snapshot_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/cacheSnapshot.h"
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+using namespace ::testing;
+using namespace one::client::cache;
+
+struct CacheSnapshotTest : public ::testing::Test {
+    ~CacheSnapshotTest() { boost::filesystem::remove(path); }
+
+    boost::filesystem::path path{boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path()};
+};
+
+TEST_F(CacheSnapshotTest, loadShouldReturnSavedUuids)
+{
+    CacheSnapshot snapshot{path};
+    std::vector<folly::fbstring> uuids{"uuid1", folly::fbstring{"\0\n ", 3}};
+
+    EXPECT_TRUE(snapshot.enabled());
+    EXPECT_TRUE(snapshot.load().empty());
+    EXPECT_TRUE(snapshot.save(uuids));
+    EXPECT_EQ(uuids, CacheSnapshot{path}.load());
+
+    EXPECT_TRUE(snapshot.save({"uuid3"}));
+    EXPECT_EQ(std::vector<folly::fbstring>{"uuid3"}, snapshot.load());
+}
+
+TEST_F(CacheSnapshotTest, disabledSnapshotShouldNotBeSaved)
+{
+    CacheSnapshot snapshot{{}};
+
+    EXPECT_FALSE(snapshot.enabled());
+    EXPECT_FALSE(snapshot.save({"uuid1"}));
+    EXPECT_TRUE(snapshot.load().empty());
+}
+
+TEST_F(CacheSnapshotTest, loadShouldIgnoreSnapshotWithUnknownVersion)
+{
+    {
+        std::ofstream file{path.string()};
+        file << "oneclient-cache-snapshot 2\n"
+             << "7575696431\n";
+    }
+
+    EXPECT_TRUE(CacheSnapshot{path}.load().empty());
+}
+
+TEST_F(CacheSnapshotTest, loadShouldSkipInvalidLines)
+{
+    {
+        std::ofstream file{path.string()};
+        file << "oneclient-cache-snapshot 1\n"
+             << "7575696431\n"
+             << "not hex\n";
+    }
+
+    EXPECT_EQ(
+        std::vector<folly::fbstring>{"uuid1"}, CacheSnapshot{path}.load());
+}
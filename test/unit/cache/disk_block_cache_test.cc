@@ -0,0 +1,184 @@
+/**
+ * @file disk_block_cache_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/diskBlockCache.h"
+
+#include <boost/filesystem.hpp>
+#include <folly/FBString.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace one;
+using namespace one::client::cache;
+
+namespace {
+constexpr std::size_t CHUNK_SIZE = 10;
+
+folly::IOBufQueue makeData(const std::string &data)
+{
+    folly::IOBufQueue queue{folly::IOBufQueue::cacheChainLength()};
+    queue.append(data);
+    return queue;
+}
+
+std::string toString(folly::IOBufQueue queue)
+{
+    std::string result;
+    queue.appendToString(result);
+    return result;
+}
+}
+
+class DiskBlockCacheTest : public ::testing::Test {
+public:
+    DiskBlockCacheTest()
+        : directory{boost::filesystem::temp_directory_path() /
+              boost::filesystem::unique_path()}
+    {
+    }
+
+    ~DiskBlockCacheTest() { boost::filesystem::remove_all(directory); }
+
+    const boost::filesystem::path directory;
+};
+
+TEST_F(DiskBlockCacheTest, cacheShouldBeDisabledWithoutDirectory)
+{
+    DiskBlockCache cache{{}, 100, CHUNK_SIZE};
+
+    EXPECT_FALSE(cache.enabled());
+
+    cache.write("uuid1", 1, 10, 0, makeData("0123456789"));
+    EXPECT_FALSE(cache.read("uuid1", 1, 0, 10));
+}
+
+TEST_F(DiskBlockCacheTest, readShouldReturnWrittenData)
+{
+    DiskBlockCache cache{directory, 100, CHUNK_SIZE};
+    ASSERT_TRUE(cache.enabled());
+
+    EXPECT_FALSE(cache.read("uuid1", 1, 0, 5));
+
+    cache.write("uuid1", 1, 25, 0, makeData("0123456789abcdefghijklmno"));
+    cache.drain();
+    EXPECT_EQ(25, cache.size());
+
+    auto head = cache.read("uuid1", 1, 2, 5);
+    ASSERT_TRUE(head);
+    EXPECT_EQ("23456", toString(std::move(*head).get()));
+
+    auto tail = cache.read("uuid1", 1, 20, 5);
+    ASSERT_TRUE(tail);
+    EXPECT_EQ("klmno", toString(std::move(*tail).get()));
+
+    // Ranges crossing chunk boundary are not served from the cache
+    EXPECT_FALSE(cache.read("uuid1", 1, 8, 5));
+}
+
+TEST_F(DiskBlockCacheTest, readShouldMissNotWrittenRanges)
+{
+    DiskBlockCache cache{directory, 100, CHUNK_SIZE};
+
+    cache.write("uuid1", 1, 10, 0, makeData("01234"));
+    cache.drain();
+
+    EXPECT_TRUE(cache.read("uuid1", 1, 0, 5));
+    EXPECT_FALSE(cache.read("uuid1", 1, 3, 5));
+    EXPECT_FALSE(cache.read("uuid2", 1, 0, 5));
+}
+
+TEST_F(DiskBlockCacheTest, readShouldDropOutdatedData)
+{
+    DiskBlockCache cache{directory, 100, CHUNK_SIZE};
+
+    cache.write("uuid1", 1, 10, 0, makeData("0123456789"));
+    cache.drain();
+
+    EXPECT_FALSE(cache.read("uuid1", 2, 0, 10));
+    EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(DiskBlockCacheTest, writeShouldEvictLeastRecentlyUsedChunks)
+{
+    DiskBlockCache cache{directory, 20, CHUNK_SIZE};
+
+    cache.write("uuid1", 1, 10, 0, makeData("0123456789"));
+    cache.write("uuid2", 1, 10, 0, makeData("0123456789"));
+    cache.drain();
+    EXPECT_EQ(20, cache.size());
+
+    EXPECT_TRUE(cache.read("uuid1", 1, 0, 10));
+
+    cache.write("uuid3", 1, 5, 0, makeData("01234"));
+    cache.drain();
+    EXPECT_EQ(15, cache.size());
+
+    EXPECT_TRUE(cache.read("uuid1", 1, 0, 10));
+    EXPECT_FALSE(cache.read("uuid2", 1, 0, 10));
+    EXPECT_TRUE(cache.read("uuid3", 1, 0, 5));
+}
+
+TEST_F(DiskBlockCacheTest, invalidateShouldRemoveData)
+{
+    DiskBlockCache cache{directory, 100, CHUNK_SIZE};
+
+    cache.write("uuid1", 1, 20, 0, makeData("0123456789abcdefghij"));
+    cache.drain();
+
+    cache.invalidate("uuid1");
+    cache.drain();
+
+    EXPECT_EQ(0, cache.size());
+    EXPECT_FALSE(cache.read("uuid1", 1, 0, 10));
+    EXPECT_TRUE(boost::filesystem::is_empty(directory));
+}
+
+TEST_F(DiskBlockCacheTest, invalidateShouldDropQueuedWrites)
+{
+    DiskBlockCache cache{directory, 100, CHUNK_SIZE};
+
+    for (auto i = 0; i < 10; ++i) {
+        cache.write("uuid1", 1, 20, 0, makeData("0123456789abcdefghij"));
+        cache.invalidate("uuid1");
+    }
+    cache.drain();
+
+    EXPECT_EQ(0, cache.size());
+    EXPECT_FALSE(cache.read("uuid1", 1, 0, 10));
+    EXPECT_TRUE(boost::filesystem::is_empty(directory));
+
+    // Data written after the invalidation is cached again
+    cache.write("uuid1", 1, 20, 0, makeData("0123456789abcdefghij"));
+    cache.drain();
+
+    EXPECT_EQ(20, cache.size());
+    EXPECT_TRUE(cache.read("uuid1", 1, 0, 10));
+}
+
+TEST_F(DiskBlockCacheTest, completeChunksShouldPersistAcrossInstances)
+{
+    {
+        DiskBlockCache cache{directory, 100, CHUNK_SIZE};
+        cache.write("uuid1", 1, 15, 0, makeData("0123456789abcde"));
+        cache.write("uuid2", 1, 10, 0, makeData("01234"));
+        cache.drain();
+    }
+
+    DiskBlockCache cache{directory, 100, CHUNK_SIZE};
+    EXPECT_EQ(15, cache.size());
+
+    auto first = cache.read("uuid1", 1, 0, 10);
+    ASSERT_TRUE(first);
+    EXPECT_EQ("0123456789", toString(std::move(*first).get()));
+
+    auto last = cache.read("uuid1", 1, 10, 5);
+    ASSERT_TRUE(last);
+    EXPECT_EQ("abcde", toString(std::move(*last).get()));
+
+    // Partially filled chunks are discarded on startup
+    EXPECT_FALSE(cache.read("uuid2", 1, 0, 5));
+}
@@ -0,0 +1,152 @@
+/**
+ * @file eviction_policy_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/evictionPolicy.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+using namespace ::testing;
+using namespace one::client::cache;
+
+TEST(EvictionPolicyTest, parseEvictionPolicyTypeShouldAcceptKnownNames)
+{
+    EXPECT_EQ(EvictionPolicyType::lru, parseEvictionPolicyType("lru"));
+    EXPECT_EQ(EvictionPolicyType::twoQueue, parseEvictionPolicyType("2q"));
+    EXPECT_THROW(parseEvictionPolicyType("arc"), std::invalid_argument);
+}
+
+TEST(EvictionPolicyTest, lruPolicyShouldEvictLeastRecentlyUsedEntries)
+{
+    EvictionPolicy<int> policy{EvictionPolicyType::lru, 10};
+
+    policy.insert(1);
+    policy.insert(2);
+    policy.insert(3);
+    policy.touch(1);
+
+    EXPECT_EQ(3, policy.size());
+    EXPECT_EQ(2, policy.evict());
+    EXPECT_EQ(3, policy.evict());
+    EXPECT_EQ(1, policy.evict());
+    EXPECT_TRUE(policy.empty());
+}
+
+TEST(EvictionPolicyTest, eraseShouldMakeEntryNotEvictable)
+{
+    EvictionPolicy<int> policy{EvictionPolicyType::twoQueue, 10};
+
+    policy.insert(1);
+    policy.insert(2);
+    policy.erase(1);
+
+    EXPECT_FALSE(policy.contains(1));
+    EXPECT_TRUE(policy.contains(2));
+    EXPECT_EQ(2, policy.evict());
+    EXPECT_TRUE(policy.empty());
+}
+
+TEST(EvictionPolicyTest, renameShouldKeepPositionOfEntry)
+{
+    EvictionPolicy<int> policy{EvictionPolicyType::lru, 10};
+
+    policy.insert(1);
+    policy.insert(2);
+    policy.rename(1, 3);
+
+    EXPECT_FALSE(policy.contains(1));
+    EXPECT_EQ(3, policy.evict());
+    EXPECT_EQ(2, policy.evict());
+}
+
+TEST(EvictionPolicyTest, twoQueuePolicyShouldProtectEntriesFromScans)
+{
+    auto scan = [](EvictionPolicy<int> &policy) {
+        // Each scanned entry is accessed twice, e.g. by lookup and getattr
+        for (int key = 100; key < 200; ++key) {
+            policy.insert(key);
+            policy.touch(key);
+            if (policy.size() > 4)
+                policy.evict();
+        }
+    };
+
+    EvictionPolicy<int> lruPolicy{EvictionPolicyType::lru, 8};
+    lruPolicy.insert(1);
+    scan(lruPolicy);
+    EXPECT_FALSE(lruPolicy.contains(1));
+
+    // Entry 1 is evicted once, then referenced again and admitted to the
+    // protected queue
+    EvictionPolicy<int> twoQueuePolicy{EvictionPolicyType::twoQueue, 8};
+    twoQueuePolicy.insert(1);
+    EXPECT_EQ(1, twoQueuePolicy.evict());
+    twoQueuePolicy.insert(1);
+    scan(twoQueuePolicy);
+    EXPECT_TRUE(twoQueuePolicy.contains(1));
+    EXPECT_EQ(4, twoQueuePolicy.size());
+}
+
+TEST(EvictionPolicyTest, twoQueuePolicyShouldForgetOldGhostEntries)
+{
+    EvictionPolicy<int> policy{EvictionPolicyType::twoQueue, 4};
+
+    policy.insert(1);
+    EXPECT_EQ(1, policy.evict());
+
+    // Ghost list holds half of the capacity
+    for (int key = 2; key < 4; ++key) {
+        policy.insert(key);
+        EXPECT_EQ(key, policy.evict());
+    }
+
+    policy.insert(1);
+    policy.insert(2);
+    policy.insert(3);
+
+    // Entry 1 was forgotten, so it lands in probation and is evicted first
+    EXPECT_EQ(1, policy.evict());
+}
+
+TEST(EvictionPolicyTest, keysShouldListEntriesEvictedLastFirst)
+{
+    EvictionPolicy<int> policy{EvictionPolicyType::twoQueue, 8};
+
+    policy.insert(1);
+    EXPECT_EQ(1, policy.evict());
+    policy.insert(1);
+    policy.insert(2);
+    policy.insert(3);
+
+    EXPECT_EQ((std::vector<int>{1, 3, 2}), policy.keys(10));
+    EXPECT_EQ((std::vector<int>{1, 3}), policy.keys(2));
+}
+
+TEST(EvictionPolicyTest, reinsertedEntryShouldStayProtected)
+{
+    EvictionPolicy<int> policy{EvictionPolicyType::twoQueue, 8};
+
+    policy.insert(1);
+    EXPECT_FALSE(policy.isProtected(1));
+    EXPECT_EQ(1, policy.evict());
+
+    // Entry inserted again while remembered is admitted to protected queue
+    policy.insert(1);
+    EXPECT_TRUE(policy.isProtected(1));
+
+    const bool wasProtected = policy.isProtected(1);
+    policy.erase(1);
+    EXPECT_FALSE(policy.isProtected(1));
+    policy.insert(1, wasProtected);
+    EXPECT_TRUE(policy.isProtected(1));
+
+    policy.insert(2);
+    policy.insert(3);
+    EXPECT_EQ(2, policy.evict());
+    EXPECT_TRUE(policy.contains(1));
+}
@@ -0,0 +1,97 @@
+/**
+ * @file helpers_io_pool_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/helpersIoPool.h"
+
+#include <asio/post.hpp>
+#include <gtest/gtest.h>
+
+#include <future>
+
+using namespace ::testing;
+using namespace one::client;
+using namespace std::literals;
+
+TEST(HelpersIoPoolTest, poolShouldExecutePostedOperations)
+{
+    cache::HelpersIoPool pool{"posix", 2};
+    EXPECT_EQ(2, pool.threadCount());
+    pool.start();
+
+    std::promise<void> executed;
+    asio::post(pool.ioService(), [&] { executed.set_value(); });
+
+    EXPECT_EQ(std::future_status::ready,
+        executed.get_future().wait_for(1s));
+}
+
+TEST(HelpersIoPoolTest, poolShouldHaveAtLeastOneThread)
+{
+    cache::HelpersIoPool pool{"posix", 0};
+    EXPECT_EQ(1, pool.threadCount());
+}
+
+TEST(HelpersIoPoolTest, probeShouldRecordQueueLatencyOfBusyPool)
+{
+    cache::HelpersIoPool pool{"posix", 1};
+    pool.start();
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    asio::post(pool.ioService(), [released] { released.wait(); });
+
+    pool.probe();
+    std::this_thread::sleep_for(100ms);
+    pool.probe();
+
+    EXPECT_GE(pool.queueLatency(), 100ms);
+
+    release.set_value();
+    std::this_thread::sleep_for(100ms);
+    pool.probe();
+    std::this_thread::sleep_for(100ms);
+
+    EXPECT_LT(pool.queueLatency(), 100ms);
+}
+
+TEST(HelpersIoPoolTest, poolShouldNotExecuteOperationsBeforeStart)
+{
+    cache::HelpersIoPool pool{"posix", 2};
+    EXPECT_FALSE(pool.started());
+
+    std::promise<void> executed;
+    auto future = executed.get_future();
+    asio::post(pool.ioService(), [&] { executed.set_value(); });
+
+    EXPECT_EQ(std::future_status::timeout, future.wait_for(100ms));
+
+    pool.start();
+    pool.start();
+    EXPECT_TRUE(pool.started());
+    EXPECT_EQ(std::future_status::ready, future.wait_for(1s));
+}
+
+TEST(HelpersIoPoolTest, probeShouldSkipPoolWhichHasNotBeenStarted)
+{
+    cache::HelpersIoPool pool{"posix", 1};
+
+    pool.probe();
+    std::this_thread::sleep_for(100ms);
+    pool.probe();
+
+    EXPECT_EQ(0us, pool.queueLatency());
+}
+
+TEST(HelpersIoPoolTest, stopShouldBeIdempotent)
+{
+    cache::HelpersIoPool pool{"posix", 2};
+    pool.start();
+    pool.stop();
+    pool.stop();
+    pool.start();
+    EXPECT_TRUE(pool.started());
+}
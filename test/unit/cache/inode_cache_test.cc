@@ -0,0 +1,222 @@
+/**
+ * @file inode_cache_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/inodeCache.h"
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+using namespace ::testing;
+using namespace one::client::cache;
+
+TEST(InodeCacheTest, lookupShouldReturnSameInodeForSameUuid)
+{
+    InodeCache cache{"rootUuid"};
+
+    EXPECT_EQ("rootUuid", cache.at(FUSE_ROOT_ID));
+
+    const auto inode1 = cache.lookup("uuid1");
+    const auto inode2 = cache.lookup("uuid2");
+
+    EXPECT_NE(FUSE_ROOT_ID, inode1);
+    EXPECT_NE(inode1, inode2);
+    EXPECT_EQ(inode1, cache.lookup("uuid1"));
+    EXPECT_EQ("uuid1", cache.at(inode1));
+    EXPECT_EQ("uuid2", cache.at(inode2));
+    EXPECT_THROW(cache.at(inode2 + 1), std::out_of_range);
+}
+
+TEST(InodeCacheTest, forgetShouldDeactivateInodeWhenLookupCountDrops)
+{
+    InodeCache cache{"rootUuid"};
+
+    const auto inode = cache.lookup("uuid1");
+    cache.lookup("uuid1");
+
+    cache.forget(inode, 1);
+    EXPECT_EQ("uuid1", cache.at(inode));
+
+    cache.forget(inode, 1);
+    EXPECT_THROW(cache.at(inode), std::out_of_range);
+
+    EXPECT_EQ(inode, cache.lookup("uuid1"));
+    EXPECT_EQ("uuid1", cache.at(inode));
+}
+
+TEST(InodeCacheTest, lookupShouldPruneForgottenInodes)
+{
+    InodeCache cache{"rootUuid", 2};
+
+    const auto inode1 = cache.lookup("uuid1");
+    cache.forget(inode1, 1);
+
+    const auto inode2 = cache.lookup("uuid2");
+    EXPECT_EQ("uuid2", cache.at(inode2));
+
+    EXPECT_NE(inode1, cache.lookup("uuid1"));
+}
+
+TEST(InodeCacheTest, renameShouldChangeUuidOfInode)
+{
+    InodeCache cache{"rootUuid"};
+
+    const auto inode = cache.lookup("uuid1");
+    cache.rename("uuid1", "uuid2");
+
+    EXPECT_EQ("uuid2", cache.at(inode));
+    EXPECT_EQ(inode, cache.lookup("uuid2"));
+}
+
+TEST(InodeCacheTest, forgetShouldRemoveDeletedInodes)
+{
+    InodeCache cache{"rootUuid"};
+
+    const auto inode = cache.lookup("uuid1");
+    cache.markDeleted("uuid1");
+    EXPECT_EQ("uuid1", cache.at(inode));
+
+    cache.forget(inode, 1);
+    EXPECT_THROW(cache.at(inode), std::out_of_range);
+    EXPECT_NE(inode, cache.lookup("uuid1"));
+}
+
+TEST(InodeCacheTest, stableInodesShouldNotDependOnLookupOrder)
+{
+    InodeCache cache1{"rootUuid", 100, EvictionPolicyType::lru, true};
+    const auto inode1 = cache1.lookup("uuid1");
+    const auto inode2 = cache1.lookup("uuid2");
+
+    InodeCache cache2{"rootUuid", 100, EvictionPolicyType::lru, true};
+    EXPECT_EQ(inode2, cache2.lookup("uuid2"));
+    EXPECT_EQ(inode1, cache2.lookup("uuid1"));
+}
+
+TEST(InodeCacheTest, stableInodesShouldSurvivePruning)
+{
+    InodeCache cache{"rootUuid", 2, EvictionPolicyType::lru, true};
+
+    const auto inode1 = cache.lookup("uuid1");
+    cache.forget(inode1, 1);
+    EXPECT_EQ("uuid1", cache.at(inode1));
+
+    cache.lookup("uuid2");
+    EXPECT_EQ(inode1, cache.lookup("uuid1"));
+}
+
+TEST(InodeCacheTest, lookupShouldNotDemoteProtectedInodes)
+{
+    InodeCache cache{"rootUuid", 4, EvictionPolicyType::twoQueue, true};
+
+    const auto inode1 = cache.lookup("uuid1");
+    cache.forget(inode1, 1);
+
+    const auto inode2 = cache.lookup("uuid2");
+    const auto inode3 = cache.lookup("uuid3");
+    cache.lookup("uuid4");
+    cache.forget(inode2, 1);
+
+    // Inode 1 was evicted from probation and is protected when it is
+    // forgotten again
+    EXPECT_EQ(inode1, cache.lookup("uuid1"));
+    cache.forget(inode1, 1);
+
+    cache.lookup("uuid1");
+    cache.forget(inode1, 1);
+    cache.forget(inode3, 1);
+    cache.lookup("uuid5");
+
+    EXPECT_EQ("uuid1", cache.at(inode1));
+    EXPECT_THROW(cache.at(inode3), std::out_of_range);
+}
+
+TEST(InodeCacheTest, prunedFilesShouldBeRememberedAcrossNewInodes)
+{
+    InodeCache cache{"rootUuid", 4, EvictionPolicyType::twoQueue};
+
+    const auto inode1 = cache.lookup("uuid1");
+    cache.forget(inode1, 1);
+
+    const auto inode2 = cache.lookup("uuid2");
+    const auto inode3 = cache.lookup("uuid3");
+    cache.lookup("uuid4");
+    cache.forget(inode2, 1);
+
+    // File 1 was evicted from probation and gets a new inode, but it's still
+    // remembered and protected when it is forgotten again
+    const auto newInode1 = cache.lookup("uuid1");
+    EXPECT_NE(inode1, newInode1);
+    cache.forget(newInode1, 1);
+
+    cache.forget(inode3, 1);
+    cache.lookup("uuid5");
+
+    EXPECT_EQ(newInode1, cache.lookup("uuid1"));
+    EXPECT_NE(inode3, cache.lookup("uuid3"));
+}
+
+TEST(InodeCacheTest, inodeTableShouldPersistInodesAcrossInstances)
+{
+    const auto tablePath = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path();
+
+    fuse_ino_t inode1 = 0;
+    fuse_ino_t inode2 = 0;
+    {
+        InodeCache cache{
+            "rootUuid", 100, EvictionPolicyType::lru, false, tablePath};
+        inode1 = cache.lookup("uuid1");
+        inode2 = cache.lookup("uuid2");
+        cache.rename("uuid2", "uuid3");
+    }
+
+    {
+        InodeCache cache{
+            "rootUuid", 100, EvictionPolicyType::lru, false, tablePath};
+        EXPECT_EQ("uuid1", cache.at(inode1));
+        EXPECT_EQ("uuid3", cache.at(inode2));
+        EXPECT_EQ(inode2, cache.lookup("uuid3"));
+
+        const auto inode4 = cache.lookup("uuid4");
+        EXPECT_NE(inode1, inode4);
+        EXPECT_NE(inode2, inode4);
+    }
+
+    boost::filesystem::remove(tablePath);
+}
+
+TEST(InodeCacheTest, inodeTableShouldDropDeletedAndRenamedFiles)
+{
+    const auto tablePath = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path();
+
+    fuse_ino_t inode1 = 0;
+    fuse_ino_t inode2 = 0;
+    fuse_ino_t inode3 = 0;
+    {
+        InodeCache cache{
+            "rootUuid", 2, EvictionPolicyType::lru, false, tablePath};
+        inode1 = cache.lookup("uuid1");
+        cache.markDeleted("uuid1");
+        cache.forget(inode1, 1);
+
+        // Inode 2 is pruned from the cache before its file is renamed
+        inode2 = cache.lookup("uuid2");
+        cache.forget(inode2, 1);
+        inode3 = cache.lookup("uuid3");
+        cache.rename("uuid2", "uuid4");
+        cache.markDeleted("uuid3");
+    }
+
+    InodeCache cache{"rootUuid", 2, EvictionPolicyType::lru, false, tablePath};
+    EXPECT_THROW(cache.at(inode1), std::out_of_range);
+    EXPECT_EQ("uuid4", cache.at(inode2));
+    EXPECT_EQ("uuid3", cache.at(inode3));
+
+    boost::filesystem::remove(tablePath);
+}
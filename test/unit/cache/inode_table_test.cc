@@ -0,0 +1,130 @@
+/**
+ * @file inode_table_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/inodeTable.h"
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <thread>
+
+using namespace ::testing;
+using namespace one::client::cache;
+
+namespace {
+std::size_t countLines(const boost::filesystem::path &path)
+{
+    std::ifstream file{path.string()};
+    std::size_t lines = 0;
+    std::string line;
+    while (std::getline(file, line))
+        ++lines;
+
+    return lines;
+}
+} // namespace
+
+class InodeTableTest : public ::testing::Test {
+public:
+    InodeTableTest()
+        : path{boost::filesystem::temp_directory_path() /
+              boost::filesystem::unique_path()}
+    {
+    }
+
+    ~InodeTableTest() { boost::filesystem::remove(path); }
+
+    const boost::filesystem::path path;
+};
+
+TEST_F(InodeTableTest, eraseShouldRemoveAssociationAcrossInstances)
+{
+    {
+        InodeTable table{path};
+        table.put(2, "uuid1");
+        table.put(3, "uuid2");
+        table.erase(2);
+
+        EXPECT_FALSE(table.uuid(2));
+        EXPECT_FALSE(table.inode("uuid1"));
+    }
+
+    InodeTable table{path};
+    EXPECT_FALSE(table.uuid(2));
+    EXPECT_FALSE(table.inode("uuid1"));
+    EXPECT_EQ("uuid2", table.uuid(3).value());
+    EXPECT_EQ(3, table.inode("uuid2").value());
+}
+
+TEST_F(InodeTableTest, loadShouldCompactOutdatedLines)
+{
+    {
+        InodeTable table{path};
+        table.put(2, "uuid1");
+        table.put(2, "uuid2");
+        table.put(3, "uuid3");
+        table.put(4, "uuid4");
+        table.erase(4);
+    }
+
+    EXPECT_EQ(5, countLines(path));
+
+    InodeTable table{path};
+    EXPECT_EQ(2, countLines(path));
+    EXPECT_EQ("uuid2", table.uuid(2).value());
+    EXPECT_EQ("uuid3", table.uuid(3).value());
+
+    table.put(5, "uuid5");
+    table.flush();
+    EXPECT_EQ(3, countLines(path));
+}
+
+TEST_F(InodeTableTest, putShouldCompactTableWithTooManyOutdatedLines)
+{
+    InodeTable table{path};
+
+    for (std::size_t i = 0; i < 2 * INODE_TABLE_MIN_GARBAGE; ++i)
+        table.put(2, "uuid" + std::to_string(i));
+
+    table.flush();
+    EXPECT_LT(countLines(path), INODE_TABLE_MIN_GARBAGE + 2);
+    EXPECT_EQ("uuid" + std::to_string(2 * INODE_TABLE_MIN_GARBAGE - 1),
+        table.uuid(2).value());
+}
+
+TEST_F(InodeTableTest, putShouldForgetOldestAssociationsOverMaxSize)
+{
+    {
+        InodeTable table{path, 2};
+        table.put(2, "uuid2");
+        table.put(3, "uuid3");
+        table.put(2, "uuid4");
+        table.put(5, "uuid5");
+
+        EXPECT_FALSE(table.uuid(3));
+        EXPECT_FALSE(table.inode("uuid3"));
+        EXPECT_EQ("uuid4", table.uuid(2).value());
+        EXPECT_EQ("uuid5", table.uuid(5).value());
+    }
+
+    InodeTable table{path, 2};
+    EXPECT_EQ(2, countLines(path));
+    EXPECT_FALSE(table.uuid(3));
+    EXPECT_EQ("uuid4", table.uuid(2).value());
+    EXPECT_EQ("uuid5", table.uuid(5).value());
+}
+
+TEST_F(InodeTableTest, appendedAssociationsShouldBeFlushedPeriodically)
+{
+    InodeTable table{path};
+    table.put(2, "uuid2");
+
+    std::this_thread::sleep_for(2 * INODE_TABLE_FLUSH_INTERVAL);
+    EXPECT_EQ(1, countLines(path));
+}
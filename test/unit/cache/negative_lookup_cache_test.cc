@@ -0,0 +1,82 @@
+/**
+ * @file negative_lookup_cache_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/negativeLookupCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace one::client::cache;
+using namespace std::literals;
+
+TEST(NegativeLookupCacheTest, containsShouldReturnAddedEntries)
+{
+    NegativeLookupCache cache{10, 60s};
+
+    EXPECT_FALSE(cache.contains("parent1", "name1"));
+
+    cache.add("parent1", "name1");
+
+    EXPECT_TRUE(cache.contains("parent1", "name1"));
+    EXPECT_FALSE(cache.contains("parent1", "name2"));
+    EXPECT_FALSE(cache.contains("parent2", "name1"));
+}
+
+TEST(NegativeLookupCacheTest, containsShouldIgnoreExpiredEntries)
+{
+    NegativeLookupCache cache{10, 0ms};
+
+    cache.add("parent1", "name1");
+
+    EXPECT_FALSE(cache.contains("parent1", "name1"));
+    EXPECT_EQ(0, cache.size());
+}
+
+TEST(NegativeLookupCacheTest, addShouldEvictOldestEntries)
+{
+    NegativeLookupCache cache{2, 60s};
+
+    cache.add("parent1", "name1");
+    cache.add("parent1", "name2");
+    cache.add("parent1", "name3");
+
+    EXPECT_EQ(2, cache.size());
+    EXPECT_FALSE(cache.contains("parent1", "name1"));
+    EXPECT_TRUE(cache.contains("parent1", "name2"));
+    EXPECT_TRUE(cache.contains("parent1", "name3"));
+
+    NegativeLookupCache disabledCache{0, 60s};
+    disabledCache.add("parent1", "name1");
+    EXPECT_FALSE(disabledCache.contains("parent1", "name1"));
+}
+
+TEST(NegativeLookupCacheTest, removeShouldDropEntry)
+{
+    NegativeLookupCache cache{10, 60s};
+
+    cache.add("parent1", "name1");
+    cache.add("parent1", "name2");
+    cache.remove("parent1", "name1");
+
+    EXPECT_FALSE(cache.contains("parent1", "name1"));
+    EXPECT_TRUE(cache.contains("parent1", "name2"));
+}
+
+TEST(NegativeLookupCacheTest, invalidateShouldDropEntriesOfDirectory)
+{
+    NegativeLookupCache cache{10, 60s};
+
+    cache.add("parent1", "name1");
+    cache.add("parent1", "name2");
+    cache.add("parent2", "name1");
+    cache.invalidate("parent1");
+
+    EXPECT_EQ(1, cache.size());
+    EXPECT_FALSE(cache.contains("parent1", "name1"));
+    EXPECT_FALSE(cache.contains("parent1", "name2"));
+    EXPECT_TRUE(cache.contains("parent2", "name1"));
+}
@@ -0,0 +1,195 @@
+/**
+ * @file shared_read_cache_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/sharedReadCache.h"
+
+#include <folly/FBString.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace one;
+using namespace one::client::cache;
+
+namespace {
+folly::IOBufQueue makeData(const std::string &data)
+{
+    folly::IOBufQueue queue{folly::IOBufQueue::cacheChainLength()};
+    queue.append(data);
+    return queue;
+}
+
+std::string toString(folly::IOBufQueue &queue)
+{
+    std::string result;
+    queue.appendToString(result);
+    return result;
+}
+}
+
+TEST(SharedReadCacheTest, readShouldReturnCachedRange)
+{
+    SharedReadCache cache{100};
+
+    EXPECT_FALSE(cache.read("uuid1", 1, 0, 5));
+
+    cache.put("uuid1", 1, 10, makeData("0123456789"));
+    EXPECT_EQ(10, cache.size());
+
+    auto all = cache.read("uuid1", 1, 10, 10);
+    ASSERT_TRUE(all);
+    EXPECT_EQ("0123456789", toString(*all));
+
+    auto middle = cache.read("uuid1", 1, 13, 4);
+    ASSERT_TRUE(middle);
+    EXPECT_EQ("3456", toString(*middle));
+
+    EXPECT_FALSE(cache.read("uuid1", 1, 5, 10));
+    EXPECT_FALSE(cache.read("uuid1", 1, 15, 10));
+    EXPECT_FALSE(cache.read("uuid2", 1, 10, 10));
+}
+
+TEST(SharedReadCacheTest, readShouldDropOutdatedData)
+{
+    SharedReadCache cache{100};
+
+    cache.put("uuid1", 1, 0, makeData("0123456789"));
+    EXPECT_FALSE(cache.read("uuid1", 2, 0, 10));
+    EXPECT_EQ(0, cache.size());
+}
+
+TEST(SharedReadCacheTest, putShouldOnlyFillGapsInCachedData)
+{
+    SharedReadCache cache{100};
+
+    cache.put("uuid1", 1, 0, makeData("0123456789"));
+    cache.put("uuid1", 1, 20, makeData("0123456789"));
+    cache.put("uuid1", 1, 5, makeData("abcdefghijklmnopqrstuvwxy"));
+    EXPECT_EQ(30, cache.size());
+
+    auto all = cache.read("uuid1", 1, 0, 30);
+    ASSERT_TRUE(all);
+    EXPECT_EQ("0123456789fghijklmno0123456789", toString(*all));
+}
+
+TEST(SharedReadCacheTest, readShouldGatherAdjacentSegments)
+{
+    SharedReadCache cache{100};
+
+    cache.put("uuid1", 1, 0, makeData("01234"));
+    cache.put("uuid1", 1, 5, makeData("56789"));
+    cache.put("uuid1", 1, 15, makeData("fghij"));
+
+    auto spanning = cache.read("uuid1", 1, 3, 4);
+    ASSERT_TRUE(spanning);
+    EXPECT_EQ("3456", toString(*spanning));
+
+    EXPECT_FALSE(cache.read("uuid1", 1, 8, 10));
+}
+
+TEST(SharedReadCacheTest, writeShouldOverlayCachedData)
+{
+    SharedReadCache cache{100};
+
+    cache.write("uuid1", 0, makeData("xxx"));
+    EXPECT_EQ(0, cache.size());
+
+    cache.put("uuid1", 1, 0, makeData("0123456789"));
+    cache.write("uuid1", 3, makeData("abc"));
+    EXPECT_EQ(10, cache.size());
+
+    auto head = cache.read("uuid1", 1, 0, 3);
+    ASSERT_TRUE(head);
+    EXPECT_EQ("012", toString(*head));
+
+    auto written = cache.read("uuid1", 1, 3, 3);
+    ASSERT_TRUE(written);
+    EXPECT_EQ("abc", toString(*written));
+
+    auto tail = cache.read("uuid1", 1, 6, 4);
+    ASSERT_TRUE(tail);
+    EXPECT_EQ("6789", toString(*tail));
+
+    cache.write("uuid1", 8, makeData("defg"));
+    EXPECT_EQ(12, cache.size());
+
+    auto appended = cache.read("uuid1", 1, 8, 4);
+    ASSERT_TRUE(appended);
+    EXPECT_EQ("defg", toString(*appended));
+}
+
+TEST(SharedReadCacheTest, putShouldEvictLeastRecentlyUsedData)
+{
+    SharedReadCache cache{20};
+
+    cache.put("uuid1", 1, 0, makeData("0123456789"));
+    cache.put("uuid2", 1, 0, makeData("0123456789"));
+    EXPECT_EQ(20, cache.size());
+
+    EXPECT_TRUE(cache.read("uuid1", 1, 0, 10));
+
+    cache.put("uuid3", 1, 0, makeData("01234"));
+    EXPECT_EQ(15, cache.size());
+
+    EXPECT_TRUE(cache.read("uuid1", 1, 0, 10));
+    EXPECT_FALSE(cache.read("uuid2", 1, 0, 10));
+    EXPECT_TRUE(cache.read("uuid3", 1, 0, 5));
+}
+
+TEST(SharedReadCacheTest, invalidateShouldRemoveData)
+{
+    SharedReadCache cache{100};
+
+    cache.put("uuid1", 1, 0, makeData("0123456789"));
+    cache.put("uuid1", 1, 20, makeData("0123456789"));
+    cache.invalidate("uuid1");
+
+    EXPECT_EQ(0, cache.size());
+    EXPECT_FALSE(cache.read("uuid1", 1, 0, 10));
+    EXPECT_FALSE(cache.read("uuid1", 1, 20, 10));
+}
+
+TEST(SharedReadCacheTest, writeShouldOutdateFillsOfUncachedFile)
+{
+    SharedReadCache cache{100};
+
+    const auto generation = cache.beginFill("uuid1");
+    EXPECT_FALSE(cache.invalidatedSince("uuid1", generation));
+
+    // No data of the file is cached when it is written
+    cache.write("uuid1", 0, makeData("abcde"));
+    EXPECT_EQ(0, cache.size());
+    EXPECT_TRUE(cache.invalidatedSince("uuid1", generation));
+    cache.endFill("uuid1");
+
+    const auto nextGeneration = cache.beginFill("uuid1");
+    cache.write("uuid2", 0, makeData("abcde"));
+    EXPECT_FALSE(cache.invalidatedSince("uuid1", nextGeneration));
+
+    cache.invalidate("uuid1");
+    EXPECT_TRUE(cache.invalidatedSince("uuid1", nextGeneration));
+    cache.endFill("uuid1");
+}
+
+TEST(SharedReadCacheTest, pendingReadShouldCompleteWhenReadEnds)
+{
+    SharedReadCache cache{100};
+
+    EXPECT_FALSE(cache.pendingRead("uuid1", 0, 10));
+
+    cache.beginRead("uuid1", 10, 20);
+    EXPECT_FALSE(cache.pendingRead("uuid1", 5, 10));
+    EXPECT_FALSE(cache.pendingRead("uuid1", 20, 20));
+    EXPECT_FALSE(cache.pendingRead("uuid2", 10, 20));
+
+    auto pending = cache.pendingRead("uuid1", 15, 10);
+    ASSERT_TRUE(pending);
+    EXPECT_FALSE(pending->isReady());
+
+    cache.endRead("uuid1", 10, 20);
+    EXPECT_TRUE(pending->isReady());
+    EXPECT_FALSE(cache.pendingRead("uuid1", 15, 10));
+}
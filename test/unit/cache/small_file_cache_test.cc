@@ -0,0 +1,176 @@
+/**
+ * @file small_file_cache_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/smallFileCache.h"
+
+#include <folly/FBString.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace one;
+using namespace one::client::cache;
+using namespace std::literals;
+
+namespace {
+std::unique_ptr<folly::IOBuf> makeContent(const std::string &data)
+{
+    return folly::IOBuf::copyBuffer(data);
+}
+
+std::string toString(folly::IOBufQueue &queue)
+{
+    std::string result;
+    queue.appendToString(result);
+    return result;
+}
+}
+
+class SmallFileCacheTest : public ::testing::Test {
+public:
+    SmallFileCacheTest()
+        : mtime{std::chrono::system_clock::now()}
+    {
+    }
+
+    const std::chrono::system_clock::time_point mtime;
+};
+
+TEST_F(SmallFileCacheTest, acceptsShouldRespectLimits)
+{
+    SmallFileCache cache{100, 10};
+
+    EXPECT_FALSE(cache.accepts(0));
+    EXPECT_TRUE(cache.accepts(1));
+    EXPECT_TRUE(cache.accepts(10));
+    EXPECT_FALSE(cache.accepts(11));
+
+    SmallFileCache disabledCache{0, 10};
+    EXPECT_FALSE(disabledCache.accepts(1));
+}
+
+TEST_F(SmallFileCacheTest, readShouldReturnRequestedRange)
+{
+    SmallFileCache cache{100, 10};
+
+    EXPECT_FALSE(cache.read("uuid1", 1, mtime, 0, 10));
+
+    cache.put("uuid1", 1, mtime, makeContent("0123456789"));
+    EXPECT_EQ(10, cache.size());
+
+    auto all = cache.read("uuid1", 1, mtime, 0, 10);
+    ASSERT_TRUE(all);
+    EXPECT_EQ("0123456789", toString(*all));
+
+    auto middle = cache.read("uuid1", 1, mtime, 3, 4);
+    ASSERT_TRUE(middle);
+    EXPECT_EQ("3456", toString(*middle));
+
+    auto tail = cache.read("uuid1", 1, mtime, 8, 10);
+    ASSERT_TRUE(tail);
+    EXPECT_EQ("89", toString(*tail));
+
+    auto beyond = cache.read("uuid1", 1, mtime, 20, 10);
+    ASSERT_TRUE(beyond);
+    EXPECT_TRUE(beyond->empty());
+}
+
+TEST_F(SmallFileCacheTest, readShouldDropOutdatedContent)
+{
+    SmallFileCache cache{100, 10};
+
+    cache.put("uuid1", 1, mtime, makeContent("0123456789"));
+    EXPECT_FALSE(cache.read("uuid1", 2, mtime, 0, 10));
+    EXPECT_EQ(0, cache.size());
+
+    cache.put("uuid1", 2, mtime, makeContent("0123456789"));
+    EXPECT_FALSE(cache.read("uuid1", 2, mtime + 1s, 0, 10));
+    EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(SmallFileCacheTest, putShouldEvictLeastRecentlyUsedEntries)
+{
+    SmallFileCache cache{20, 10};
+
+    cache.put("uuid1", 1, mtime, makeContent("0123456789"));
+    cache.put("uuid2", 1, mtime, makeContent("0123456789"));
+    EXPECT_EQ(20, cache.size());
+
+    EXPECT_TRUE(cache.read("uuid1", 1, mtime, 0, 10));
+
+    cache.put("uuid3", 1, mtime, makeContent("01234"));
+    EXPECT_EQ(15, cache.size());
+
+    EXPECT_TRUE(cache.read("uuid1", 1, mtime, 0, 10));
+    EXPECT_FALSE(cache.read("uuid2", 1, mtime, 0, 10));
+    EXPECT_TRUE(cache.read("uuid3", 1, mtime, 0, 10));
+}
+
+TEST_F(SmallFileCacheTest, putShouldIgnoreTooLargeFiles)
+{
+    SmallFileCache cache{100, 5};
+
+    cache.put("uuid1", 1, mtime, makeContent("0123456789"));
+    EXPECT_EQ(0, cache.size());
+    EXPECT_FALSE(cache.read("uuid1", 1, mtime, 0, 10));
+}
+
+TEST_F(SmallFileCacheTest, invalidateShouldRemoveContent)
+{
+    SmallFileCache cache{100, 10};
+
+    cache.put("uuid1", 1, mtime, makeContent("0123456789"));
+    cache.invalidate("uuid1");
+
+    EXPECT_EQ(0, cache.size());
+    EXPECT_FALSE(cache.read("uuid1", 1, mtime, 0, 10));
+}
+
+TEST_F(SmallFileCacheTest, invalidateShouldOutdateFillsInProgress)
+{
+    SmallFileCache cache{100, 10};
+
+    const auto generation = cache.beginFill("uuid1");
+    EXPECT_FALSE(cache.invalidatedSince("uuid1", generation));
+
+    cache.invalidate("uuid2");
+    EXPECT_FALSE(cache.invalidatedSince("uuid1", generation));
+
+    cache.invalidate("uuid1");
+    EXPECT_TRUE(cache.invalidatedSince("uuid1", generation));
+    cache.endFill("uuid1");
+
+    const auto nextGeneration = cache.beginFill("uuid1");
+    EXPECT_FALSE(cache.invalidatedSince("uuid1", nextGeneration));
+
+    // Putting content of a file does not outdate other fills of the file
+    cache.put("uuid1", 1, mtime, makeContent("0123456789"));
+    EXPECT_FALSE(cache.invalidatedSince("uuid1", nextGeneration));
+    cache.endFill("uuid1");
+}
+
+TEST_F(SmallFileCacheTest, pendingFillShouldBeFulfilledWhenFillEnds)
+{
+    SmallFileCache cache{100, 10};
+
+    EXPECT_FALSE(cache.pendingFill("uuid1"));
+
+    cache.beginFill("uuid1");
+    auto pending = cache.pendingFill("uuid1");
+    ASSERT_TRUE(pending);
+    EXPECT_FALSE(cache.pendingFill("uuid2"));
+
+    cache.put("uuid1", 1, mtime, makeContent("0123456789"));
+    EXPECT_FALSE(pending->isReady());
+
+    cache.endFill("uuid1");
+    EXPECT_TRUE(pending->isReady());
+    EXPECT_FALSE(cache.pendingFill("uuid1"));
+
+    auto all = cache.read("uuid1", 1, mtime, 0, 10);
+    ASSERT_TRUE(all);
+    EXPECT_EQ("0123456789", toString(*all));
+}
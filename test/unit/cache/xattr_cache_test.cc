@@ -0,0 +1,103 @@
+/**
+ * @file xattr_cache_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/xattrCache.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace ::testing;
+using namespace one::client::cache;
+using namespace std::literals;
+
+TEST(XAttrCacheTest, cacheShouldRememberValuesAndMissingAttributes)
+{
+    XAttrCache cache{10, 10s};
+
+    cache.putValue("uuid1", "user.a", "1");
+    cache.putMissing("uuid1", "user.b");
+
+    EXPECT_EQ("1", cache.getValue("uuid1", "user.a").value());
+    EXPECT_FALSE(cache.isKnownMissing("uuid1", "user.a"));
+    EXPECT_FALSE(cache.getValue("uuid1", "user.b"));
+    EXPECT_TRUE(cache.isKnownMissing("uuid1", "user.b"));
+    EXPECT_FALSE(cache.getValue("uuid1", "user.c"));
+    EXPECT_FALSE(cache.isKnownMissing("uuid1", "user.c"));
+    EXPECT_FALSE(cache.getValue("uuid2", "user.a"));
+}
+
+TEST(XAttrCacheTest, setAndRemoveShouldUpdateCachedNames)
+{
+    XAttrCache cache{10, 10s};
+
+    cache.putNames("uuid1", {"user.a"});
+    cache.set("uuid1", "user.b", "2");
+    cache.remove("uuid1", "user.a");
+
+    EXPECT_EQ((folly::fbvector<folly::fbstring>{"user.b"}),
+        cache.getNames("uuid1").value());
+    EXPECT_EQ("2", cache.getValue("uuid1", "user.b").value());
+    EXPECT_TRUE(cache.isKnownMissing("uuid1", "user.a"));
+}
+
+TEST(XAttrCacheTest, invalidateShouldRemoveAllAttributesOfFile)
+{
+    XAttrCache cache{10, 10s};
+
+    cache.putNames("uuid1", {"user.a"});
+    cache.putValue("uuid1", "user.a", "1");
+    cache.putValue("uuid2", "user.a", "1");
+    cache.invalidate("uuid1");
+
+    EXPECT_FALSE(cache.getNames("uuid1"));
+    EXPECT_FALSE(cache.getValue("uuid1", "user.a"));
+    EXPECT_TRUE(cache.getValue("uuid2", "user.a"));
+    EXPECT_EQ(1, cache.size());
+}
+
+TEST(XAttrCacheTest, cachedAttributesShouldExpire)
+{
+    XAttrCache cache{10, 50ms};
+
+    cache.putNames("uuid1", {"user.a"});
+    cache.putValue("uuid1", "user.a", "1");
+    cache.putMissing("uuid1", "user.b");
+
+    std::this_thread::sleep_for(100ms);
+
+    EXPECT_FALSE(cache.getNames("uuid1"));
+    EXPECT_FALSE(cache.getValue("uuid1", "user.a"));
+    EXPECT_FALSE(cache.isKnownMissing("uuid1", "user.b"));
+}
+
+TEST(XAttrCacheTest, cacheShouldEvictLeastRecentlyUsedFiles)
+{
+    XAttrCache cache{2, 10s};
+
+    cache.putValue("uuid1", "user.a", "1");
+    cache.putValue("uuid2", "user.a", "2");
+    cache.getValue("uuid1", "user.a");
+    cache.putValue("uuid3", "user.a", "3");
+
+    EXPECT_EQ(2, cache.size());
+    EXPECT_TRUE(cache.getValue("uuid1", "user.a"));
+    EXPECT_FALSE(cache.getValue("uuid2", "user.a"));
+    EXPECT_TRUE(cache.getValue("uuid3", "user.a"));
+}
+
+TEST(XAttrCacheTest, disabledCacheShouldNotStoreAttributes)
+{
+    XAttrCache cache{0, 10s};
+
+    cache.putValue("uuid1", "user.a", "1");
+    cache.putMissing("uuid1", "user.b");
+    cache.set("uuid1", "user.c", "3");
+
+    EXPECT_EQ(0, cache.size());
+    EXPECT_FALSE(cache.getValue("uuid1", "user.a"));
+}
@@ -0,0 +1,75 @@
+/**
+ * @file file_location_changed_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "utils.h"
+
+using namespace one::client::events;
+
+namespace {
+one::clproto::FileLocationChangedEvent rangeChangedEvent(
+    std::string fileUuid, const off_t offset, const std::size_t size,
+    const off_t changeBegOffset, const off_t changeEndOffset)
+{
+    auto event = fileLocationChangedEvent(std::move(fileUuid));
+
+    auto block = event.mutable_file_location()->add_blocks();
+    block->set_offset(offset);
+    block->set_size(size);
+
+    event.set_change_beg_offset(changeBegOffset);
+    event.set_change_end_offset(changeEndOffset);
+
+    return event;
+}
+} // namespace
+
+TEST(FileLocationChangedTest, eventWithoutOffsetsShouldChangeEntireLocation)
+{
+    FileLocationChanged event{fileLocationChangedEvent("fileUuid")};
+
+    EXPECT_TRUE(event.changesEntireLocation());
+    EXPECT_TRUE(event.changeRanges().empty());
+}
+
+TEST(FileLocationChangedTest, eventWithEqualOffsetsShouldBeEmptyDelta)
+{
+    FileLocationChanged event{rangeChangedEvent("fileUuid", 0, 10, 5, 5)};
+
+    EXPECT_FALSE(event.changesEntireLocation());
+    EXPECT_TRUE(event.changeRanges().empty());
+    EXPECT_FALSE(event.changeStartOffset());
+}
+
+TEST(FileLocationChangedTest, aggregateShouldIgnoreEmptyDelta)
+{
+    FileLocationChanged event{rangeChangedEvent("fileUuid", 0, 10, 0, 10)};
+
+    event.aggregate(std::make_unique<FileLocationChanged>(
+        rangeChangedEvent("fileUuid", 20, 10, 5, 5)));
+
+    EXPECT_FALSE(event.changesEntireLocation());
+    ASSERT_EQ(1, event.changeRanges().iterative_size());
+    EXPECT_EQ(0, event.changeStartOffset().value());
+    EXPECT_EQ(10, event.changeEndOffset().value());
+    EXPECT_EQ(10, event.fileLocation().blocksLengthInRange(0, 100));
+}
+
+TEST(FileLocationChangedTest, aggregateShouldReplaceLocationOnEntireChange)
+{
+    FileLocationChanged event{rangeChangedEvent("fileUuid", 0, 10, 0, 10)};
+
+    auto entireChange = fileLocationChangedEvent("fileUuid");
+    auto block = entireChange.mutable_file_location()->add_blocks();
+    block->set_offset(20);
+    block->set_size(10);
+    event.aggregate(std::make_unique<FileLocationChanged>(entireChange));
+
+    EXPECT_TRUE(event.changesEntireLocation());
+    EXPECT_TRUE(event.changeRanges().empty());
+    EXPECT_EQ(0, event.fileLocation().blocksLengthInRange(0, 10));
+    EXPECT_EQ(10, event.fileLocation().blocksLengthInRange(20, 30));
+}
@@ -0,0 +1,157 @@
+/**
+ * @file fuse_file_handle_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "cache/forceProxyIOCache.h"
+#include "cache/helpersCache.h"
+#include "communication/communicator.h"
+#include "fslogic/fuseFileHandle.h"
+#include "helpers/storageHelper.h"
+#include "options/options.h"
+#include "scheduler.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace ::testing;
+using namespace one;
+using namespace one::client;
+using namespace std::literals;
+
+namespace {
+class TestHelperHandle : public helpers::FileHandle {
+public:
+    TestHelperHandle()
+        : helpers::FileHandle{{}}
+    {
+        ON_CALL(*this, flush()).WillByDefault(Invoke([] {
+            return folly::makeFuture();
+        }));
+        ON_CALL(*this, release()).WillByDefault(Invoke([] {
+            return folly::makeFuture();
+        }));
+    }
+
+    folly::Future<folly::IOBufQueue> read(
+        const off_t, const std::size_t) override
+    {
+        return folly::IOBufQueue{folly::IOBufQueue::cacheChainLength()};
+    }
+
+    folly::Future<std::size_t> write(
+        const off_t, folly::IOBufQueue buf) override
+    {
+        return buf.chainLength();
+    }
+
+    const helpers::Timeout &timeout() override { return m_timeout; }
+
+    MOCK_METHOD0(flush, folly::Future<folly::Unit>());
+    MOCK_METHOD0(release, folly::Future<folly::Unit>());
+
+    helpers::Timeout m_timeout{60};
+};
+
+class TestHelper : public helpers::StorageHelper {
+public:
+    folly::Future<helpers::FileHandlePtr> open(const folly::fbstring &,
+        const int, const helpers::Params &) override
+    {
+        auto handle = std::make_shared<NiceMock<TestHelperHandle>>();
+        m_handles.emplace_back(handle);
+        return folly::makeFuture<helpers::FileHandlePtr>(std::move(handle));
+    }
+
+    const helpers::Timeout &timeout() override { return m_timeout; }
+
+    helpers::Timeout m_timeout{60};
+    std::vector<std::weak_ptr<NiceMock<TestHelperHandle>>> m_handles;
+};
+
+class TestHelpersCache : public cache::HelpersCache {
+public:
+    using HelpersCache::HelpersCache;
+
+    folly::Future<HelperPtr> get(const folly::fbstring &,
+        const folly::fbstring &, const folly::fbstring &, const bool) override
+    {
+        return folly::makeFuture<HelperPtr>(m_helper);
+    }
+
+    std::size_t accessGeneration() const override { return m_generation; }
+
+    std::shared_ptr<TestHelper> m_helper = std::make_shared<TestHelper>();
+    std::size_t m_generation = 0;
+};
+} // namespace
+
+struct FuseFileHandleTest : public ::testing::Test {
+    helpers::FileHandlePtr getHelperHandle()
+    {
+        return fuseFileHandle.getHelperHandle(
+            "uuid", "spaceId", "storageId", "fileId");
+    }
+
+    Scheduler scheduler{0};
+    communication::Communicator communicator{1, 1, "127.0.0.1", 80, false};
+    options::Options options;
+    TestHelpersCache helpersCache{communicator, scheduler, options};
+    cache::ForceProxyIOCache forceProxyIOCache;
+    fslogic::FuseFileHandle fuseFileHandle{
+        O_RDWR, "handleId", nullptr, helpersCache, forceProxyIOCache, 10s};
+};
+
+TEST_F(FuseFileHandleTest, helperHandleShouldBeReusedWithinAccessGeneration)
+{
+    auto handle = getHelperHandle();
+    helpersCache.m_helper = std::make_shared<TestHelper>();
+
+    EXPECT_EQ(handle, getHelperHandle());
+}
+
+TEST_F(FuseFileHandleTest, replacedHelperHandleShouldBeFlushedAndReleased)
+{
+    auto oldHelper = helpersCache.m_helper;
+    auto handle = getHelperHandle();
+    auto &oldHandle = static_cast<NiceMock<TestHelperHandle> &>(*handle);
+
+    // A write in progress keeps using the old handle for a while
+    std::atomic<bool> writeCompleted{false};
+    EXPECT_CALL(oldHandle, flush()).WillOnce(Invoke([&] {
+        EXPECT_TRUE(writeCompleted);
+        return folly::makeFuture();
+    }));
+    EXPECT_CALL(oldHandle, release()).Times(1);
+
+    fuseFileHandle.beginWrite();
+    std::thread write{[&] {
+        std::this_thread::sleep_for(100ms);
+        writeCompleted = true;
+        fuseFileHandle.endWrite();
+    }};
+
+    helpersCache.m_helper = std::make_shared<TestHelper>();
+    ++helpersCache.m_generation;
+
+    auto newHandle = getHelperHandle();
+    write.join();
+
+    EXPECT_EQ(helpersCache.m_helper->m_handles.front().lock(), newHandle);
+
+    // A read in progress does not delay the replacement, the old handle is
+    // released once the read completes
+    EXPECT_FALSE(oldHelper->m_handles.front().expired());
+    EXPECT_EQ(2u, fuseFileHandle.helperHandles().size());
+
+    handle.reset();
+    EXPECT_EQ(newHandle, getHelperHandle());
+
+    EXPECT_TRUE(oldHelper->m_handles.front().expired());
+    EXPECT_EQ(1u, fuseFileHandle.helperHandles().size());
+}
@@ -0,0 +1,169 @@
+/**
+ * @file hedged_read_policy_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "fslogic/hedgedReadPolicy.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+using namespace ::testing;
+using namespace one::client;
+using namespace std::literals;
+
+namespace {
+/**
+ * Returns a read function which, similarly to a null device helper with
+ * injected latency, returns the given content after a delay or fails.
+ */
+fslogic::HedgedReadPolicy::ReadFunction delayedRead(
+    std::chrono::milliseconds latency, std::string content,
+    std::atomic<int> &calls, bool fail = false)
+{
+    return [latency, content, &calls, fail] {
+        ++calls;
+        return folly::futures::sleep(latency).then([content, fail] {
+            if (fail)
+                throw std::system_error{
+                    std::make_error_code(std::errc::io_error)};
+
+            folly::IOBufQueue buf{folly::IOBufQueue::cacheChainLength()};
+            buf.append(content);
+            return buf;
+        });
+    };
+}
+
+std::string readString(folly::Future<folly::IOBufQueue> future)
+{
+    auto buf = std::move(future).get(5s);
+    std::string result;
+    buf.appendToString(result);
+    return result;
+}
+} // namespace
+
+class HedgedReadPolicyTest : public ::testing::Test {
+protected:
+    void warmUp(fslogic::HedgedReadPolicy &policy, std::size_t reads,
+        std::chrono::milliseconds latency)
+    {
+        for (std::size_t i = 0; i < reads; ++i)
+            policy.recordLatency(latency);
+    }
+
+    std::atomic<int> primaryCalls{0};
+    std::atomic<int> alternateCalls{0};
+};
+
+TEST_F(HedgedReadPolicyTest, disabledPolicyShouldUseOnlyPrimaryRead)
+{
+    auto policy = std::make_shared<fslogic::HedgedReadPolicy>(false, 50, 100);
+    warmUp(*policy, fslogic::HEDGED_READ_MIN_LATENCY_SAMPLES, 1ms);
+
+    EXPECT_EQ("direct",
+        readString(policy->read(delayedRead(200ms, "direct", primaryCalls),
+            delayedRead(0ms, "proxy", alternateCalls))));
+
+    EXPECT_EQ(1, primaryCalls);
+    EXPECT_EQ(0, alternateCalls);
+}
+
+TEST_F(HedgedReadPolicyTest, policyShouldNotHedgeBeforeLatenciesAreKnown)
+{
+    auto policy = std::make_shared<fslogic::HedgedReadPolicy>(true, 50, 100);
+    warmUp(*policy, fslogic::HEDGED_READ_MIN_LATENCY_SAMPLES - 1, 1ms);
+
+    EXPECT_EQ(std::chrono::microseconds::max(), policy->delay());
+    EXPECT_EQ("direct",
+        readString(policy->read(delayedRead(100ms, "direct", primaryCalls),
+            delayedRead(0ms, "proxy", alternateCalls))));
+
+    EXPECT_EQ(0, alternateCalls);
+}
+
+TEST_F(HedgedReadPolicyTest, delayShouldBeThePercentileOfLatencies)
+{
+    auto policy = std::make_shared<fslogic::HedgedReadPolicy>(true, 90, 100);
+
+    const auto samples = fslogic::HEDGED_READ_MIN_LATENCY_SAMPLES;
+    for (std::size_t i = 1; i <= samples; ++i)
+        policy->recordLatency(std::chrono::microseconds{i});
+
+    EXPECT_EQ(std::chrono::microseconds{samples * 90 / 100 + 1},
+        policy->delay());
+}
+
+TEST_F(HedgedReadPolicyTest, slowPrimaryReadShouldBeHedged)
+{
+    auto policy = std::make_shared<fslogic::HedgedReadPolicy>(true, 50, 100);
+    warmUp(*policy, fslogic::HEDGED_READ_MIN_LATENCY_SAMPLES, 10ms);
+
+    EXPECT_EQ("proxy",
+        readString(policy->read(delayedRead(2s, "direct", primaryCalls),
+            delayedRead(10ms, "proxy", alternateCalls))));
+
+    EXPECT_EQ(1, primaryCalls);
+    EXPECT_EQ(1, alternateCalls);
+}
+
+TEST_F(HedgedReadPolicyTest, fastPrimaryReadShouldNotBeHedged)
+{
+    auto policy = std::make_shared<fslogic::HedgedReadPolicy>(true, 50, 100);
+    warmUp(*policy, fslogic::HEDGED_READ_MIN_LATENCY_SAMPLES, 500ms);
+
+    EXPECT_EQ("direct",
+        readString(policy->read(delayedRead(10ms, "direct", primaryCalls),
+            delayedRead(0ms, "proxy", alternateCalls))));
+
+    std::this_thread::sleep_for(600ms);
+    EXPECT_EQ(0, alternateCalls);
+}
+
+TEST_F(HedgedReadPolicyTest, failedHedgedReadShouldNotFailTheRead)
+{
+    auto policy = std::make_shared<fslogic::HedgedReadPolicy>(true, 50, 100);
+    warmUp(*policy, fslogic::HEDGED_READ_MIN_LATENCY_SAMPLES, 10ms);
+
+    EXPECT_EQ("direct",
+        readString(policy->read(delayedRead(200ms, "direct", primaryCalls),
+            delayedRead(0ms, "proxy", alternateCalls, true))));
+
+    EXPECT_EQ(1, alternateCalls);
+}
+
+TEST_F(HedgedReadPolicyTest, readShouldFailWithPrimaryErrorIfBothReadsFail)
+{
+    auto policy = std::make_shared<fslogic::HedgedReadPolicy>(true, 50, 100);
+    warmUp(*policy, fslogic::HEDGED_READ_MIN_LATENCY_SAMPLES, 10ms);
+
+    auto future =
+        policy->read(delayedRead(200ms, "direct", primaryCalls, true),
+            delayedRead(0ms, "proxy", alternateCalls, true));
+
+    EXPECT_THROW(std::move(future).get(5s), std::system_error);
+    EXPECT_EQ(1, alternateCalls);
+}
+
+TEST_F(HedgedReadPolicyTest, hedgedReadsShouldBeLimitedByBudget)
+{
+    auto policy = std::make_shared<fslogic::HedgedReadPolicy>(true, 50, 10);
+    warmUp(*policy, fslogic::HEDGED_READ_MIN_LATENCY_SAMPLES, 50ms);
+
+    folly::fbvector<folly::Future<folly::IOBufQueue>> reads;
+    for (auto i = 0; i < 20; ++i) {
+        reads.emplace_back(
+            policy->read(delayedRead(200ms, "direct", primaryCalls),
+                delayedRead(0ms, "proxy", alternateCalls)));
+    }
+
+    for (auto &read : reads)
+        std::move(read).get(5s);
+
+    EXPECT_EQ(20, primaryCalls);
+    EXPECT_EQ(2, alternateCalls);
+}
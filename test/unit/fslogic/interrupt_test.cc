@@ -0,0 +1,87 @@
+/**
+ * @file interrupt_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "fslogic/interrupt.h"
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using namespace one::client;
+
+namespace {
+bool failedWithEintr(folly::Future<int> &future)
+{
+    try {
+        future.get();
+    }
+    catch (const std::system_error &e) {
+        return e.code().value() == EINTR;
+    }
+    return false;
+}
+} // namespace
+
+TEST(InterruptTest, interruptibleFutureShouldReturnResult)
+{
+    fslogic::Interrupt interrupt;
+    folly::Promise<int> promise;
+
+    auto future = interrupt.interruptible(promise.getFuture());
+    promise.setValue(42);
+
+    EXPECT_EQ(42, future.get());
+}
+
+TEST(InterruptTest, interruptShouldFailPendingFuturesWithEintr)
+{
+    fslogic::Interrupt interrupt;
+    folly::Promise<int> promise;
+
+    auto future = interrupt.interruptible(promise.getFuture());
+    EXPECT_FALSE(future.isReady());
+
+    interrupt.interrupt();
+
+    EXPECT_TRUE(interrupt.interrupted());
+    EXPECT_TRUE(failedWithEintr(future));
+
+    // Late result of the abandoned operation is ignored
+    promise.setValue(42);
+}
+
+TEST(InterruptTest, futuresShouldFailImmediatelyAfterInterrupt)
+{
+    fslogic::Interrupt interrupt;
+    interrupt.interrupt();
+
+    folly::Promise<int> promise;
+    auto future = interrupt.interruptible(promise.getFuture());
+
+    EXPECT_TRUE(future.isReady());
+    EXPECT_TRUE(failedWithEintr(future));
+}
+
+TEST(InterruptTest, checkShouldThrowOnlyWhenInterrupted)
+{
+    fslogic::Interrupt interrupt;
+    EXPECT_NO_THROW(interrupt.check());
+
+    interrupt.interrupt();
+    interrupt.interrupt();
+
+    EXPECT_THROW(interrupt.check(), std::system_error);
+}
+
+TEST(InterruptTest, futureWithoutInterruptShouldBeReturnedAsIs)
+{
+    folly::Promise<int> promise;
+    auto future = fslogic::interruptible(
+        promise.getFuture(), std::shared_ptr<fslogic::Interrupt>{});
+
+    promise.setValue(7);
+    EXPECT_EQ(7, future.get());
+}
@@ -0,0 +1,135 @@
+/**
+ * @file file_blocks_map_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "messages/fuse/fileBlock.h"
+#include "messages/fuse/fileBlocksMap.h"
+
+#include <gtest/gtest.h>
+
+using namespace one::messages::fuse;
+
+TEST(FileBlocksMapTest, addShouldJoinTouchingRangesWithEqualBlocks)
+{
+    FileBlocksMap map;
+    map.add(0, 10, FileBlock{"s1", "f1"});
+    map.add(20, 30, FileBlock{"s1", "f1"});
+    map.add(10, 20, FileBlock{"s1", "f1"});
+    map.add(30, 40, FileBlock{"s2", "f2"});
+
+    ASSERT_EQ(2, map.size());
+    EXPECT_EQ(40, map.length());
+
+    auto it = map.begin();
+    EXPECT_EQ(FileBlocksMap::Interval::right_open(0, 30), it->first);
+    EXPECT_EQ("s1", it->second.storageId());
+    ++it;
+    EXPECT_EQ(FileBlocksMap::Interval::right_open(30, 40), it->first);
+    EXPECT_EQ("f2", it->second.fileId());
+}
+
+TEST(FileBlocksMapTest, addShouldKeepIdentityOfExistingBlocks)
+{
+    FileBlocksMap map;
+    map.add(0, 10, FileBlock{"s1", "f1"});
+    map.add(20, 30, FileBlock{"", ""});
+    map.add(5, 25, FileBlock{"s2", "f2"});
+
+    // The new block fills the gap and replaces the default-constructed block
+    // only where the ranges overlap
+    ASSERT_EQ(3, map.size());
+    EXPECT_EQ(30, map.length());
+    EXPECT_EQ("s1", map.find(9)->second.storageId());
+    EXPECT_EQ("s2", map.find(10)->second.storageId());
+    EXPECT_EQ(FileBlocksMap::Interval::right_open(10, 25), map.find(24)->first);
+    EXPECT_EQ("", map.find(29)->second.storageId());
+}
+
+TEST(FileBlocksMapTest, findShouldReturnRangeContainingOffset)
+{
+    FileBlocksMap map;
+    map.add(10, 20, FileBlock{"s1", "f1"});
+    map.add(30, 40, FileBlock{"s2", "f2"});
+
+    EXPECT_TRUE(map.find(9) == map.end());
+    EXPECT_EQ("s1", map.find(10)->second.storageId());
+    EXPECT_TRUE(map.find(20) == map.end());
+    EXPECT_EQ("s2", map.find(39)->second.storageId());
+    EXPECT_TRUE(map.find(40) == map.end());
+}
+
+TEST(FileBlocksMapTest, rangeQueriesShouldClipRangesAtBoundaries)
+{
+    FileBlocksMap map;
+    for (off_t i = 0; i < 100; ++i)
+        map.add(i * 100, i * 100 + 50, FileBlock{"s1", "f1"});
+
+    EXPECT_EQ(100, map.countInRange(0, 10000));
+    EXPECT_EQ(5000, map.lengthInRange(0, 10000));
+    EXPECT_EQ(2, map.countInRange(125, 225));
+    EXPECT_EQ(25 + 25, map.lengthInRange(125, 225));
+    EXPECT_EQ(0, map.countInRange(50, 100));
+    EXPECT_EQ(0, map.lengthInRange(50, 100));
+
+    map.erase(0, 5000);
+    EXPECT_EQ(50, map.countInRange(0, 10000));
+    EXPECT_EQ(10 + 50, map.lengthInRange(5040, 5150));
+}
+
+TEST(FileBlocksMapTest, eraseAndIntersectShouldSplitRanges)
+{
+    FileBlocksMap map;
+    map.add(0, 100, FileBlock{"s1", "f1"});
+
+    map.erase(40, 60);
+    EXPECT_EQ(2, map.size());
+    EXPECT_EQ(80, map.length());
+
+    map.intersect(20, 80);
+    EXPECT_EQ(2, map.size());
+    EXPECT_EQ(40, map.length());
+    EXPECT_EQ(FileBlocksMap::Interval::right_open(20, 40), map.begin()->first);
+
+    map.intersect(50, 50);
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(0, map.length());
+}
+
+TEST(FileBlocksMapTest, intersectionShouldCopyPartOfMap)
+{
+    FileBlocksMap map;
+    map.add(0, 100, FileBlock{"s1", "f1"});
+    map.add(100, 200, FileBlock{"s2", "f2"});
+
+    FileBlocksMap expected;
+    expected.add(50, 100, FileBlock{"s1", "f1"});
+    expected.add(100, 150, FileBlock{"s2", "f2"});
+
+    EXPECT_TRUE(map.intersection(50, 150) == expected);
+    EXPECT_TRUE(map.intersection(50, 151) != expected);
+}
+
+TEST(FileBlocksMapTest, updateShouldReplaceRangeInPlace)
+{
+    FileBlocksMap map;
+    map.add(0, 100, FileBlock{"s1", "f1"});
+    map.add(200, 300, FileBlock{"s1", "f1"});
+
+    FileBlocksMap delta;
+    delta.add(50, 120, FileBlock{"s1", "f1"});
+    delta.add(150, 250, FileBlock{"s2", "f2"});
+
+    map.update(60, 220, delta);
+
+    FileBlocksMap expected;
+    expected.add(0, 120, FileBlock{"s1", "f1"});
+    expected.add(150, 220, FileBlock{"s2", "f2"});
+    expected.add(220, 300, FileBlock{"s1", "f1"});
+
+    EXPECT_TRUE(map == expected);
+    EXPECT_EQ(120 + 70 + 80, map.length());
+    EXPECT_EQ(2, map.countInRange(100, 200));
+}
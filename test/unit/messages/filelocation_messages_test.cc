@@ -342,3 +342,111 @@ TEST_F(FuseFileLocationMessagesTest, isReplicationCompletedReportProperValues)
     fileLocation.putBlock(0, 100, FileBlock{"", ""});
     EXPECT_EQ(fileLocation.isReplicationComplete(50), true);
 }
+
+TEST_F(FuseFileLocationMessagesTest, retainRangesShouldMakeLocationWindowed)
+{
+    auto fileLocation = FileLocation{};
+    fileLocation.putBlock(0, 10, FileBlock{"", ""});
+    fileLocation.putBlock(100, 10, FileBlock{"", ""});
+    fileLocation.putBlock(200, 10, FileBlock{"", ""});
+    EXPECT_FALSE(fileLocation.isWindowed());
+    EXPECT_TRUE(fileLocation.isKnown(150));
+
+    boost::icl::interval_set<off_t> ranges;
+    ranges += boost::icl::discrete_interval<off_t>::right_open(50, 150);
+    fileLocation.retainRanges(ranges);
+
+    EXPECT_TRUE(fileLocation.isWindowed());
+    EXPECT_EQ(fileLocation.blocksCount(), 1);
+    EXPECT_FALSE(fileLocation.isKnown(0));
+    EXPECT_TRUE(fileLocation.isKnown(50));
+    EXPECT_FALSE(fileLocation.isKnown(205));
+
+    // Ranges updated after windowing become known
+    auto fileLocationChange = FileLocation{};
+    fileLocationChange.putBlock(200, 20, FileBlock{"", ""});
+    fileLocation.updateInRange(200, 250, fileLocationChange);
+    EXPECT_TRUE(fileLocation.isKnown(205));
+    EXPECT_EQ(fileLocation.blocksLengthInRange(0, 1000), 30);
+
+    // Full update makes the location complete again
+    fileLocation.update(fileLocationChange.blocks());
+    EXPECT_FALSE(fileLocation.isWindowed());
+    EXPECT_TRUE(fileLocation.isKnown(0));
+}
+
+TEST_F(FuseFileLocationMessagesTest,
+    windowedLocationShouldReportReplicationOfFullLocation)
+{
+    auto fileLocation = FileLocation{};
+    fileLocation.putBlock(0, 100, FileBlock{"", ""});
+
+    boost::icl::interval_set<off_t> ranges;
+    ranges += boost::icl::discrete_interval<off_t>::right_open(0, 50);
+    fileLocation.retainRanges(ranges);
+
+    EXPECT_EQ(fileLocation.blocksLengthInRange(0, 1000), 50);
+    EXPECT_TRUE(fileLocation.isReplicationComplete(100));
+    EXPECT_EQ(fileLocation.replicationProgress(200), 0.5);
+
+    fileLocation = FileLocation{};
+    fileLocation.putBlock(0, 10, FileBlock{"", ""});
+    fileLocation.putBlock(100, 10, FileBlock{"", ""});
+    fileLocation.putBlock(200, 10, FileBlock{"", ""});
+
+    ranges.clear();
+    ranges += boost::icl::discrete_interval<off_t>::right_open(50, 150);
+    fileLocation.retainRanges(ranges);
+
+    EXPECT_FALSE(fileLocation.isReplicationComplete(300));
+    EXPECT_EQ(fileLocation.replicationProgress(300), 0.1);
+
+    // Changes within the known ranges are applied to the full location
+    fileLocation.putBlock(50, 100, FileBlock{"", ""});
+    EXPECT_EQ(fileLocation.replicationProgress(300), 0.4);
+}
+
+TEST_F(FuseFileLocationMessagesTest,
+    windowedLocationShouldNotCountChangesOutsideKnownRanges)
+{
+    auto fileLocation = FileLocation{};
+    fileLocation.putBlock(0, 100, FileBlock{"", ""});
+
+    boost::icl::interval_set<off_t> ranges;
+    ranges += boost::icl::discrete_interval<off_t>::right_open(0, 50);
+    fileLocation.retainRanges(ranges);
+    EXPECT_EQ(fileLocation.replicationProgress(200), 0.5);
+
+    // The written range was already replicated, but it's not known to the
+    // windowed location, so only held blocks are reported
+    fileLocation.putBlock(60, 20, FileBlock{"", ""});
+    EXPECT_LE(fileLocation.replicationProgress(200), 0.5);
+    EXPECT_FALSE(fileLocation.isReplicationComplete(100));
+
+    // Full update makes the location complete again
+    auto fullLocation = FileLocation{};
+    fullLocation.putBlock(0, 100, FileBlock{"", ""});
+    fileLocation.update(fullLocation.blocks());
+    EXPECT_EQ(fileLocation.replicationProgress(200), 0.5);
+    EXPECT_TRUE(fileLocation.isReplicationComplete(100));
+}
+
+TEST_F(FuseFileLocationMessagesTest,
+    truncateWithinKnownRangesShouldMakeLocationComplete)
+{
+    auto fileLocation = FileLocation{};
+    fileLocation.putBlock(0, 100, FileBlock{"", ""});
+    fileLocation.putBlock(200, 100, FileBlock{"", ""});
+
+    boost::icl::interval_set<off_t> ranges;
+    ranges += boost::icl::discrete_interval<off_t>::right_open(0, 50);
+    fileLocation.retainRanges(ranges);
+    EXPECT_FALSE(fileLocation.isReplicationComplete(300));
+
+    fileLocation.truncate(
+        boost::icl::discrete_interval<off_t>::right_open(0, 30));
+
+    EXPECT_FALSE(fileLocation.isWindowed());
+    EXPECT_TRUE(fileLocation.isReplicationComplete(30));
+    EXPECT_EQ(fileLocation.replicationProgress(60), 0.5);
+}
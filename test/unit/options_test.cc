@@ -109,6 +109,7 @@ TEST_F(OptionsTest, getOptionShouldReturnDefaultValue)
         options.getSchedulerThreadCount());
     EXPECT_EQ(options::DEFAULT_STORAGE_HELPER_THREAD_COUNT,
         options.getStorageHelperThreadCount());
+    EXPECT_FALSE(options.getStorageHelperThreadCounts());
     EXPECT_EQ(true, options.isIOBuffered());
     EXPECT_EQ(options::DEFAULT_PROVIDER_TIMEOUT,
         options.getProviderTimeout().count());
@@ -132,6 +133,42 @@ TEST_F(OptionsTest, getOptionShouldReturnDefaultValue)
         options::DEFAULT_METADATA_CACHE_SIZE, options.getMetadataCacheSize());
     EXPECT_EQ(options::DEFAULT_READDIR_PREFETCH_SIZE,
         options.getReaddirPrefetchSize());
+    EXPECT_EQ(options::DEFAULT_SMALL_FILE_CACHE_SIZE,
+        options.getSmallFileCacheSize());
+    EXPECT_EQ(options::DEFAULT_SMALL_FILE_CACHE_THRESHOLD,
+        options.getSmallFileCacheThreshold());
+    EXPECT_FALSE(options.getDiskCacheDirPath());
+    EXPECT_EQ(options::DEFAULT_DISK_CACHE_SIZE, options.getDiskCacheSize());
+    EXPECT_EQ(options::DEFAULT_SHARED_READ_CACHE_SIZE,
+        options.getSharedReadCacheSize());
+    EXPECT_EQ(options::DEFAULT_NEGATIVE_LOOKUP_CACHE_SIZE,
+        options.getNegativeLookupCacheSize());
+    EXPECT_EQ(options::DEFAULT_NEGATIVE_LOOKUP_CACHE_TTL,
+        options.getNegativeLookupCacheTTL().count());
+    EXPECT_EQ(options::DEFAULT_METADATA_CACHE_EVICTION_POLICY,
+        options.getMetadataCacheEvictionPolicy());
+    EXPECT_EQ(options::DEFAULT_METADATA_CACHE_MEMORY_LIMIT,
+        options.getMetadataCacheMemoryLimit());
+    EXPECT_FALSE(options.areStableInodesEnabled());
+    EXPECT_FALSE(options.getInodeTablePath());
+    EXPECT_FALSE(options.getCacheSnapshotPath());
+    EXPECT_EQ(options::DEFAULT_CACHE_SNAPSHOT_INTERVAL,
+        options.getCacheSnapshotInterval().count());
+    EXPECT_FALSE(options.getStorageAccessCachePath());
+    EXPECT_EQ(options::DEFAULT_PATH_WALK_PREFETCH_SIZE,
+        options.getPathWalkPrefetchSize());
+    EXPECT_EQ(
+        options::DEFAULT_XATTR_CACHE_SIZE, options.getXAttrCacheSize());
+    EXPECT_EQ(options::DEFAULT_XATTR_CACHE_TTL,
+        options.getXAttrCacheTTL().count());
+    EXPECT_FALSE(options.isReaddirTreeWalkPrefetchEnabled());
+    EXPECT_EQ(options::DEFAULT_FILE_LOCATION_MEMORY_LIMIT,
+        options.getFileLocationMemoryLimit());
+    EXPECT_FALSE(options.areHedgedReadsEnabled());
+    EXPECT_EQ(options::DEFAULT_HEDGED_READ_PERCENTILE,
+        options.getHedgedReadPercentile());
+    EXPECT_EQ(options::DEFAULT_HEDGED_READ_BUDGET,
+        options.getHedgedReadBudget());
     EXPECT_EQ(1.0, options.getLinearReadPrefetchThreshold());
     EXPECT_EQ(1.0, options.getRandomReadPrefetchThreshold());
     EXPECT_EQ(0, options.getRandomReadPrefetchClusterWindow());
@@ -289,6 +326,14 @@ TEST_F(OptionsTest, parseCommandLineShouldSetStorageHelperThreadCount)
     EXPECT_EQ(8, options.getStorageHelperThreadCount());
 }
 
+TEST_F(OptionsTest, parseCommandLineShouldSetStorageHelperThreadCounts)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--storage-helper-thread-counts", "posix=32,s3=16", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ("posix=32,s3=16", options.getStorageHelperThreadCounts().get());
+}
+
 TEST_F(OptionsTest, parseCommandLineShouldSetNoBuffer)
 {
     cmdArgs.insert(cmdArgs.end(), {"--no-buffer", "mountpoint"});
@@ -397,6 +442,179 @@ TEST_F(OptionsTest, parseCommandLineShouldSetReaddirPrefetchSize)
     EXPECT_EQ(10000, options.getReaddirPrefetchSize());
 }
 
+TEST_F(OptionsTest, parseCommandLineShouldSetSmallFileCacheSize)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--small-file-cache-size", "1048576", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(1048576, options.getSmallFileCacheSize());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetSmallFileCacheThreshold)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--small-file-cache-threshold", "65536", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(65536, options.getSmallFileCacheThreshold());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetDiskCacheDir)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--disk-cache-dir", "/tmp/cache", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ("/tmp/cache", options.getDiskCacheDirPath().get());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetDiskCacheSize)
+{
+    cmdArgs.insert(cmdArgs.end(), {"--disk-cache-size", "512", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(512, options.getDiskCacheSize());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetSharedReadCacheSize)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--shared-read-cache-size", "104857600", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(104857600, options.getSharedReadCacheSize());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetNegativeLookupCacheSize)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--negative-lookup-cache-size", "1000", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(1000, options.getNegativeLookupCacheSize());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetNegativeLookupCacheTTL)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--negative-lookup-cache-ttl", "60", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(60, options.getNegativeLookupCacheTTL().count());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetMetadataCacheEvictionPolicy)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--metadata-cache-eviction-policy", "2q", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ("2q", options.getMetadataCacheEvictionPolicy());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetMetadataCacheMemoryLimit)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--metadata-cache-memory-limit", "4096", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(4096, options.getMetadataCacheMemoryLimit());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldEnableStableInodes)
+{
+    cmdArgs.insert(cmdArgs.end(), {"--stable-inodes", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_TRUE(options.areStableInodesEnabled());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetInodeTable)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--inode-table", "/var/lib/oneclient/inodes", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ("/var/lib/oneclient/inodes", options.getInodeTablePath().get());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetCacheSnapshot)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--cache-snapshot", "/var/lib/oneclient/snapshot", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(
+        "/var/lib/oneclient/snapshot", options.getCacheSnapshotPath().get());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetCacheSnapshotInterval)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--cache-snapshot-interval", "60", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(60, options.getCacheSnapshotInterval().count());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetStorageAccessCache)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--storage-access-cache", "/var/lib/oneclient/storages",
+            "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ("/var/lib/oneclient/storages",
+        options.getStorageAccessCachePath().get());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetPathWalkPrefetchSize)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--path-walk-prefetch-size", "64", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(64, options.getPathWalkPrefetchSize());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetXAttrCacheSize)
+{
+    cmdArgs.insert(cmdArgs.end(), {"--xattr-cache-size", "100", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(100, options.getXAttrCacheSize());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetXAttrCacheTTL)
+{
+    cmdArgs.insert(cmdArgs.end(), {"--xattr-cache-ttl", "60", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(60, options.getXAttrCacheTTL().count());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldEnableReaddirTreeWalkPrefetch)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--readdir-tree-walk-prefetch", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_TRUE(options.isReaddirTreeWalkPrefetchEnabled());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetFileLocationMemoryLimit)
+{
+    cmdArgs.insert(cmdArgs.end(),
+        {"--file-location-memory-limit", "64", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(64, options.getFileLocationMemoryLimit());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldEnableHedgedReads)
+{
+    cmdArgs.insert(cmdArgs.end(), {"--hedged-reads", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_TRUE(options.areHedgedReadsEnabled());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetHedgedReadPercentile)
+{
+    cmdArgs.insert(
+        cmdArgs.end(), {"--hedged-read-percentile", "99", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(99, options.getHedgedReadPercentile());
+}
+
+TEST_F(OptionsTest, parseCommandLineShouldSetHedgedReadBudget)
+{
+    cmdArgs.insert(cmdArgs.end(), {"--hedged-read-budget", "10", "mountpoint"});
+    options.parse(cmdArgs.size(), cmdArgs.data());
+    EXPECT_EQ(10, options.getHedgedReadBudget());
+}
+
 TEST_F(OptionsTest, parseCommandLineShouldSetTagOnCreate)
 {
     cmdArgs.insert(
@@ -0,0 +1,85 @@
+/**
+ * @file util_uuid_test.cc
+ * @copyright (C) 2026 ACK CYFRONET AGH
+ * @copyright This software is released under the MIT license cited in
+ * 'LICENSE.txt'
+ */
+
+#include "util/uuid.h"
+
+#include <folly/FBString.h>
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace ::testing;
+using namespace one::client::util;
+
+TEST(UuidTest, equalUuidsShouldShareInternedString)
+{
+    const auto count = Uuid::internedCount();
+
+    Uuid uuid1{"uuid1"};
+    Uuid uuid2{folly::fbstring{"uuid1"}};
+    Uuid uuid3{"uuid3"};
+
+    EXPECT_EQ(count + 2, Uuid::internedCount());
+    EXPECT_TRUE(uuid1 == uuid2);
+    EXPECT_TRUE(uuid1 != uuid3);
+    EXPECT_EQ(&uuid1.str(), &uuid2.str());
+    EXPECT_EQ("uuid1", uuid1);
+    EXPECT_EQ(folly::fbstring{"uuid3"}, uuid3);
+}
+
+TEST(UuidTest, hashShouldBeEqualToStringHash)
+{
+    const folly::fbstring value{"someUuid"};
+    Uuid uuid{value};
+
+    EXPECT_EQ(std::hash<folly::fbstring>{}(value), uuid.hash());
+    EXPECT_EQ(uuid.hash(), std::hash<Uuid>{}(uuid));
+    EXPECT_EQ(Uuid::Hash{}(value), Uuid::Hash{}(uuid));
+    EXPECT_TRUE(Uuid::Equal{}(value, uuid));
+    EXPECT_EQ(std::hash<folly::fbstring>{}(""), Uuid{}.hash());
+}
+
+TEST(UuidTest, lastReleasedHandleShouldFreeInternedString)
+{
+    const auto count = Uuid::internedCount();
+    {
+        Uuid uuid{"releasedUuid"};
+        Uuid copy{uuid};
+        Uuid moved{std::move(copy)};
+        EXPECT_TRUE(copy.empty());
+
+        uuid = Uuid{};
+        EXPECT_EQ(count + 1, Uuid::internedCount());
+        EXPECT_EQ("releasedUuid", moved);
+    }
+    EXPECT_EQ(count, Uuid::internedCount());
+}
+
+TEST(UuidTest, handlesShouldBeUsableFromMultipleThreads)
+{
+    const auto count = Uuid::internedCount();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([] {
+            for (int j = 0; j < 10000; ++j) {
+                folly::fbstring value{"sharedUuid"};
+                value.push_back('0' + j % 10);
+
+                Uuid uuid{value};
+                Uuid copy{uuid};
+                EXPECT_EQ(uuid, copy);
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    EXPECT_EQ(count, Uuid::internedCount());
+}